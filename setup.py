@@ -7,11 +7,30 @@ quicktable = Extension(
         'src/lib/table/table.c',
         'src/lib/table/table_type.c',
         'src/lib/table/table_as_string.c',
+        'src/lib/table/column_buffer_type.c',
+        'src/lib/table/table_iterator_type.c',
+        'src/lib/table/column_view_type.c',
+        'src/lib/table/index.c',
         'src/lib/blueprint.c',
         'src/lib/column/column.c',
         'src/lib/column/column_as_string.c',
+        'src/lib/column/column_from_string.c',
+        'src/lib/column/column_from_buffer.c',
+        'src/lib/column/arena.c',
+        'src/lib/column/dictionary.c',
+        'src/lib/column/encoding.c',
+        'src/lib/allocator/allocator.c',
+        'src/lib/allocator/pool_type.c',
+        'src/lib/io/reader.c',
+        'src/lib/io/csv_reader.c',
+        'src/lib/io/jsonl_reader.c',
+        'src/lib/io/csv_writer.c',
+        'src/lib/io/arrow_export.c',
+        'src/lib/io/arrow_import.c',
+        'src/lib/io/table_file.c',
         'src/lib/result.c',
     ],
+    extra_link_args=['-pthread'],
 )
 
 setup(
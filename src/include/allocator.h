@@ -0,0 +1,79 @@
+#ifndef QTB_ALLOCATOR_H
+#define QTB_ALLOCATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define QTB_ALLOCATOR_ARENA_INITIAL_BLOCK_SIZE (64 * 1024)
+#define QTB_ALLOCATOR_ARENA_MAX_BLOCK_SIZE (4 * 1024 * 1024)
+#define QTB_ALLOCATOR_HUGEPAGE_SIZE (2 * 1024 * 1024)
+#define QTB_ALLOCATOR_POOL_MIN_CLASS 6
+#define QTB_ALLOCATOR_POOL_MAX_CLASS 22
+
+typedef struct {
+  char *base;
+  size_t size;
+} QtbAllocatorBlock;
+
+// arena, hugepage, pool and mapped allocations are preceded by a header
+// recording their size, which keeps the allocator interface as narrow as
+// libc's. Table files lay their blocks out the same way.
+typedef struct {
+  size_t size;
+  size_t size_class;
+} QtbAllocationHeader;
+
+#define qtb_allocation_header_of(p) ((QtbAllocationHeader *)(p) - 1)
+
+// Backing store for column storage, string arenas and dictionaries. Every
+// allocator hands out memory through the same three methods so that the
+// structures it serves never need to know where their memory comes from:
+//
+//   malloc     libc, the default.
+//   arena      bump allocation from blocks that are only released when the
+//              allocator is, for tables that are thrown away whole.
+//   hugepage   like arena, with blocks that are 2 MiB aligned and advised to
+//              be backed by transparent huge pages.
+//   pool       power of two size classes recycled through free lists so that
+//              many short-lived tables can share the same memory.
+//   mapped     the image of a table file, mapped or read whole, whose blocks
+//              are used in place and moved to the heap once resized.
+typedef struct _QtbAllocator {
+  // Methods
+  void *(*malloc)  (struct _QtbAllocator *, size_t);
+  void *(*realloc) (struct _QtbAllocator *, void *, size_t);
+  void  (*free)    (struct _QtbAllocator *, void *);
+  void  (*dealloc) (struct _QtbAllocator *);
+
+  // arena and hugepage
+  QtbAllocatorBlock *blocks;
+  size_t n_blocks;
+  size_t current;
+  size_t used;
+  char *last;
+
+  // pool
+  void *free_lists[QTB_ALLOCATOR_POOL_MAX_CLASS + 1];
+  size_t cached;
+
+  // mapped
+  char *image;
+  size_t image_size;
+  bool image_mapped;
+} QtbAllocator;
+
+#define qtb_malloc(allocator, size) ((allocator)->malloc(allocator, size))
+#define qtb_realloc(allocator, p, size) ((allocator)->realloc(allocator, p, size))
+#define qtb_free(allocator, p) ((allocator)->free(allocator, p))
+
+extern QtbAllocator qtb_allocator_default;
+
+void qtb_allocator_malloc_new(QtbAllocator *allocator);
+void qtb_allocator_arena_new(QtbAllocator *allocator);
+void qtb_allocator_hugepage_new(QtbAllocator *allocator);
+void qtb_allocator_pool_new(QtbAllocator *allocator);
+void qtb_allocator_mapped_new(QtbAllocator *allocator, char *image, size_t size, bool mapped);
+void qtb_allocator_dealloc(QtbAllocator *allocator);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef QTB_ARENA_H
+#define QTB_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Python.h>
+#include "result.h"
+#include "allocator.h"
+
+#define QTB_ARENA_INITIAL_BLOCK_SIZE 1024
+#define QTB_ARENA_MAX_BLOCK_SIZE (1024 * 1024)
+
+// Bump allocator for string bytes. Strings are copied into large blocks and
+// addressed by (block, offset) so that blocks never need to move.
+typedef struct {
+  QtbAllocator *allocator;
+
+  char **blocks;
+  size_t n_blocks;
+  size_t current;
+  size_t used;
+  size_t capacity;
+
+  // Bytes held across all blocks
+  size_t reserved;
+} QtbArena;
+
+typedef struct {
+  uint32_t block;
+  uint32_t offset;
+} QtbArenaSlot;
+
+typedef union {
+  QtbArenaSlot value;
+  ResultError error;
+} QtbArenaSlotValue;
+
+typedef struct {
+  Result_HEAD
+  QtbArenaSlotValue value;
+} ResultQtbArenaSlot;
+
+#define ResultQtbArenaSlotSuccess(value) ResultRegisterSuccess(ResultQtbArenaSlot, value)
+#define ResultQtbArenaSlotFailure(py_err, message) ResultRegisterFailure(ResultQtbArenaSlot, py_err, message)
+
+#define qtb_arena_at(arena, slot) (&(arena)->blocks[(slot).block][(slot).offset])
+
+void qtb_arena_new(QtbArena *arena, QtbAllocator *allocator);
+ResultQtbArenaSlot qtb_arena_store(QtbArena *arena, const char *s, size_t size);
+void qtb_arena_unstore(QtbArena *arena, QtbArenaSlot slot, size_t size);
+void qtb_arena_shrink_to_fit(QtbArena *arena);
+Result qtb_arena_adopt_blocks(QtbArena *arena, char **blocks, const size_t *sizes, size_t n_blocks);
+void qtb_arena_dealloc(QtbArena *arena);
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef QTB_ARROW_H
+#define QTB_ARROW_H
+
+#include <Python.h>
+#include <stdint.h>
+#include "table.h"
+
+// Arrow C data and stream interface structs, as given by the Arrow
+// specification; the guards let them coexist with Arrow's own headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  const char *format;
+  const char *name;
+  const char *metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema *dictionary;
+
+  void (*release)(struct ArrowSchema *);
+  void *private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray *dictionary;
+
+  void (*release)(struct ArrowArray *);
+  void *private_data;
+};
+
+#endif
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+  int (*get_schema)(struct ArrowArrayStream *, struct ArrowSchema *out);
+  int (*get_next)(struct ArrowArrayStream *, struct ArrowArray *out);
+  const char *(*get_last_error)(struct ArrowArrayStream *);
+
+  void (*release)(struct ArrowArrayStream *);
+  void *private_data;
+};
+
+#endif
+
+// Tables are exported as a struct array with one child per column. Numeric,
+// bool and validity buffers are handed out without copying, pinning the table
+// like a column buffer does; str cells and category dictionaries are copied
+// into Arrow's offset layout. Streams yield one record batch per chunk.
+ResultPyObjectPtr qtb_arrow_schema_capsule_(QtbTable *table);
+ResultPyObjectPtr qtb_arrow_array_capsules_(QtbTable *table);
+ResultPyObjectPtr qtb_arrow_stream_capsule_(QtbTable *table);
+
+// Builds a table of the given type from any object implementing the Arrow
+// PyCapsule interface, copying its data. kwargs are passed on to the type.
+ResultPyObjectPtr qtb_arrow_import_(PyTypeObject *type, PyObject *data, PyObject *kwargs);
+
+#endif
@@ -2,12 +2,23 @@
 #define QTB_COLUMN_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <Python.h>
 #include "result.h"
+#include "arena.h"
+#include "dictionary.h"
+#include "allocator.h"
+#include "encoding.h"
 
 #define QTB_COLUMN_INITIAL_CAPACITY 20
-#define QTB_COLUMN_GROWTH_COEFFICIENT 1.2
+#define QTB_COLUMN_SMALL_CAPACITY 4096
+#define QTB_COLUMN_SMALL_GROWTH_COEFFICIENT 2
+#define QTB_COLUMN_GROWTH_COEFFICIENT 1.5
+#define QTB_COLUMN_BOOL_WORD_BITS 64
+#define QTB_COLUMN_CHUNK_SHIFT 16
+#define QTB_COLUMN_CHUNK_SIZE ((size_t)1 << QTB_COLUMN_CHUNK_SHIFT)
+#define QTB_COLUMN_CHUNK_MASK (QTB_COLUMN_CHUNK_SIZE - 1)
 
 typedef void *(*mallocer)(size_t);
 
@@ -16,38 +27,108 @@ typedef enum {
   QTB_COLUMN_TYPE_INT,
   QTB_COLUMN_TYPE_FLOAT,
   QTB_COLUMN_TYPE_BOOL,
+  QTB_COLUMN_TYPE_CATEGORY,
+  QTB_COLUMN_TYPE_INT8,
+  QTB_COLUMN_TYPE_INT16,
+  QTB_COLUMN_TYPE_INT32,
+  QTB_COLUMN_TYPE_UINT8,
+  QTB_COLUMN_TYPE_UINT16,
+  QTB_COLUMN_TYPE_UINT32,
+  QTB_COLUMN_TYPE_UINT64,
+  QTB_COLUMN_TYPE_FLOAT32,
 } QtbColumnType;
 
-typedef union {
-  char *s;
-  long long i;
-  double f;
-  bool b;
-} QtbColumnData;
+#define QTB_COLUMN_STR_INLINE_SIZE 12
+#define QTB_COLUMN_STR_PREFIX_SIZE 4
+
+// 16 byte str cell. Strings of up to 12 bytes are stored inline; longer ones
+// keep their first 4 bytes next to the arena reference so that comparisons
+// can usually be decided without touching the arena.
+typedef struct {
+  uint32_t size;
+  union {
+    char inlined[QTB_COLUMN_STR_INLINE_SIZE];
+    struct {
+      char prefix[QTB_COLUMN_STR_PREFIX_SIZE];
+      QtbArenaSlot slot;
+    } ref;
+  } value;
+} QtbColumnStr;
+
+// Full chunks of int-like and bool columns may be compressed, in which case
+// data is NULL and encoded holds the cells. Validity is never compressed.
+typedef struct {
+  void *data;
+  uint64_t *validity;
+  QtbEncodedChunk *encoded;
+} QtbColumnChunk;
+
+// Element types of a one-dimensional buffer, from its struct format.
+typedef enum {
+  QTB_BUFFER_SIGNED,
+  QTB_BUFFER_UNSIGNED,
+  QTB_BUFFER_FLOAT,
+  QTB_BUFFER_BOOL,
+  QTB_BUFFER_UNSUPPORTED,
+} QtbBufferKind;
+
+typedef struct {
+  const char *data;
+  size_t n;
+  size_t itemsize;
+  QtbBufferKind kind;
+} QtbBuffer;
+
 
 typedef struct _QtbColumn {
   // Override implementation hooks
   char       *(*strdup)           (const char *);
   void       *(*malloc)           (size_t);
-  void       *(*realloc)          (void *, size_t);
   int         (*snprintf_)        (char *, size_t, const char *, ...);
   PyObject   *(*PyTuple_New)      (Py_ssize_t);
-  const char *(*PyUnicode_AsUTF8) (PyObject *);
+  const char *(*PyUnicode_AsUTF8AndSize) (PyObject *, Py_ssize_t *);
 
   // Methods
   ResultPyObjectPtr  (*get_as_pyobject) (struct _QtbColumn *, size_t);
   Result             (*append)          (struct _QtbColumn *, PyObject *);
-  const char        *(*type_as_string)  (void);
+  Result             (*append_string)   (struct _QtbColumn *, const char *, size_t);
+  // NULL for types that cannot be filled from a buffer
+  Result             (*append_buffer)   (struct _QtbColumn *, QtbBuffer *);
+  const char        *(*type_as_string)  (bool);
   ResultCharPtr      (*cell_as_string)  (struct _QtbColumn *, size_t);
   void               (*dealloc)         (struct _QtbColumn *);
+  void               (*pop)             (struct _QtbColumn *);
+
+  // Chunks, the string arena and the dictionary are allocated from here.
+  // Names and the strings handed back by cell_as_string come from malloc.
+  QtbAllocator *allocator;
 
   char *name;
   QtbColumnType type;
-  QtbColumnData *data;
+  bool nullable;
+  QtbColumnChunk *chunks;
+  size_t n_chunks;
+  size_t chunks_capacity;
+  QtbArena arena;
+  QtbDictionary dictionary;
   size_t size;
   size_t capacity;
+
+  // Block of a compressed chunk last decoded for reading, by row / block size,
+  // or SIZE_MAX once a chunk has been compressed or decompressed since
+  void *decoded;
+  size_t decoded_block;
 } QtbColumn;
 
+// Bytes held by a column, split into cells in use, cells allocated (used
+// included), string and dictionary value bytes, and bookkeeping.
+typedef struct {
+  size_t used;
+  size_t reserved;
+  size_t strings;
+  size_t overhead;
+} QtbColumnMemoryUsage;
+
 typedef union {
   QtbColumn *value;
   ResultError error;
@@ -71,11 +152,129 @@ ResultQtbColumnPtr _qtb_column_new_many(size_t n, mallocer m);
 #define MIN(a, b) (a < b ? a : b)
 #define MAX(a, b) (a > b ? a : b)
 
+// Each column type owns natively typed storage: int64_t for int, double for
+// float, bit-packed uint64_t words for bool and QtbColumnStr for str, whose
+// long values live in the column's string arena. category cells are uint32_t
+// codes into the column's dictionary. The narrow numeric types store their own
+// C type, e.g. int8_t for int8 and float for float32.
+//
+// Cells are split across chunks of QTB_COLUMN_CHUNK_SIZE rows so that growing
+// a column never moves rows that have already been written. Row i lives at
+// offset i & QTB_COLUMN_CHUNK_MASK of chunk i >> QTB_COLUMN_CHUNK_SHIFT.
+#define qtb_column_chunk_of(i) ((i) >> QTB_COLUMN_CHUNK_SHIFT)
+#define qtb_column_offset_of(i) ((i) & QTB_COLUMN_CHUNK_MASK)
+#define qtb_column_cell(column, ctype, i) (((ctype *)(column)->chunks[qtb_column_chunk_of(i)].data)[qtb_column_offset_of(i)])
+#define qtb_column_bool_word(column, i) \
+  (((uint64_t *)(column)->chunks[qtb_column_chunk_of(i)].data)[qtb_column_offset_of(i) / QTB_COLUMN_BOOL_WORD_BITS])
+#define qtb_column_validity_word(column, i) \
+  ((column)->chunks[qtb_column_chunk_of(i)].validity[qtb_column_offset_of(i) / QTB_COLUMN_BOOL_WORD_BITS])
+#define qtb_column_bit_of(i) ((uint64_t)1 << ((i) % QTB_COLUMN_BOOL_WORD_BITS))
+
+static inline size_t qtb_column_chunk_rows(QtbColumn *column, size_t chunk) {
+  return MIN(column->size - chunk * QTB_COLUMN_CHUNK_SIZE, QTB_COLUMN_CHUNK_SIZE);
+}
+
+const void *qtb_column_decoded_cell(QtbColumn *column, size_t i);
+
+// Cells are read through qtb_column_value_at, which decodes compressed
+// chunks a block at a time into the column's decoded block. Reading thus
+// writes to the column and must not happen concurrently. Cells are written
+// with qtb_column_cell, only ever to chunks that are not compressed.
+static inline const void *qtb_column_read_cell(QtbColumn *column, size_t i, size_t cell_size) {
+  QtbColumnChunk *chunk;
+
+  chunk = &column->chunks[qtb_column_chunk_of(i)];
+  if (chunk->encoded == NULL) return (const char *)chunk->data + qtb_column_offset_of(i) * cell_size;
+
+  return qtb_column_decoded_cell(column, i);
+}
+
+#define qtb_column_value_at(column, ctype, i) (*(const ctype *)qtb_column_read_cell(column, i, sizeof(ctype)))
+
+static inline int64_t qtb_column_int_at(QtbColumn *column, size_t i) {
+  return qtb_column_value_at(column, int64_t, i);
+}
+
+static inline double qtb_column_float_at(QtbColumn *column, size_t i) {
+  return qtb_column_cell(column, double, i);
+}
+
+static inline QtbColumnStr *qtb_column_str_cell(QtbColumn *column, size_t i) {
+  return &qtb_column_cell(column, QtbColumnStr, i);
+}
+
+static inline const char *qtb_column_str_at(QtbColumn *column, size_t i) {
+  QtbColumnStr *cell;
+
+  cell = qtb_column_str_cell(column, i);
+  if (cell->size <= QTB_COLUMN_STR_INLINE_SIZE) return cell->value.inlined;
+
+  return qtb_arena_at(&column->arena, cell->value.ref.slot);
+}
+
+static inline size_t qtb_column_str_size_at(QtbColumn *column, size_t i) {
+  return qtb_column_str_cell(column, i)->size;
+}
+
+static inline bool qtb_column_str_equals(QtbColumn *column, size_t i, const char *s, size_t size) {
+  QtbColumnStr *cell;
+
+  cell = qtb_column_str_cell(column, i);
+  if (cell->size != size) return false;
+  if (size <= QTB_COLUMN_STR_INLINE_SIZE) return memcmp(cell->value.inlined, s, size) == 0;
+  if (memcmp(cell->value.ref.prefix, s, QTB_COLUMN_STR_PREFIX_SIZE) != 0) return false;
+
+  return memcmp(qtb_arena_at(&column->arena, cell->value.ref.slot), s, size) == 0;
+}
+
+// Nullable columns keep a validity bitmap alongside each chunk's data, one bit
+// per row and set for non-null rows, laid out in words like bool cells.
+static inline bool qtb_column_is_valid(QtbColumn *column, size_t i) {
+  if (!column->nullable) return true;
+
+  return (qtb_column_validity_word(column, i) & qtb_column_bit_of(i)) != 0;
+}
+
+static inline uint32_t qtb_column_code_at(QtbColumn *column, size_t i) {
+  return qtb_column_cell(column, uint32_t, i);
+}
+
+// For bool columns the decoded cell is the word holding row i's bit.
+static inline bool qtb_column_bool_at(QtbColumn *column, size_t i) {
+  const uint64_t *word;
+
+  if (column->chunks[qtb_column_chunk_of(i)].encoded == NULL) word = &qtb_column_bool_word(column, i);
+  else word = (const uint64_t *)qtb_column_decoded_cell(column, i);
+
+  return (*word & qtb_column_bit_of(i)) != 0;
+}
+
 Result qtb_column_init(QtbColumn *column, PyObject *descriptor);
+Result qtb_column_init_like(QtbColumn *column, QtbColumn *like);
 Result qtb_column_init_many(QtbColumn *columns, PyObject *blueprint, Py_ssize_t n);
 void qtb_column_dealloc(QtbColumn *column);
 ResultPyObjectPtr qtb_column_as_descriptor(QtbColumn *column);
 Result qtb_column_append(QtbColumn *column, PyObject *item);
+Result qtb_column_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_append_none(QtbColumn *column);
+Result qtb_column_append_column(QtbColumn *column, QtbColumn *other);
+Result qtb_column_append_rows(QtbColumn *column, QtbColumn *other, size_t start, Py_ssize_t step, size_t n);
+Result qtb_column_append_taken(QtbColumn *column, QtbColumn *other, const size_t *taken, size_t n);
+Result qtb_column_append_buffer(QtbColumn *column, Py_buffer *view);
+void qtb_column_commit_rows(QtbColumn *column, size_t n, const uint8_t *valid, size_t offset);
+Result qtb_column_store_str(QtbColumn *column, const char *s, size_t size);
+void qtb_column_pop(QtbColumn *column);
+void qtb_column_use_allocator(QtbColumn *column, QtbAllocator *allocator);
+QtbColumnMemoryUsage qtb_column_memory_usage(QtbColumn *column);
+Result qtb_column_reserve(QtbColumn *column, size_t capacity);
+Result qtb_column_shrink_to_fit(QtbColumn *column);
+bool qtb_column_compressible(QtbColumn *column);
+Result qtb_column_compress(QtbColumn *column);
+void qtb_column_decode_chunk(QtbColumn *column, size_t chunk, void *to);
+Result qtb_column_decompress_chunk(QtbColumn *column, size_t chunk);
+Result qtb_column_adopt_chunks(QtbColumn *column, QtbColumnChunk *chunks, size_t n_chunks, size_t size);
+size_t qtb_column_data_size(QtbColumnType type, size_t capacity);
+size_t qtb_column_validity_size(size_t capacity);
 ResultPyObjectPtr qtb_column_get_as_pyobject(QtbColumn *column, size_t i);
 const char *qtb_column_type_as_string(QtbColumn *column);
 ResultCharPtr qtb_column_header_as_string(QtbColumn *column);
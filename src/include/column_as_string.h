@@ -8,11 +8,29 @@ ResultCharPtr qtb_column_str_cell_as_string(QtbColumn *column, size_t i);
 ResultCharPtr qtb_column_int_cell_as_string(QtbColumn *column, size_t i);
 ResultCharPtr qtb_column_float_cell_as_string(QtbColumn *column, size_t i);
 ResultCharPtr qtb_column_bool_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_category_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_int8_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_int16_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_int32_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_uint8_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_uint16_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_uint32_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_uint64_cell_as_string(QtbColumn *column, size_t i);
+ResultCharPtr qtb_column_float32_cell_as_string(QtbColumn *column, size_t i);
 
-const char *qtb_column_str_type_as_string(void);
-const char *qtb_column_int_type_as_string(void);
-const char *qtb_column_float_type_as_string(void);
-const char *qtb_column_bool_type_as_string(void);
+const char *qtb_column_str_type_as_string(bool nullable);
+const char *qtb_column_int_type_as_string(bool nullable);
+const char *qtb_column_float_type_as_string(bool nullable);
+const char *qtb_column_bool_type_as_string(bool nullable);
+const char *qtb_column_category_type_as_string(bool nullable);
+const char *qtb_column_int8_type_as_string(bool nullable);
+const char *qtb_column_int16_type_as_string(bool nullable);
+const char *qtb_column_int32_type_as_string(bool nullable);
+const char *qtb_column_uint8_type_as_string(bool nullable);
+const char *qtb_column_uint16_type_as_string(bool nullable);
+const char *qtb_column_uint32_type_as_string(bool nullable);
+const char *qtb_column_uint64_type_as_string(bool nullable);
+const char *qtb_column_float32_type_as_string(bool nullable);
 
 ResultCharPtr qtb_column_header_as_string_(QtbColumn *column);
 
@@ -0,0 +1,29 @@
+#ifndef QTB_COLUMN_BUFFER_H
+#define QTB_COLUMN_BUFFER_H
+
+#include <Python.h>
+#include "table.h"
+
+// Read-only buffer protocol view of one chunk of a numeric column. Exports
+// hand out the chunk's own storage, so the table is pinned, refusing to add,
+// drop or move rows, until every export has been released.
+typedef struct {
+  PyObject_HEAD
+
+  QtbTable *table;
+  size_t column;
+  size_t chunk;
+  const char *format;
+  Py_ssize_t itemsize;
+
+  // Shape and strides of the current exports. They cannot change while an
+  // export is alive as the table is pinned.
+  Py_ssize_t shape;
+  Py_ssize_t strides;
+} QtbColumnBuffer;
+
+extern PyTypeObject QtbColumnBufferType;
+
+ResultPyObjectPtr qtb_column_buffer_new_(QtbTable *table, size_t column, size_t chunk);
+
+#endif
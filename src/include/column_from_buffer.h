@@ -0,0 +1,27 @@
+#ifndef QTB_COLUMN_FROM_BUFFER_H
+#define QTB_COLUMN_FROM_BUFFER_H
+
+#include "column.h"
+#include "result.h"
+
+QtbBuffer qtb_buffer_from_view(Py_buffer *view);
+int64_t qtb_buffer_signed_at(QtbBuffer *buffer, size_t i);
+uint64_t qtb_buffer_unsigned_at(QtbBuffer *buffer, size_t i);
+
+// Write the buffer's n elements to the cells from column->size on, which
+// must already be allocated. Buffers of the column's own C type are copied
+// chunk by chunk; others are converted element by element with the same
+// range checks as append.
+Result qtb_column_int_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_float_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_bool_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_int8_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_int16_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_int32_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_uint8_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_uint16_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_uint32_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_uint64_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+Result qtb_column_float32_append_buffer(QtbColumn *column, QtbBuffer *buffer);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef QTB_COLUMN_FROM_STRING_H
+#define QTB_COLUMN_FROM_STRING_H
+
+#include "column.h"
+#include "result.h"
+
+// Parse the text of a cell, e.g. a CSV field, into the cell at column->size.
+// None of these call into Python, so they are safe without the GIL.
+Result qtb_column_str_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_int_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_float_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_bool_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_category_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_int8_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_int16_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_int32_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_uint8_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_uint16_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_uint32_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_uint64_append_string(QtbColumn *column, const char *s, size_t size);
+Result qtb_column_float32_append_string(QtbColumn *column, const char *s, size_t size);
+
+#endif
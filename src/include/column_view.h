@@ -0,0 +1,21 @@
+#ifndef QTB_COLUMN_VIEW_H
+#define QTB_COLUMN_VIEW_H
+
+#include <Python.h>
+#include "table.h"
+
+// One column of a table, or of a view of one, read in place. Like the
+// table's own rows, a column view sees rows appended or popped after it was
+// made.
+typedef struct {
+  PyObject_HEAD
+
+  QtbTable *table;
+  size_t column;
+} QtbColumnView;
+
+extern PyTypeObject QtbColumnViewType;
+
+ResultPyObjectPtr qtb_column_view_new_(QtbTable *table, size_t column);
+
+#endif
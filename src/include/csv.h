@@ -0,0 +1,23 @@
+#ifndef QTB_CSV_H
+#define QTB_CSV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "table.h"
+#include "result.h"
+
+#define QTB_CSV_WRITE_BUFFER_SIZE (1024 * 1024)
+
+// Shared by the reader and the writer, which ignores n_threads.
+typedef struct {
+  char delimiter;
+  bool header;
+  // 0 picks one thread per QTB_READER_MIN_BYTES_PER_THREAD, up to the CPU
+  // count.
+  size_t n_threads;
+} QtbCsvOptions;
+
+Result qtb_csv_read_into_(QtbTable *table, const char *path, QtbCsvOptions *options);
+Result qtb_csv_write_(QtbTable *table, PyObject *destination, QtbCsvOptions *options);
+
+#endif
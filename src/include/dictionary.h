@@ -0,0 +1,44 @@
+#ifndef QTB_DICTIONARY_H
+#define QTB_DICTIONARY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Python.h>
+#include "result.h"
+#include "arena.h"
+#include "allocator.h"
+
+#define QTB_DICTIONARY_INITIAL_CAPACITY 16
+
+typedef struct {
+  uint32_t size;
+  QtbArenaSlot slot;
+  uint64_t hash;
+} QtbDictionaryEntry;
+
+// Distinct str values of a category column, numbered by insertion order.
+// Lookups go through an open-addressing table of code + 1 (0 marks an empty
+// slot) and each value's PyUnicode is created once and then shared.
+typedef struct {
+  QtbAllocator *allocator;
+
+  QtbArena arena;
+  QtbDictionaryEntry *entries;
+  PyObject **values;
+  size_t size;
+  size_t capacity;
+  uint32_t *slots;
+  size_t n_slots;
+} QtbDictionary;
+
+#define qtb_dictionary_value_at(dictionary, code) qtb_arena_at(&(dictionary)->arena, (dictionary)->entries[code].slot)
+#define qtb_dictionary_value_size_at(dictionary, code) ((dictionary)->entries[code].size)
+
+void qtb_dictionary_new(QtbDictionary *dictionary, QtbAllocator *allocator);
+ResultSize_t qtb_dictionary_intern(QtbDictionary *dictionary, const char *s, size_t size);
+Py_ssize_t qtb_dictionary_lookup(QtbDictionary *dictionary, const char *s, size_t size);
+ResultPyObjectPtr qtb_dictionary_get_as_pyobject(QtbDictionary *dictionary, uint32_t code);
+Result qtb_dictionary_adopt(QtbDictionary *dictionary, QtbDictionaryEntry *entries, size_t size);
+void qtb_dictionary_dealloc(QtbDictionary *dictionary);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef QTB_ENCODING_H
+#define QTB_ENCODING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <Python.h>
+#include "result.h"
+#include "allocator.h"
+
+#define QTB_ENCODING_BLOCK_SIZE 1024
+#define QTB_ENCODING_BLOCK_WORDS (QTB_ENCODING_BLOCK_SIZE / 64)
+#define QTB_ENCODING_RUN_BITS 10
+
+typedef enum {
+  // Cells copied as they are; bool blocks only
+  QTB_ENCODING_PLAIN,
+  // Offsets from the smallest value, bit-packed
+  QTB_ENCODING_FRAME_OF_REFERENCE,
+  // Differences between neighbours, packed as offsets from the smallest
+  QTB_ENCODING_DELTA,
+  // Run values packed as offsets from the smallest, followed by run lengths
+  QTB_ENCODING_RUN_LENGTH,
+} QtbEncoding;
+
+typedef struct {
+  uint8_t encoding;
+  uint8_t bits;
+  uint16_t n_runs;
+  // Offset of the block's packed words in the chunk's payload
+  uint32_t offset;
+  // Smallest value, or first value for delta blocks, as a 64-bit key in
+  // which signed values are biased so that unsigned order is their order.
+  // Run length bool blocks keep their first bit here.
+  uint64_t reference;
+  // Smallest difference between neighbours of delta blocks
+  uint64_t step;
+} QtbEncodedBlock;
+
+// A full chunk of an int-like or bool column encoded block by block, each
+// block with whichever encoding is smallest for it, so that any block can be
+// decoded on its own.
+typedef struct {
+  size_t n_blocks;
+  size_t size;
+  QtbEncodedBlock *blocks;
+  uint64_t *payload;
+} QtbEncodedChunk;
+
+typedef enum {
+  QTB_ENCODING_KIND_SIGNED,
+  QTB_ENCODING_KIND_UNSIGNED,
+  QTB_ENCODING_KIND_BOOL,
+} QtbEncodingKind;
+
+// cell_size is 1, 2, 4 or 8 for int-like cells and ignored for bool cells,
+// which are bit-packed words.
+typedef struct {
+  QtbEncodingKind kind;
+  size_t cell_size;
+} QtbEncodingCells;
+
+Result qtb_encoding_encode(QtbEncodingCells cells, const void *data, size_t n_blocks, QtbAllocator *allocator, QtbEncodedChunk **encoded);
+void qtb_encoding_decode_block(QtbEncodingCells cells, const QtbEncodedChunk *encoded, size_t block, void *to);
+void qtb_encoding_decode(QtbEncodingCells cells, const QtbEncodedChunk *encoded, void *to);
+void qtb_encoding_free(QtbAllocator *allocator, QtbEncodedChunk *encoded);
+
+#endif
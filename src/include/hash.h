@@ -0,0 +1,32 @@
+#ifndef QTB_HASH_H
+#define QTB_HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// FNV-1a; cheap to compute and good enough for short keys such as category
+// values.
+static inline uint64_t qtb_hash_bytes(const char *s, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (size_t i = 0; i < size; i++) {
+    hash ^= (unsigned char)s[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+// The splitmix64 finalizer; spreads runs of consecutive ints over the low
+// bits that pick a slot.
+static inline uint64_t qtb_hash_int(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+
+  return x;
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef QTB_INDEX_H
+#define QTB_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <Python.h>
+#include "result.h"
+#include "column.h"
+#include "allocator.h"
+
+#define QTB_INDEX_INITIAL_SLOTS 64
+
+// Hash index over the first size rows of a str, category or int-like column,
+// kept by the table as rows are appended and popped. An open-addressing table
+// holds, per distinct key, the last row with it plus 1 (0 marks an empty
+// slot); earlier rows with the same key are chained through previous. Null
+// cells are not indexed. A unique index holds at most one row per key.
+typedef struct {
+  QtbAllocator *allocator;
+  size_t column;
+  bool unique;
+
+  size_t *slots;
+  size_t n_slots;
+  size_t n_keys;
+
+  // previous[i] is the row before row i with the same key plus 1, or 0.
+  size_t *previous;
+  size_t capacity;
+  size_t size;
+} QtbIndex;
+
+// A key looked up in an index: bytes for str columns, a code for category
+// columns, the value's 64 bits, sign- or zero-extended, for int-like ones.
+typedef struct {
+  const char *s;
+  size_t size;
+  uint64_t bits;
+} QtbIndexKey;
+
+Result qtb_index_init(QtbIndex *index, QtbColumn *column, size_t position, bool unique, QtbAllocator *allocator);
+Result qtb_index_extend(QtbIndex *index, QtbColumn *column, size_t size);
+void qtb_index_truncate(QtbIndex *index, QtbColumn *column, size_t size);
+ResultPyObjectPtr qtb_index_lookup(QtbIndex *index, QtbColumn *column, PyObject *key, Py_ssize_t offset, Py_ssize_t step, Py_ssize_t size);
+size_t qtb_index_memory_usage(QtbIndex *index);
+void qtb_index_dealloc(QtbIndex *index);
+
+#endif
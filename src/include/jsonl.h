@@ -0,0 +1,16 @@
+#ifndef QTB_JSONL_H
+#define QTB_JSONL_H
+
+#include <stddef.h>
+#include "table.h"
+#include "result.h"
+
+typedef struct {
+  // 0 picks one thread per QTB_READER_MIN_BYTES_PER_THREAD, up to the CPU
+  // count.
+  size_t n_threads;
+} QtbJsonlOptions;
+
+Result qtb_jsonl_read_into_(QtbTable *table, const char *path, QtbJsonlOptions *options);
+
+#endif
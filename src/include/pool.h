@@ -0,0 +1,18 @@
+#ifndef QTB_POOL_H
+#define QTB_POOL_H
+
+#include <Python.h>
+#include "allocator.h"
+
+// Python handle on a pool allocator. Tables created with a pool keep a
+// reference to it, so memory they return stays cached for the next table
+// until the last of them and the pool itself are gone.
+typedef struct {
+  PyObject_HEAD
+
+  QtbAllocator allocator;
+} QtbPool;
+
+extern PyTypeObject QtbPoolType;
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef QTB_READER_H
+#define QTB_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "table.h"
+#include "result.h"
+
+// Inputs smaller than this many bytes per thread are not split any further.
+#define QTB_READER_MIN_BYTES_PER_THREAD (1024 * 1024)
+#define QTB_READER_MAX_THREADS 64
+
+// A run of whole records parsed by one thread. Workers never call into
+// Python: fields are parsed with qtb_column_append_string and failures are
+// reported through static messages only.
+typedef struct {
+  const char *begin;
+  const char *end;
+  const void *options;
+
+  // Private to the worker and stitched onto the table afterwards.
+  QtbColumn *columns;
+  Py_ssize_t width;
+
+  // Unescaped copies of fields that hold escapes.
+  char *scratch;
+  size_t scratch_capacity;
+
+  size_t rows;
+  Result result;
+  Py_ssize_t failed_column;
+} QtbReaderWorker;
+
+// A text format read by qtb_reader_read_into_. split writes n + 1 bounds of
+// at most n runs of whole records and returns the number of runs; parse
+// appends the records of a worker's run to its columns.
+typedef struct {
+  const char *(*skip_header) (const char *, const char *, const void *);
+  size_t      (*split)       (const char *, const char *, size_t, const char **, const void *);
+  Result      (*parse)       (QtbReaderWorker *);
+  const void *options;
+  // 0 picks one thread per QTB_READER_MIN_BYTES_PER_THREAD, up to the CPU
+  // count.
+  size_t n_threads;
+} QtbReader;
+
+Result qtb_reader_fail(QtbReaderWorker *worker, Result result, Py_ssize_t column);
+ResultCharPtr qtb_reader_scratch(QtbReaderWorker *worker, size_t size);
+Result qtb_reader_read_into_(QtbTable *table, const char *path, QtbReader *reader);
+
+#endif
@@ -5,6 +5,8 @@
 #include "structmember.h"
 #include "blueprint.h"
 #include "column.h"
+#include "allocator.h"
+#include "index.h"
 #include <stdbool.h>
 
 typedef struct {
@@ -20,15 +22,64 @@ typedef struct {
     Py_ssize_t size;
     Py_ssize_t width;
     QtbColumn *columns;
+
+    // A view shares the columns of base, an owning table, and holds rows
+    // offset, offset + step, ... of it; it never changes them. Owning tables
+    // have no base, offset 0 and step 1, and count the views made of them,
+    // which keep them from dropping rows.
+    PyObject *base;
+    Py_ssize_t offset;
+    Py_ssize_t step;
+    Py_ssize_t views;
+
+    // Column buffers, Arrow arrays and Arrow streams currently exported; the
+    // table neither grows nor shrinks while any are alive.
+    Py_ssize_t exports;
+
+    // Hash indexes over some of the columns, kept up to date as rows are
+    // appended and popped. Views have none.
+    QtbIndex *indexes;
+    Py_ssize_t n_indexes;
+
+    // Points at owned_allocator, a pool's allocator or the libc default.
+    QtbAllocator *allocator;
+    QtbAllocator owned_allocator;
+    PyObject *pool;
 } QtbTable;
 
+// Row of the table's columns holding the table's row i.
+static inline size_t qtb_table_row(QtbTable *self, Py_ssize_t i) {
+  return (size_t)(self->offset + i * self->step);
+}
+
 void qtb_table_new_(QtbTable *self);
 void qtb_table_dealloc_(QtbTable *self);
+Result qtb_table_use_allocator_(QtbTable *self, PyObject *allocator);
 Result qtb_table_init_(QtbTable *self, PyObject *blueprint);
 Py_ssize_t qtb_table_length(QtbTable *self);
 ResultPyObjectPtr qtb_table_item_(QtbTable *self, Py_ssize_t i);
+ResultPyObjectPtr qtb_table_slice_(QtbTable *self, PyObject *slice);
+ResultPyObjectPtr qtb_table_copy_(QtbTable *self);
+ResultPyObjectPtr qtb_table_take_(QtbTable *self, PyObject *indices);
+ResultPyObjectPtr qtb_table_filter_(QtbTable *self, PyObject *mask);
 Result qtb_table_append_(QtbTable *self, PyObject *row);
+Result qtb_table_extend_(QtbTable *self, PyObject *rows);
+Result qtb_table_commit_rows_(QtbTable *self, Py_ssize_t n);
+Result qtb_table_create_index_(QtbTable *self, PyObject *key, bool unique);
+ResultPyObjectPtr qtb_table_lookup_(QtbTable *self, PyObject *column, PyObject *key);
+ResultSize_t qtb_table_column_index_(QtbTable *self, PyObject *key);
+ResultPyObjectPtr qtb_table_column_(QtbTable *self, PyObject *key);
+void qtb_table_truncate_columns(QtbTable *self);
+Result qtb_table_extend_columns_(QtbTable *self, PyObject *columns, const char *caller);
 ResultPyObjectPtr qtb_table_pop_(QtbTable *self);
 ResultPyObjectPtr qtb_table_blueprint_(QtbTable *self);
+Result qtb_table_reserve_(QtbTable *self, Py_ssize_t capacity);
+Result qtb_table_shrink_to_fit_(QtbTable *self);
+Result qtb_table_compress_(QtbTable *self, PyObject *key);
+Py_ssize_t qtb_table_capacity_(QtbTable *self);
+ResultPyObjectPtr qtb_table_column_buffer_(QtbTable *self, PyObject *key, Py_ssize_t chunk);
+ResultPyObjectPtr qtb_table_column_buffers_(QtbTable *self, PyObject *key);
+ResultPyObjectPtr qtb_table_memory_usage_(QtbTable *self);
+size_t qtb_table_sizeof_(QtbTable *self);
 
 #endif
@@ -0,0 +1,52 @@
+#ifndef QTB_TABLE_FILE_H
+#define QTB_TABLE_FILE_H
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "table.h"
+#include "result.h"
+
+#define QTB_TABLE_FILE_MAGIC "QTBTABLE"
+#define QTB_TABLE_FILE_VERSION 1
+#define QTB_TABLE_FILE_BYTE_ORDER 0x01020304
+#define QTB_TABLE_FILE_ALIGNMENT 64
+#define QTB_TABLE_FILE_WRITE_BUFFER_SIZE (1024 * 1024)
+
+// A table file is the header, one QtbTableFileColumn per column and then
+// blocks, all in native byte order. Each block is laid out like a mapped
+// allocation: a QtbAllocationHeader holding its size followed by its bytes,
+// which start at a multiple of QTB_TABLE_FILE_ALIGNMENT. Offsets are those of
+// a block's bytes from the start of the file.
+//
+// Chunks are stored as they are held in memory, so that loading a table only
+// points its columns at the mapped file. Long str values and category values
+// are packed into heap blocks addressed by arena slots, as in memory.
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t size;
+  uint64_t width;
+  uint64_t chunk_size;
+} QtbTableFileHeader;
+
+typedef struct {
+  // NUL terminated name and type, e.g. "int?"
+  uint64_t name;
+  uint64_t type;
+  // 2 * n_chunks offsets: the data and validity of each chunk, the latter 0
+  // for columns that are not nullable
+  uint64_t chunks;
+  // n_heap offsets of the blocks holding long str values or category values
+  uint64_t heap;
+  uint64_t n_heap;
+  // category columns: dictionary_size QtbDictionaryEntry
+  uint64_t entries;
+  uint64_t dictionary_size;
+} QtbTableFileColumn;
+
+Result qtb_table_file_save_(QtbTable *table, const char *path);
+ResultPyObjectPtr qtb_table_file_load_(PyTypeObject *type, const char *path, bool mapped);
+
+#endif
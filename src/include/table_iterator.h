@@ -0,0 +1,22 @@
+#ifndef QTB_TABLE_ITERATOR_H
+#define QTB_TABLE_ITERATOR_H
+
+#include <Python.h>
+#include "table.h"
+
+// Iterator over a table's rows as tuples, reading the columns directly.
+// When the caller has let go of the last row the same tuple is refilled
+// instead of allocating another one.
+typedef struct {
+  PyObject_HEAD
+
+  QtbTable *table;
+  Py_ssize_t i;
+  PyObject *row;
+} QtbTableIterator;
+
+extern PyTypeObject QtbTableIteratorType;
+
+ResultPyObjectPtr qtb_table_iterator_new_(QtbTable *table);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef QTB_UTF8_H
+#define QTB_UTF8_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Whether [s, s + size) is UTF-8 that Python decodes: no overlong forms,
+// surrogates or code points past U+10FFFF. Runs of ASCII are skipped 8
+// bytes at a time.
+static inline bool qtb_utf8_valid(const char *s, size_t size) {
+  const unsigned char *p = (const unsigned char *)s;
+  const unsigned char *end = p + size;
+  uint64_t word;
+  unsigned char c;
+  unsigned char low;
+  unsigned char high;
+  size_t n;
+
+  while (p < end) {
+    if (end - p >= 8) {
+      memcpy(&word, p, 8);
+      if ((word & 0x8080808080808080ULL) == 0) {
+        p += 8;
+        continue;
+      }
+    }
+
+    c = *p;
+    if (c < 0x80) {
+      p++;
+      continue;
+    }
+
+    // The second byte's range narrows for E0, ED, F0 and F4 so as to leave
+    // out overlong forms, surrogates and code points past U+10FFFF.
+    low = 0x80;
+    high = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) n = 1;
+    else if (c >= 0xE0 && c <= 0xEF) {
+      n = 2;
+      if (c == 0xE0) low = 0xA0;
+      if (c == 0xED) high = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      n = 3;
+      if (c == 0xF0) low = 0x90;
+      if (c == 0xF4) high = 0x8F;
+    } else {
+      return false;
+    }
+
+    if ((size_t)(end - p) <= n || p[1] < low || p[1] > high) return false;
+    for (size_t k = 2; k <= n; k++)
+      if (p[k] < 0x80 || p[k] > 0xBF) return false;
+
+    p += n + 1;
+  }
+
+  return true;
+}
+
+#endif
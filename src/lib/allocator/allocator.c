@@ -0,0 +1,405 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "allocator.h"
+
+#define qtb_allocation_align(size) (((size) + 15) & ~(size_t)15)
+#define qtb_allocation_round_up(size, to) (((size) + (to) - 1) / (to) * (to))
+
+static void *qtb_allocator_malloc_malloc(QtbAllocator *allocator, size_t size) {
+  return malloc(size);
+}
+
+static void *qtb_allocator_malloc_realloc(QtbAllocator *allocator, void *p, size_t size) {
+  return realloc(p, size);
+}
+
+static void qtb_allocator_malloc_free(QtbAllocator *allocator, void *p) {
+  free(p);
+}
+
+static void qtb_allocator_malloc_dealloc(QtbAllocator *allocator) {}
+
+QtbAllocator qtb_allocator_default = {
+  .malloc = &qtb_allocator_malloc_malloc,
+  .realloc = &qtb_allocator_malloc_realloc,
+  .free = &qtb_allocator_malloc_free,
+  .dealloc = &qtb_allocator_malloc_dealloc,
+};
+
+static void qtb_allocator_reset(QtbAllocator *allocator) {
+  allocator->blocks = NULL;
+  allocator->n_blocks = 0;
+  allocator->current = 0;
+  allocator->used = 0;
+  allocator->last = NULL;
+
+  memset(allocator->free_lists, 0, sizeof(allocator->free_lists));
+  allocator->cached = 0;
+
+  allocator->image = NULL;
+  allocator->image_size = 0;
+  allocator->image_mapped = false;
+}
+
+void qtb_allocator_malloc_new(QtbAllocator *allocator) {
+  *allocator = qtb_allocator_default;
+  qtb_allocator_reset(allocator);
+}
+
+// ===== arena and hugepage =====
+
+static char *qtb_allocator_map(bool huge, size_t size) {
+  char *mapped;
+  char *aligned;
+  size_t head;
+
+  if (!huge) return (char *)malloc(size);
+
+  // Over-map by one huge page so that the block can start on a huge page
+  // boundary, then hand the unaligned ends back.
+  mapped = (char *)mmap(NULL, size + QTB_ALLOCATOR_HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) return NULL;
+
+  aligned = (char *)qtb_allocation_round_up((uintptr_t)mapped, QTB_ALLOCATOR_HUGEPAGE_SIZE);
+  head = aligned - mapped;
+  if (head > 0) munmap(mapped, head);
+  munmap(aligned + size, QTB_ALLOCATOR_HUGEPAGE_SIZE - head);
+
+#ifdef MADV_HUGEPAGE
+  madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+  return aligned;
+}
+
+static void qtb_allocator_unmap(bool huge, char *base, size_t size) {
+  if (huge) munmap(base, size);
+  else free(base);
+}
+
+static QtbAllocatorBlock *qtb_allocator_add_block(QtbAllocator *allocator, bool huge, size_t size) {
+  QtbAllocatorBlock *blocks;
+  char *base;
+
+  blocks = (QtbAllocatorBlock *)realloc(allocator->blocks, (allocator->n_blocks + 1) * sizeof(QtbAllocatorBlock));
+  if (blocks == NULL) return NULL;
+  allocator->blocks = blocks;
+
+  base = qtb_allocator_map(huge, size);
+  if (base == NULL) return NULL;
+
+  allocator->blocks[allocator->n_blocks] = (QtbAllocatorBlock){base, size};
+  return &allocator->blocks[allocator->n_blocks++];
+}
+
+static size_t qtb_allocator_next_block_size(QtbAllocator *allocator, bool huge) {
+  size_t size;
+
+  if (huge) return QTB_ALLOCATOR_HUGEPAGE_SIZE;
+  if (allocator->n_blocks == 0) return QTB_ALLOCATOR_ARENA_INITIAL_BLOCK_SIZE;
+
+  size = 2 * allocator->blocks[allocator->current].size;
+  return size > QTB_ALLOCATOR_ARENA_MAX_BLOCK_SIZE ? QTB_ALLOCATOR_ARENA_MAX_BLOCK_SIZE : size;
+}
+
+static void *qtb_allocator_bump_malloc(QtbAllocator *allocator, bool huge, size_t size) {
+  QtbAllocationHeader *header;
+  QtbAllocatorBlock *block;
+  size_t needed;
+  size_t block_size;
+
+  needed = sizeof(QtbAllocationHeader) + qtb_allocation_align(size);
+
+  if (allocator->n_blocks == 0 || allocator->blocks[allocator->current].size - allocator->used < needed) {
+    block_size = qtb_allocator_next_block_size(allocator, huge);
+
+    // Allocations that do not fit in a fresh block get a block of their own
+    // and leave the block being bumped into untouched.
+    if (needed > block_size) {
+      if (huge) needed = qtb_allocation_round_up(needed, QTB_ALLOCATOR_HUGEPAGE_SIZE);
+      block = qtb_allocator_add_block(allocator, huge, needed);
+      if (block == NULL) return NULL;
+
+      header = (QtbAllocationHeader *)block->base;
+      header->size = size;
+      return header + 1;
+    }
+
+    if (qtb_allocator_add_block(allocator, huge, block_size) == NULL) return NULL;
+    allocator->current = allocator->n_blocks - 1;
+    allocator->used = 0;
+  }
+
+  block = &allocator->blocks[allocator->current];
+  header = (QtbAllocationHeader *)(block->base + allocator->used);
+  header->size = size;
+
+  allocator->used += needed;
+  allocator->last = (char *)header;
+
+  return header + 1;
+}
+
+// Only the most recent allocation can be given back, which covers a column
+// growing its tail chunk or a string arena trimming its block.
+static void qtb_allocator_bump_free(QtbAllocator *allocator, void *p) {
+  QtbAllocationHeader *header;
+
+  if (p == NULL) return;
+
+  header = qtb_allocation_header_of(p);
+  if ((char *)header != allocator->last) return;
+
+  allocator->used = (char *)header - allocator->blocks[allocator->current].base;
+  allocator->last = NULL;
+}
+
+static void *qtb_allocator_bump_realloc(QtbAllocator *allocator, bool huge, void *p, size_t size) {
+  QtbAllocationHeader *header;
+  QtbAllocatorBlock *block;
+  size_t offset;
+  void *moved;
+
+  if (p == NULL) return qtb_allocator_bump_malloc(allocator, huge, size);
+
+  header = qtb_allocation_header_of(p);
+  if ((char *)header == allocator->last) {
+    block = &allocator->blocks[allocator->current];
+    offset = (char *)p - block->base;
+
+    if (block->size - offset >= qtb_allocation_align(size)) {
+      allocator->used = offset + qtb_allocation_align(size);
+      header->size = size;
+      return p;
+    }
+  }
+
+  moved = qtb_allocator_bump_malloc(allocator, huge, size);
+  if (moved == NULL) return NULL;
+
+  memcpy(moved, p, header->size < size ? header->size : size);
+  qtb_allocator_bump_free(allocator, p);
+
+  return moved;
+}
+
+static void qtb_allocator_bump_dealloc(QtbAllocator *allocator, bool huge) {
+  for (size_t i = 0; i < allocator->n_blocks; i++)
+    qtb_allocator_unmap(huge, allocator->blocks[i].base, allocator->blocks[i].size);
+
+  free(allocator->blocks);
+  qtb_allocator_reset(allocator);
+}
+
+static void *qtb_allocator_arena_malloc(QtbAllocator *allocator, size_t size) {
+  return qtb_allocator_bump_malloc(allocator, false, size);
+}
+
+static void *qtb_allocator_arena_realloc(QtbAllocator *allocator, void *p, size_t size) {
+  return qtb_allocator_bump_realloc(allocator, false, p, size);
+}
+
+static void qtb_allocator_arena_dealloc(QtbAllocator *allocator) {
+  qtb_allocator_bump_dealloc(allocator, false);
+}
+
+void qtb_allocator_arena_new(QtbAllocator *allocator) {
+  allocator->malloc = &qtb_allocator_arena_malloc;
+  allocator->realloc = &qtb_allocator_arena_realloc;
+  allocator->free = &qtb_allocator_bump_free;
+  allocator->dealloc = &qtb_allocator_arena_dealloc;
+  qtb_allocator_reset(allocator);
+}
+
+static void *qtb_allocator_hugepage_malloc(QtbAllocator *allocator, size_t size) {
+  return qtb_allocator_bump_malloc(allocator, true, size);
+}
+
+static void *qtb_allocator_hugepage_realloc(QtbAllocator *allocator, void *p, size_t size) {
+  return qtb_allocator_bump_realloc(allocator, true, p, size);
+}
+
+static void qtb_allocator_hugepage_dealloc(QtbAllocator *allocator) {
+  qtb_allocator_bump_dealloc(allocator, true);
+}
+
+void qtb_allocator_hugepage_new(QtbAllocator *allocator) {
+  allocator->malloc = &qtb_allocator_hugepage_malloc;
+  allocator->realloc = &qtb_allocator_hugepage_realloc;
+  allocator->free = &qtb_allocator_bump_free;
+  allocator->dealloc = &qtb_allocator_hugepage_dealloc;
+  qtb_allocator_reset(allocator);
+}
+
+// ===== pool =====
+
+static size_t qtb_allocator_pool_class_of(size_t size) {
+  size_t size_class;
+
+  size_class = QTB_ALLOCATOR_POOL_MIN_CLASS;
+  while (size_class <= QTB_ALLOCATOR_POOL_MAX_CLASS && ((size_t)1 << size_class) < size)
+    size_class++;
+
+  return size_class;
+}
+
+static void *qtb_allocator_pool_malloc(QtbAllocator *allocator, size_t size) {
+  QtbAllocationHeader *header;
+  size_t size_class;
+  void *p;
+
+  size_class = qtb_allocator_pool_class_of(size);
+
+  // Allocations above the largest class are not pooled.
+  if (size_class > QTB_ALLOCATOR_POOL_MAX_CLASS) {
+    header = (QtbAllocationHeader *)malloc(sizeof(QtbAllocationHeader) + size);
+    if (header == NULL) return NULL;
+
+    *header = (QtbAllocationHeader){size, size_class};
+    return header + 1;
+  }
+
+  if (allocator->free_lists[size_class] != NULL) {
+    p = allocator->free_lists[size_class];
+    allocator->free_lists[size_class] = *(void **)p;
+    allocator->cached -= (size_t)1 << size_class;
+
+    qtb_allocation_header_of(p)->size = size;
+    return p;
+  }
+
+  header = (QtbAllocationHeader *)malloc(sizeof(QtbAllocationHeader) + ((size_t)1 << size_class));
+  if (header == NULL) return NULL;
+
+  *header = (QtbAllocationHeader){size, size_class};
+  return header + 1;
+}
+
+static void qtb_allocator_pool_free(QtbAllocator *allocator, void *p) {
+  QtbAllocationHeader *header;
+
+  if (p == NULL) return;
+
+  header = qtb_allocation_header_of(p);
+  if (header->size_class > QTB_ALLOCATOR_POOL_MAX_CLASS) {
+    free(header);
+    return;
+  }
+
+  *(void **)p = allocator->free_lists[header->size_class];
+  allocator->free_lists[header->size_class] = p;
+  allocator->cached += (size_t)1 << header->size_class;
+}
+
+static void *qtb_allocator_pool_realloc(QtbAllocator *allocator, void *p, size_t size) {
+  QtbAllocationHeader *header;
+  void *moved;
+
+  if (p == NULL) return qtb_allocator_pool_malloc(allocator, size);
+
+  header = qtb_allocation_header_of(p);
+  if (header->size_class <= QTB_ALLOCATOR_POOL_MAX_CLASS && size <= ((size_t)1 << header->size_class)) {
+    header->size = size;
+    return p;
+  }
+
+  moved = qtb_allocator_pool_malloc(allocator, size);
+  if (moved == NULL) return NULL;
+
+  memcpy(moved, p, header->size < size ? header->size : size);
+  qtb_allocator_pool_free(allocator, p);
+
+  return moved;
+}
+
+static void qtb_allocator_pool_dealloc(QtbAllocator *allocator) {
+  void *p;
+
+  for (size_t i = 0; i <= QTB_ALLOCATOR_POOL_MAX_CLASS; i++) {
+    while ((p = allocator->free_lists[i]) != NULL) {
+      allocator->free_lists[i] = *(void **)p;
+      free(qtb_allocation_header_of(p));
+    }
+  }
+
+  qtb_allocator_reset(allocator);
+}
+
+void qtb_allocator_pool_new(QtbAllocator *allocator) {
+  allocator->malloc = &qtb_allocator_pool_malloc;
+  allocator->realloc = &qtb_allocator_pool_realloc;
+  allocator->free = &qtb_allocator_pool_free;
+  allocator->dealloc = &qtb_allocator_pool_dealloc;
+  qtb_allocator_reset(allocator);
+}
+
+// ===== mapped =====
+
+#define qtb_allocator_in_image(allocator, p) \
+  ((char *)(p) >= (allocator)->image && (char *)(p) < (allocator)->image + (allocator)->image_size)
+
+static void *qtb_allocator_mapped_malloc(QtbAllocator *allocator, size_t size) {
+  QtbAllocationHeader *header;
+
+  header = (QtbAllocationHeader *)malloc(sizeof(QtbAllocationHeader) + size);
+  if (header == NULL) return NULL;
+
+  *header = (QtbAllocationHeader){size, 0};
+  return header + 1;
+}
+
+// Blocks of the image are released along with it.
+static void qtb_allocator_mapped_free(QtbAllocator *allocator, void *p) {
+  if (p == NULL || qtb_allocator_in_image(allocator, p)) return;
+
+  free(qtb_allocation_header_of(p));
+}
+
+static void *qtb_allocator_mapped_realloc(QtbAllocator *allocator, void *p, size_t size) {
+  QtbAllocationHeader *header;
+  void *moved;
+
+  if (p == NULL) return qtb_allocator_mapped_malloc(allocator, size);
+
+  header = qtb_allocation_header_of(p);
+  if (!qtb_allocator_in_image(allocator, p)) {
+    header = (QtbAllocationHeader *)realloc(header, sizeof(QtbAllocationHeader) + size);
+    if (header == NULL) return NULL;
+
+    header->size = size;
+    return header + 1;
+  }
+
+  moved = qtb_allocator_mapped_malloc(allocator, size);
+  if (moved == NULL) return NULL;
+
+  memcpy(moved, p, header->size < size ? header->size : size);
+  return moved;
+}
+
+static void qtb_allocator_mapped_dealloc(QtbAllocator *allocator) {
+  if (allocator->image_mapped) munmap(allocator->image, allocator->image_size);
+  else free(allocator->image);
+
+  qtb_allocator_reset(allocator);
+}
+
+// Takes ownership of image, either mapped or allocated with malloc. Its
+// pages may be written to, so a file mapping must be private.
+void qtb_allocator_mapped_new(QtbAllocator *allocator, char *image, size_t size, bool mapped) {
+  allocator->malloc = &qtb_allocator_mapped_malloc;
+  allocator->realloc = &qtb_allocator_mapped_realloc;
+  allocator->free = &qtb_allocator_mapped_free;
+  allocator->dealloc = &qtb_allocator_mapped_dealloc;
+  qtb_allocator_reset(allocator);
+
+  allocator->image = image;
+  allocator->image_size = size;
+  allocator->image_mapped = mapped;
+}
+
+void qtb_allocator_dealloc(QtbAllocator *allocator) {
+  allocator->dealloc(allocator);
+}
@@ -0,0 +1,66 @@
+#include <Python.h>
+#include "pool.h"
+
+static PyObject *qtb_pool_new(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+  QtbPool *self;
+
+  self = (QtbPool *)type->tp_alloc(type, 0);
+  if (self != NULL) qtb_allocator_pool_new(&self->allocator);
+
+  return (PyObject *)self;
+}
+
+static void qtb_pool_dealloc(QtbPool *self) {
+  qtb_allocator_dealloc(&self->allocator);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *qtb_pool_cached(QtbPool *self, void *closure) {
+  return PyLong_FromSize_t(self->allocator.cached);
+}
+
+static PyGetSetDef qtb_pool_getsetters[] = {
+  {"cached", (getter)qtb_pool_cached, NULL, "bytes held for reuse", NULL},
+  {NULL}
+};
+
+PyTypeObject QtbPoolType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "quicktable.Pool",  // tp_name
+    sizeof(QtbPool),  // tp_basicsize
+    0,  // tp_itemsize
+    (destructor)qtb_pool_dealloc,  // tp_dealloc
+    0,  // tp_print
+    0,  // tp_getattr
+    0,  // tp_setattr
+    0,  // tp_reserved
+    0,  // tp_repr
+    0,  // tp_as_number
+    0,  // tp_as_sequence
+    0,  // tp_as_mapping
+    0,  // tp_hash
+    0,  // tp_call
+    0,  // tp_str
+    0,  // tp_getattro
+    0,  // tp_setattro
+    0,  // tp_as_buffer
+    Py_TPFLAGS_DEFAULT,  // tp_flags
+    "Memory pool shared by tables",  // tp_doc
+    0,  // tp_traverse
+    0,  // tp_clear
+    0,  // tp_richcompare
+    0,  // tp_weaklistoffset
+    0,  // tp_iter
+    0,  // tp_iternext
+    0,  // tp_methods
+    0,  // tp_members
+    qtb_pool_getsetters,  // tp_getset
+    0,  // tp_base
+    0,  // tp_dict
+    0,  // tp_descr_get
+    0,  // tp_descr_set
+    0,  // tp_dictoffset
+    0,  // tp_init
+    0,  // tp_alloc
+    qtb_pool_new  // tp_new
+};
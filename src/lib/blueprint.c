@@ -1,6 +1,7 @@
 #include "blueprint.h"
 #include "result.h"
 #include <stdbool.h>
+#include <string.h>
 #include <Python.h>
 
 static const char *qtb_valid_column_types[] = {
@@ -8,6 +9,15 @@ static const char *qtb_valid_column_types[] = {
   "int",
   "bool",
   "float",
+  "category",
+  "int8",
+  "int16",
+  "int32",
+  "uint8",
+  "uint16",
+  "uint32",
+  "uint64",
+  "float32",
 };
 
 static Result qtb_blueprint_validate_column_name(PyObject *descriptor) {
@@ -26,9 +36,20 @@ static Result qtb_blueprint_validate_column_name(PyObject *descriptor) {
 
 static bool qtb_blueprint_is_valid_column_type(PyObject *type) {
   bool contained = false;
+  const char *type_s;
+  Py_ssize_t size;
 
-  for (size_t i = 0; i < 4; i++) {
-    if(PyUnicode_CompareWithASCIIString(type, qtb_valid_column_types[i]) == 0) {
+  type_s = PyUnicode_AsUTF8AndSize(type, &size);
+  if (type_s == NULL) {
+    PyErr_Clear();
+    return false;
+  }
+
+  // Every column type has a nullable variant spelled with a trailing '?'.
+  if (size > 0 && type_s[size - 1] == '?') size--;
+
+  for (size_t i = 0; i < sizeof(qtb_valid_column_types) / sizeof(qtb_valid_column_types[0]); i++) {
+    if (strlen(qtb_valid_column_types[i]) == (size_t)size && strncmp(qtb_valid_column_types[i], type_s, size) == 0) {
       contained = true;
       break;
     }
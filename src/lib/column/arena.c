@@ -0,0 +1,128 @@
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "result.h"
+
+void qtb_arena_new(QtbArena *arena, QtbAllocator *allocator) {
+  arena->allocator = allocator;
+
+  arena->blocks = NULL;
+  arena->n_blocks = 0;
+  arena->current = 0;
+  arena->used = 0;
+  arena->capacity = 0;
+  arena->reserved = 0;
+}
+
+static char *qtb_arena_add_block(QtbArena *arena, size_t size) {
+  char **blocks;
+  char *block;
+
+  blocks = (char **)qtb_realloc(arena->allocator, arena->blocks, (arena->n_blocks + 1) * sizeof(char *));
+  if (blocks == NULL) return NULL;
+  arena->blocks = blocks;
+
+  block = (char *)qtb_malloc(arena->allocator, size > 0 ? size : 1);
+  if (block == NULL) return NULL;
+
+  arena->blocks[arena->n_blocks++] = block;
+  arena->reserved += size > 0 ? size : 1;
+  return block;
+}
+
+ResultQtbArenaSlot qtb_arena_store(QtbArena *arena, const char *s, size_t size) {
+  QtbArenaSlot slot;
+  size_t block_size;
+
+  if (size > UINT32_MAX) return ResultQtbArenaSlotFailure(PyExc_OverflowError, "str entry too long");
+
+  if (arena->n_blocks > 0 && arena->capacity - arena->used >= size) {
+    slot = (QtbArenaSlot){arena->current, arena->used};
+    memcpy(qtb_arena_at(arena, slot), s, size);
+    arena->used += size;
+    return ResultQtbArenaSlotSuccess(slot);
+  }
+
+  block_size = 2 * arena->capacity;
+  if (block_size < QTB_ARENA_INITIAL_BLOCK_SIZE) block_size = QTB_ARENA_INITIAL_BLOCK_SIZE;
+  if (block_size > QTB_ARENA_MAX_BLOCK_SIZE) block_size = QTB_ARENA_MAX_BLOCK_SIZE;
+
+  // Strings that do not fit in a fresh block get a block of their own and
+  // leave the block being bumped into untouched.
+  if (size > block_size) {
+    if (qtb_arena_add_block(arena, size) == NULL)
+      return ResultQtbArenaSlotFailure(PyExc_MemoryError, "failed to grow string arena");
+
+    slot = (QtbArenaSlot){arena->n_blocks - 1, 0};
+    memcpy(qtb_arena_at(arena, slot), s, size);
+    return ResultQtbArenaSlotSuccess(slot);
+  }
+
+  if (qtb_arena_add_block(arena, block_size) == NULL)
+    return ResultQtbArenaSlotFailure(PyExc_MemoryError, "failed to grow string arena");
+
+  arena->current = arena->n_blocks - 1;
+  arena->capacity = block_size;
+  arena->used = size;
+
+  slot = (QtbArenaSlot){arena->current, 0};
+  memcpy(qtb_arena_at(arena, slot), s, size);
+  return ResultQtbArenaSlotSuccess(slot);
+}
+
+void qtb_arena_unstore(QtbArena *arena, QtbArenaSlot slot, size_t size) {
+  if (slot.block == arena->current && slot.offset + size == arena->used)
+    arena->used = slot.offset;
+}
+
+// Trims the block being bumped into. Stores that follow start a new block.
+void qtb_arena_shrink_to_fit(QtbArena *arena) {
+  char *block;
+
+  if (arena->n_blocks == 0 || arena->used == 0 || arena->used == arena->capacity) return;
+
+  block = (char *)qtb_realloc(arena->allocator, arena->blocks[arena->current], arena->used);
+  if (block == NULL) return;
+
+  arena->blocks[arena->current] = block;
+  arena->reserved -= arena->capacity - arena->used;
+  arena->capacity = arena->used;
+}
+
+// Takes over n_blocks blocks of the given sizes that were allocated through
+// the arena's allocator. They are all treated as full, so the next store
+// starts a block of its own.
+Result qtb_arena_adopt_blocks(QtbArena *arena, char **blocks, const size_t *sizes, size_t n_blocks) {
+  char **adopted;
+
+  if (n_blocks == 0) return ResultSuccess();
+
+  adopted = (char **)qtb_malloc(arena->allocator, n_blocks * sizeof(char *));
+  if (adopted == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow string arena");
+  memcpy(adopted, blocks, n_blocks * sizeof(char *));
+
+  qtb_arena_dealloc(arena);
+  arena->blocks = adopted;
+  arena->n_blocks = n_blocks;
+  arena->current = n_blocks - 1;
+  arena->used = sizes[n_blocks - 1];
+  arena->capacity = sizes[n_blocks - 1];
+
+  for (size_t i = 0; i < n_blocks; i++)
+    arena->reserved += sizes[i];
+
+  return ResultSuccess();
+}
+
+void qtb_arena_dealloc(QtbArena *arena) {
+  for (size_t i = 0; i < arena->n_blocks; i++)
+    qtb_free(arena->allocator, arena->blocks[i]);
+
+  qtb_free(arena->allocator, arena->blocks);
+  arena->blocks = NULL;
+  arena->n_blocks = 0;
+  arena->current = 0;
+  arena->used = 0;
+  arena->capacity = 0;
+  arena->reserved = 0;
+}
@@ -1,35 +1,61 @@
+#include <float.h>
+#include <math.h>
 #include "column.h"
 #include "result.h"
 #include "column_as_string.h"
+#include "column_from_string.h"
+#include "column_from_buffer.h"
 
 // ===== qtb_column_str =====
 
 static ResultPyObjectPtr qtb_column_get_as_pyobject_str(QtbColumn *column, size_t i) {
   PyObject *str;
 
-  str = PyUnicode_FromString(column->data[i].s);
+  str = PyUnicode_FromStringAndSize(qtb_column_str_at(column, i), qtb_column_str_size_at(column, i));
   if (str == NULL) return ResultPyObjectPtrFailureFromPyErr();
 
   return ResultPyObjectPtrSuccess(str);
 }
 
+Result qtb_column_store_str(QtbColumn *column, const char *s, size_t size) {
+  QtbColumnStr *cell;
+  ResultQtbArenaSlot slot;
+
+  cell = qtb_column_str_cell(column, column->size);
+  memset(cell, 0, sizeof(QtbColumnStr));
+
+  if (size <= QTB_COLUMN_STR_INLINE_SIZE) {
+    memcpy(cell->value.inlined, s, size);
+  } else {
+    slot = qtb_arena_store(&column->arena, s, size);
+    if (ResultFailed(slot)) return ResultFailureFromResult(slot);
+
+    memcpy(cell->value.ref.prefix, s, QTB_COLUMN_STR_PREFIX_SIZE);
+    cell->value.ref.slot = ResultValue(slot);
+  }
+
+  cell->size = (uint32_t)size;
+  return ResultSuccess();
+}
+
 static Result qtb_column_append_str(QtbColumn *column, PyObject *item) {
   const char *s;
+  Py_ssize_t size;
 
   if (PyUnicode_Check(item) == 0) return ResultFailure(PyExc_TypeError, "non-str entry for str column");
 
-  s = column->PyUnicode_AsUTF8(item);
+  s = column->PyUnicode_AsUTF8AndSize(item, &size);
   if (s == NULL) return ResultFailureFromPyErr();
 
-  column->data[column->size].s = column->strdup(s);
-  if (column->data[column->size].s == NULL) return ResultFailure(PyExc_MemoryError, "could not create PyUnicodeobject");
-
-  return ResultSuccess();
+  return qtb_column_store_str(column, s, (size_t)size);
 }
 
-void qtb_column_dealloc_str(QtbColumn *column) {
-  for (size_t i = 0; i < column->size; i++)
-    free(column->data[i].s);
+static void qtb_column_pop_str(QtbColumn *column) {
+  QtbColumnStr *cell;
+
+  cell = qtb_column_str_cell(column, column->size);
+  if (cell->size > QTB_COLUMN_STR_INLINE_SIZE)
+    qtb_arena_unstore(&column->arena, cell->value.ref.slot, cell->size);
 }
 
 // ===== qtb_column_int =====
@@ -37,7 +63,7 @@ void qtb_column_dealloc_str(QtbColumn *column) {
 static ResultPyObjectPtr qtb_column_get_as_pyobject_int(QtbColumn *column, size_t i) {
   PyObject *str;
 
-  str = PyLong_FromLongLong(column->data[i].i);
+  str = PyLong_FromLongLong(qtb_column_int_at(column, i));
   if (str == NULL)
     return ResultPyObjectPtrFailureFromPyErr();
 
@@ -45,19 +71,92 @@ static ResultPyObjectPtr qtb_column_get_as_pyobject_int(QtbColumn *column, size_
 }
 
 static Result qtb_column_append_int(QtbColumn *column, PyObject *item) {
+  long long value;
+
   if (PyLong_Check(item) == 0)
     return ResultFailure(PyExc_TypeError, "non-int entry for int column");
 
-  column->data[column->size].i = PyLong_AsLongLong(item);
+  value = PyLong_AsLongLong(item);
+  if (value == -1 && PyErr_Occurred()) {
+    PyErr_Clear();
+    return ResultFailure(PyExc_OverflowError, "int out of range for int column");
+  }
+
+  qtb_column_cell(column, int64_t, column->size) = value;
   return ResultSuccess();
 }
 
+// ===== qtb_column_int8, int16, int32 =====
+
+#define QTB_COLUMN_DEFINE_SIGNED(name, ctype, min, max) \
+  static ResultPyObjectPtr qtb_column_get_as_pyobject_##name(QtbColumn *column, size_t i) { \
+    PyObject *value; \
+    \
+    value = PyLong_FromLongLong(qtb_column_value_at(column, ctype, i)); \
+    if (value == NULL) return ResultPyObjectPtrFailureFromPyErr(); \
+    \
+    return ResultPyObjectPtrSuccess(value); \
+  } \
+  \
+  static Result qtb_column_append_##name(QtbColumn *column, PyObject *item) { \
+    long long value; \
+    \
+    if (PyLong_Check(item) == 0) \
+      return ResultFailure(PyExc_TypeError, "non-int entry for " #name " column"); \
+    \
+    value = PyLong_AsLongLong(item); \
+    if (value == -1 && PyErr_Occurred()) PyErr_Clear(); \
+    else if (value >= min && value <= max) { \
+      qtb_column_cell(column, ctype, column->size) = (ctype)value; \
+      return ResultSuccess(); \
+    } \
+    \
+    return ResultFailure(PyExc_OverflowError, "int out of range for " #name " column"); \
+  }
+
+QTB_COLUMN_DEFINE_SIGNED(int8, int8_t, INT8_MIN, INT8_MAX)
+QTB_COLUMN_DEFINE_SIGNED(int16, int16_t, INT16_MIN, INT16_MAX)
+QTB_COLUMN_DEFINE_SIGNED(int32, int32_t, INT32_MIN, INT32_MAX)
+
+// ===== qtb_column_uint8, uint16, uint32, uint64 =====
+
+#define QTB_COLUMN_DEFINE_UNSIGNED(name, ctype, max) \
+  static ResultPyObjectPtr qtb_column_get_as_pyobject_##name(QtbColumn *column, size_t i) { \
+    PyObject *value; \
+    \
+    value = PyLong_FromUnsignedLongLong(qtb_column_value_at(column, ctype, i)); \
+    if (value == NULL) return ResultPyObjectPtrFailureFromPyErr(); \
+    \
+    return ResultPyObjectPtrSuccess(value); \
+  } \
+  \
+  static Result qtb_column_append_##name(QtbColumn *column, PyObject *item) { \
+    unsigned long long value; \
+    \
+    if (PyLong_Check(item) == 0) \
+      return ResultFailure(PyExc_TypeError, "non-int entry for " #name " column"); \
+    \
+    value = PyLong_AsUnsignedLongLong(item); \
+    if (value == (unsigned long long)-1 && PyErr_Occurred()) PyErr_Clear(); \
+    else if (value <= max) { \
+      qtb_column_cell(column, ctype, column->size) = (ctype)value; \
+      return ResultSuccess(); \
+    } \
+    \
+    return ResultFailure(PyExc_OverflowError, "int out of range for " #name " column"); \
+  }
+
+QTB_COLUMN_DEFINE_UNSIGNED(uint8, uint8_t, UINT8_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED(uint16, uint16_t, UINT16_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED(uint32, uint32_t, UINT32_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED(uint64, uint64_t, UINT64_MAX)
+
 // ===== qtb_column_float =====
 
 static ResultPyObjectPtr qtb_column_get_as_pyobject_float(QtbColumn *column, size_t i) {
   PyObject *str;
 
-  str = PyFloat_FromDouble(column->data[i].f);
+  str = PyFloat_FromDouble(qtb_column_float_at(column, i));
   if (str == NULL) return ResultPyObjectPtrFailureFromPyErr();
 
   return ResultPyObjectPtrSuccess(str);
@@ -67,7 +166,32 @@ static Result qtb_column_append_float(QtbColumn *column, PyObject *item) {
   if(PyFloat_Check(item) == 0)
     return ResultFailure(PyExc_TypeError, "non-float entry for float column");
 
-  column->data[column->size].f = PyFloat_AsDouble(item);
+  qtb_column_cell(column, double, column->size) = PyFloat_AsDouble(item);
+  return ResultSuccess();
+}
+
+// ===== qtb_column_float32 =====
+
+static ResultPyObjectPtr qtb_column_get_as_pyobject_float32(QtbColumn *column, size_t i) {
+  PyObject *value;
+
+  value = PyFloat_FromDouble(qtb_column_cell(column, float, i));
+  if (value == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  return ResultPyObjectPtrSuccess(value);
+}
+
+static Result qtb_column_append_float32(QtbColumn *column, PyObject *item) {
+  double value;
+
+  if (PyFloat_Check(item) == 0)
+    return ResultFailure(PyExc_TypeError, "non-float entry for float32 column");
+
+  value = PyFloat_AsDouble(item);
+  if (isfinite(value) && (value > FLT_MAX || value < -FLT_MAX))
+    return ResultFailure(PyExc_OverflowError, "float out of range for float32 column");
+
+  qtb_column_cell(column, float, column->size) = (float)value;
   return ResultSuccess();
 }
 
@@ -76,17 +200,48 @@ static Result qtb_column_append_float(QtbColumn *column, PyObject *item) {
 static ResultPyObjectPtr qtb_column_get_as_pyobject_bool(QtbColumn *column, size_t i) {
   PyObject *str;
 
-  str = PyBool_FromLong(column->data[i].b);
+  str = PyBool_FromLong(qtb_column_bool_at(column, i));
   if (str == NULL) return ResultPyObjectPtrFailureFromPyErr();
 
   return ResultPyObjectPtrSuccess(str);
 }
 
 static Result qtb_column_append_bool(QtbColumn *column, PyObject *item) {
+  uint64_t *word;
+  uint64_t bit;
+
   if (PyBool_Check(item) == 0)
     return ResultFailure(PyExc_TypeError, "non-bool entry for bool column");
 
-  column->data[column->size].b = (bool)PyLong_AsLong(item);
+  word = &qtb_column_bool_word(column, column->size);
+  bit = qtb_column_bit_of(column->size);
+
+  if (item == Py_True) *word |= bit;
+  else *word &= ~bit;
+
+  return ResultSuccess();
+}
+
+// ===== qtb_column_category =====
+
+static ResultPyObjectPtr qtb_column_get_as_pyobject_category(QtbColumn *column, size_t i) {
+  return qtb_dictionary_get_as_pyobject(&column->dictionary, qtb_column_code_at(column, i));
+}
+
+static Result qtb_column_append_category(QtbColumn *column, PyObject *item) {
+  const char *s;
+  Py_ssize_t size;
+  ResultSize_t code;
+
+  if (PyUnicode_Check(item) == 0) return ResultFailure(PyExc_TypeError, "non-str entry for category column");
+
+  s = column->PyUnicode_AsUTF8AndSize(item, &size);
+  if (s == NULL) return ResultFailureFromPyErr();
+
+  code = qtb_dictionary_intern(&column->dictionary, s, (size_t)size);
+  if (ResultFailed(code)) return ResultFailureFromResult(code);
+
+  qtb_column_cell(column, uint32_t, column->size) = (uint32_t)ResultValue(code);
   return ResultSuccess();
 }
 
@@ -94,90 +249,843 @@ static Result qtb_column_append_bool(QtbColumn *column, PyObject *item) {
 
 void qtb_column_dealloc_default(QtbColumn *column) {}
 
+static void qtb_column_pop_default(QtbColumn *column) {}
+
+#define QTB_COLUMN_INIT_NUMERIC_METHODS(column, name) \
+  do { \
+    (column)->get_as_pyobject = &qtb_column_get_as_pyobject_##name; \
+    (column)->append = &qtb_column_append_##name; \
+    (column)->append_string = &qtb_column_##name##_append_string; \
+    (column)->append_buffer = &qtb_column_##name##_append_buffer; \
+    (column)->type_as_string = &qtb_column_##name##_type_as_string; \
+    (column)->cell_as_string = &qtb_column_##name##_cell_as_string; \
+    (column)->dealloc = &qtb_column_dealloc_default; \
+    (column)->pop = &qtb_column_pop_default; \
+  } while (0)
+
 void qtb_column_init_methods(QtbColumn *column) {
   switch (column->type) {
     case QTB_COLUMN_TYPE_STR:
       column->get_as_pyobject = &qtb_column_get_as_pyobject_str;
       column->append = &qtb_column_append_str;
+      column->append_string = &qtb_column_str_append_string;
+      column->append_buffer = NULL;
       column->type_as_string = &qtb_column_str_type_as_string;
       column->cell_as_string = &qtb_column_str_cell_as_string;
-      column->dealloc = &qtb_column_dealloc_str;
+      column->dealloc = &qtb_column_dealloc_default;
+      column->pop = &qtb_column_pop_str;
       break;
     case QTB_COLUMN_TYPE_INT:
       column->get_as_pyobject = &qtb_column_get_as_pyobject_int;
       column->append = &qtb_column_append_int;
+      column->append_string = &qtb_column_int_append_string;
+      column->append_buffer = &qtb_column_int_append_buffer;
       column->type_as_string = &qtb_column_int_type_as_string;
       column->cell_as_string = &qtb_column_int_cell_as_string;
       column->dealloc = &qtb_column_dealloc_default;
+      column->pop = &qtb_column_pop_default;
       break;
     case QTB_COLUMN_TYPE_FLOAT:
       column->get_as_pyobject = &qtb_column_get_as_pyobject_float;
       column->append = &qtb_column_append_float;
+      column->append_string = &qtb_column_float_append_string;
+      column->append_buffer = &qtb_column_float_append_buffer;
       column->type_as_string = &qtb_column_float_type_as_string;
       column->cell_as_string = &qtb_column_float_cell_as_string;
       column->dealloc = &qtb_column_dealloc_default;
+      column->pop = &qtb_column_pop_default;
       break;
     case QTB_COLUMN_TYPE_BOOL:
       column->get_as_pyobject = &qtb_column_get_as_pyobject_bool;
       column->append = &qtb_column_append_bool;
+      column->append_string = &qtb_column_bool_append_string;
+      column->append_buffer = &qtb_column_bool_append_buffer;
       column->type_as_string = &qtb_column_bool_type_as_string;
       column->cell_as_string = &qtb_column_bool_cell_as_string;
       column->dealloc = &qtb_column_dealloc_default;
+      column->pop = &qtb_column_pop_default;
+      break;
+    case QTB_COLUMN_TYPE_CATEGORY:
+      column->get_as_pyobject = &qtb_column_get_as_pyobject_category;
+      column->append = &qtb_column_append_category;
+      column->append_string = &qtb_column_category_append_string;
+      column->append_buffer = NULL;
+      column->type_as_string = &qtb_column_category_type_as_string;
+      column->cell_as_string = &qtb_column_category_cell_as_string;
+      column->dealloc = &qtb_column_dealloc_default;
+      column->pop = &qtb_column_pop_default;
+      break;
+    case QTB_COLUMN_TYPE_INT8:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, int8);
+      break;
+    case QTB_COLUMN_TYPE_INT16:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, int16);
+      break;
+    case QTB_COLUMN_TYPE_INT32:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, int32);
+      break;
+    case QTB_COLUMN_TYPE_UINT8:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, uint8);
+      break;
+    case QTB_COLUMN_TYPE_UINT16:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, uint16);
+      break;
+    case QTB_COLUMN_TYPE_UINT32:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, uint32);
+      break;
+    case QTB_COLUMN_TYPE_UINT64:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, uint64);
+      break;
+    case QTB_COLUMN_TYPE_FLOAT32:
+      QTB_COLUMN_INIT_NUMERIC_METHODS(column, float32);
       break;
   }
 }
 
 ResultPyObjectPtr qtb_column_get_as_pyobject(QtbColumn *column, size_t i) {
+  if (!qtb_column_is_valid(column, i)) {
+    Py_INCREF(Py_None);
+    return ResultPyObjectPtrSuccess(Py_None);
+  }
+
   return column->get_as_pyobject(column, i);
 }
 
+size_t qtb_column_data_size(QtbColumnType type, size_t capacity) {
+  switch (type) {
+    case QTB_COLUMN_TYPE_STR:
+      return capacity * sizeof(QtbColumnStr);
+    case QTB_COLUMN_TYPE_INT:
+      return capacity * sizeof(int64_t);
+    case QTB_COLUMN_TYPE_FLOAT:
+      return capacity * sizeof(double);
+    case QTB_COLUMN_TYPE_BOOL:
+      return (capacity + QTB_COLUMN_BOOL_WORD_BITS - 1) / QTB_COLUMN_BOOL_WORD_BITS * sizeof(uint64_t);
+    case QTB_COLUMN_TYPE_CATEGORY:
+      return capacity * sizeof(uint32_t);
+    case QTB_COLUMN_TYPE_INT8:
+    case QTB_COLUMN_TYPE_UINT8:
+      return capacity * sizeof(uint8_t);
+    case QTB_COLUMN_TYPE_INT16:
+    case QTB_COLUMN_TYPE_UINT16:
+      return capacity * sizeof(uint16_t);
+    case QTB_COLUMN_TYPE_INT32:
+    case QTB_COLUMN_TYPE_UINT32:
+      return capacity * sizeof(uint32_t);
+    case QTB_COLUMN_TYPE_UINT64:
+      return capacity * sizeof(uint64_t);
+    case QTB_COLUMN_TYPE_FLOAT32:
+      return capacity * sizeof(float);
+  }
+
+  return 0;
+}
+
+size_t qtb_column_validity_size(size_t capacity) {
+  return qtb_column_data_size(QTB_COLUMN_TYPE_BOOL, capacity);
+}
+
+static Result qtb_column_resize_chunk(QtbColumn *column, QtbColumnChunk *chunk, size_t capacity) {
+  void *data;
+  uint64_t *validity;
+
+  data = qtb_realloc(column->allocator, chunk->data, qtb_column_data_size(column->type, capacity));
+  if (data == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow column");
+  chunk->data = data;
+
+  if (column->nullable) {
+    validity = (uint64_t *)qtb_realloc(column->allocator, chunk->validity, qtb_column_validity_size(capacity));
+    if (validity == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow column");
+    chunk->validity = validity;
+  }
+
+  return ResultSuccess();
+}
+
+static Result qtb_column_add_chunk(QtbColumn *column, size_t capacity) {
+  QtbColumnChunk *chunks;
+  QtbColumnChunk *chunk;
+  size_t chunks_capacity;
+  Result result;
+
+  if (column->n_chunks == column->chunks_capacity) {
+    chunks_capacity = column->chunks_capacity == 0 ? 1 : 2 * column->chunks_capacity;
+    chunks = (QtbColumnChunk *)qtb_realloc(column->allocator, column->chunks, chunks_capacity * sizeof(QtbColumnChunk));
+    if (chunks == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow column");
+
+    column->chunks = chunks;
+    column->chunks_capacity = chunks_capacity;
+  }
+
+  chunk = &column->chunks[column->n_chunks];
+  chunk->data = NULL;
+  chunk->validity = NULL;
+  chunk->encoded = NULL;
+
+  result = qtb_column_resize_chunk(column, chunk, capacity);
+  if (ResultFailed(result)) {
+    qtb_free(column->allocator, chunk->data);
+    qtb_free(column->allocator, chunk->validity);
+    return result;
+  }
+
+  column->n_chunks++;
+  column->capacity += capacity;
+
+  return ResultSuccess();
+}
+
+static size_t qtb_column_tail_capacity(QtbColumn *column) {
+  return column->capacity - (column->n_chunks - 1) * QTB_COLUMN_CHUNK_SIZE;
+}
+
+// Only the last chunk may hold fewer than QTB_COLUMN_CHUNK_SIZE rows. It is
+// resized until it is full, after which full-size chunks are added and rows
+// already written are never copied again. Small tails double so that short
+// columns settle after a few reallocations; larger ones grow by a smaller
+// factor to bound the slack left behind when appends stop.
 static Result qtb_column_grow(QtbColumn *column) {
+  size_t tail_capacity;
+  size_t new_capacity;
+  Result result;
+
+  tail_capacity = qtb_column_tail_capacity(column);
+  if (tail_capacity == QTB_COLUMN_CHUNK_SIZE) return qtb_column_add_chunk(column, QTB_COLUMN_CHUNK_SIZE);
+
+  if (tail_capacity < QTB_COLUMN_SMALL_CAPACITY) new_capacity = QTB_COLUMN_SMALL_GROWTH_COEFFICIENT * tail_capacity;
+  else new_capacity = QTB_COLUMN_GROWTH_COEFFICIENT * tail_capacity;
+  if (new_capacity <= tail_capacity) new_capacity = tail_capacity + 1;
+  if (new_capacity > QTB_COLUMN_CHUNK_SIZE) new_capacity = QTB_COLUMN_CHUNK_SIZE;
+
+  result = qtb_column_resize_chunk(column, &column->chunks[column->n_chunks - 1], new_capacity);
+  if (ResultFailed(result)) return result;
+
+  column->capacity += new_capacity - tail_capacity;
+
+  return ResultSuccess();
+}
+
+// The tail chunk is filled up to a full chunk first and the remaining rows
+// get chunks of their own, the last of which is sized exactly.
+Result qtb_column_reserve(QtbColumn *column, size_t capacity) {
+  size_t tail_capacity;
   size_t new_capacity;
-  QtbColumnData *new_data;
+  Result result;
+
+  if (capacity <= column->capacity) return ResultSuccess();
+
+  tail_capacity = qtb_column_tail_capacity(column);
+  if (tail_capacity < QTB_COLUMN_CHUNK_SIZE) {
+    new_capacity = MIN(tail_capacity + (capacity - column->capacity), QTB_COLUMN_CHUNK_SIZE);
+
+    result = qtb_column_resize_chunk(column, &column->chunks[column->n_chunks - 1], new_capacity);
+    if (ResultFailed(result)) return result;
+
+    column->capacity += new_capacity - tail_capacity;
+  }
+
+  while (column->capacity < capacity) {
+    result = qtb_column_add_chunk(column, MIN(capacity - column->capacity, QTB_COLUMN_CHUNK_SIZE));
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+// ===== compression =====
+
+bool qtb_column_compressible(QtbColumn *column) {
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_INT:
+    case QTB_COLUMN_TYPE_INT8:
+    case QTB_COLUMN_TYPE_INT16:
+    case QTB_COLUMN_TYPE_INT32:
+    case QTB_COLUMN_TYPE_UINT8:
+    case QTB_COLUMN_TYPE_UINT16:
+    case QTB_COLUMN_TYPE_UINT32:
+    case QTB_COLUMN_TYPE_UINT64:
+    case QTB_COLUMN_TYPE_BOOL:
+      return true;
+    default:
+      return false;
+  }
+}
 
-  new_capacity = QTB_COLUMN_GROWTH_COEFFICIENT * column->capacity;
-  new_data = (QtbColumnData *)column->realloc(column->data, new_capacity * sizeof(QtbColumnData));
-  if (new_data == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow column");
+static QtbEncodingCells qtb_column_encoding_cells(QtbColumn *column) {
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_BOOL:
+      return (QtbEncodingCells){QTB_ENCODING_KIND_BOOL, 0};
+    case QTB_COLUMN_TYPE_UINT8:
+    case QTB_COLUMN_TYPE_UINT16:
+    case QTB_COLUMN_TYPE_UINT32:
+    case QTB_COLUMN_TYPE_UINT64:
+      return (QtbEncodingCells){QTB_ENCODING_KIND_UNSIGNED, qtb_column_data_size(column->type, 1)};
+    default:
+      return (QtbEncodingCells){QTB_ENCODING_KIND_SIGNED, qtb_column_data_size(column->type, 1)};
+  }
+}
+
+// Compresses every chunk that is full of rows and not yet compressed, where
+// that makes it smaller. Chunks filled later stay as they are until this is
+// called again.
+Result qtb_column_compress(QtbColumn *column) {
+  QtbEncodedChunk *encoded;
+  Result result;
 
-  column->data = new_data;
-  column->capacity = new_capacity;
+  if (!qtb_column_compressible(column)) return ResultFailure(PyExc_TypeError, "compress of non-int, non-bool column");
+
+  if (column->decoded == NULL) {
+    column->decoded = qtb_malloc(column->allocator, QTB_ENCODING_BLOCK_SIZE * sizeof(uint64_t));
+    if (column->decoded == NULL) return ResultFailure(PyExc_MemoryError, "failed to compress column");
+  }
+
+  for (size_t chunk = 0; chunk < qtb_column_chunk_of(column->size); chunk++) {
+    if (column->chunks[chunk].encoded != NULL) continue;
+
+    result = qtb_encoding_encode(
+      qtb_column_encoding_cells(column),
+      column->chunks[chunk].data,
+      QTB_COLUMN_CHUNK_SIZE / QTB_ENCODING_BLOCK_SIZE,
+      column->allocator,
+      &encoded
+    );
+    if (ResultFailed(result)) return result;
+    if (encoded == NULL) continue;
+
+    qtb_free(column->allocator, column->chunks[chunk].data);
+    column->chunks[chunk].data = NULL;
+    column->chunks[chunk].encoded = encoded;
+    column->decoded_block = SIZE_MAX;
+  }
 
   return ResultSuccess();
 }
 
+// Writes the cells of a compressed chunk to to, which holds a full chunk.
+void qtb_column_decode_chunk(QtbColumn *column, size_t chunk, void *to) {
+  qtb_encoding_decode(qtb_column_encoding_cells(column), column->chunks[chunk].encoded, to);
+}
+
+// Turns a compressed chunk back into plain cells, e.g. before rows are
+// written to it again or before it is exported.
+Result qtb_column_decompress_chunk(QtbColumn *column, size_t chunk) {
+  void *data;
+
+  if (column->chunks[chunk].encoded == NULL) return ResultSuccess();
+
+  data = qtb_malloc(column->allocator, qtb_column_data_size(column->type, QTB_COLUMN_CHUNK_SIZE));
+  if (data == NULL) return ResultFailure(PyExc_MemoryError, "failed to decompress column");
+
+  qtb_column_decode_chunk(column, chunk, data);
+  qtb_encoding_free(column->allocator, column->chunks[chunk].encoded);
+  column->chunks[chunk].encoded = NULL;
+  column->chunks[chunk].data = data;
+  column->decoded_block = SIZE_MAX;
+
+  return ResultSuccess();
+}
+
+const void *qtb_column_decoded_cell(QtbColumn *column, size_t i) {
+  size_t block;
+  size_t offset;
+
+  block = i / QTB_ENCODING_BLOCK_SIZE;
+  if (column->decoded_block != block) {
+    qtb_encoding_decode_block(
+      qtb_column_encoding_cells(column),
+      column->chunks[qtb_column_chunk_of(i)].encoded,
+      qtb_column_offset_of(i) / QTB_ENCODING_BLOCK_SIZE,
+      column->decoded
+    );
+    column->decoded_block = block;
+  }
+
+  offset = i % QTB_ENCODING_BLOCK_SIZE;
+  if (column->type == QTB_COLUMN_TYPE_BOOL) return (const uint64_t *)column->decoded + offset / QTB_COLUMN_BOOL_WORD_BITS;
+
+  return (const char *)column->decoded + offset * qtb_column_data_size(column->type, 1);
+}
+
+// Replaces the column's chunks with n_chunks chunks holding size rows that
+// were allocated through the column's allocator, e.g. blocks of a mapped
+// table file. The tail chunk holds exactly its rows, so the first append past
+// them resizes it as for any other full tail.
+Result qtb_column_adopt_chunks(QtbColumn *column, QtbColumnChunk *chunks, size_t n_chunks, size_t size) {
+  QtbColumnChunk *adopted;
+
+  adopted = (QtbColumnChunk *)qtb_malloc(column->allocator, n_chunks * sizeof(QtbColumnChunk));
+  if (adopted == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow column");
+  memcpy(adopted, chunks, n_chunks * sizeof(QtbColumnChunk));
+
+  for (size_t i = 0; i < column->n_chunks; i++) {
+    qtb_free(column->allocator, column->chunks[i].data);
+    qtb_free(column->allocator, column->chunks[i].validity);
+  }
+  qtb_free(column->allocator, column->chunks);
+
+  column->chunks = adopted;
+  column->n_chunks = n_chunks;
+  column->chunks_capacity = n_chunks;
+  column->size = size;
+  column->capacity = size;
+
+  return ResultSuccess();
+}
+
+// Chunks past the last row are released and the tail chunk is trimmed to
+// the rows it holds. A column always keeps at least one row of capacity.
+Result qtb_column_shrink_to_fit(QtbColumn *column) {
+  size_t n_chunks;
+  size_t tail_capacity;
+  size_t tail_rows;
+  Result result;
+
+  n_chunks = MAX(qtb_column_chunk_of(column->size + QTB_COLUMN_CHUNK_MASK), 1);
+  while (column->n_chunks > n_chunks) {
+    column->n_chunks--;
+    column->capacity -= qtb_column_tail_capacity(column) - QTB_COLUMN_CHUNK_SIZE;
+    qtb_free(column->allocator, column->chunks[column->n_chunks].data);
+    qtb_free(column->allocator, column->chunks[column->n_chunks].validity);
+  }
+
+  qtb_arena_shrink_to_fit(&column->arena);
+
+  tail_capacity = qtb_column_tail_capacity(column);
+  tail_rows = MAX(column->size - (n_chunks - 1) * QTB_COLUMN_CHUNK_SIZE, 1);
+  if (tail_rows == tail_capacity) return ResultSuccess();
+
+  // realloc leaves a block untouched when it fails, so both buffers hold at
+  // least tail_rows rows whether or not the shrink went through.
+  result = qtb_column_resize_chunk(column, &column->chunks[n_chunks - 1], tail_rows);
+  column->capacity -= tail_capacity - tail_rows;
+
+  return result;
+}
+
+static void qtb_column_set_valid(QtbColumn *column, size_t i, bool valid) {
+  uint64_t *word;
+  uint64_t bit;
+
+  word = &qtb_column_validity_word(column, i);
+  bit = qtb_column_bit_of(i);
+
+  if (valid) *word |= bit;
+  else *word &= ~bit;
+}
+
+// Null cells are zeroed so that their contents are deterministic for code
+// that scans data without consulting the validity bitmap.
+static void qtb_column_append_null(QtbColumn *column) {
+  size_t cell_size;
+  char *data;
+
+  if (column->type == QTB_COLUMN_TYPE_BOOL) {
+    qtb_column_bool_word(column, column->size) &= ~qtb_column_bit_of(column->size);
+    return;
+  }
+
+  cell_size = qtb_column_data_size(column->type, 1);
+  data = (char *)column->chunks[qtb_column_chunk_of(column->size)].data;
+  memset(&data[qtb_column_offset_of(column->size) * cell_size], 0, cell_size);
+}
+
 Result qtb_column_append(QtbColumn *column, PyObject *item) {
   Result result;
+  bool is_null;
 
   if (column->capacity == column->size) {
     result = qtb_column_grow(column);
     if (ResultFailed(result)) return result;
   }
 
-  result = column->append(column, item);
+  is_null = column->nullable && item == Py_None;
+
+  if (is_null) {
+    qtb_column_append_null(column);
+  } else {
+    result = column->append(column, item);
+    if (ResultFailed(result)) return result;
+  }
+
+  if (column->nullable) qtb_column_set_valid(column, column->size, !is_null);
+
+  column->size++;
+  return ResultSuccess();
+}
+
+// Like qtb_column_append for a cell given as text, e.g. a CSV field. Does not
+// call into Python, so it may run with the GIL released.
+Result qtb_column_append_string(QtbColumn *column, const char *s, size_t size) {
+  Result result;
+
+  if (column->capacity == column->size) {
+    result = qtb_column_grow(column);
+    if (ResultFailed(result)) return result;
+  }
+
+  result = column->append_string(column, s, size);
   if (ResultFailed(result)) return result;
 
+  if (column->nullable) qtb_column_set_valid(column, column->size, true);
+
+  column->size++;
+  return ResultSuccess();
+}
+
+// Appends a null to a nullable column without going through Py_None.
+Result qtb_column_append_none(QtbColumn *column) {
+  Result result;
+
+  if (column->capacity == column->size) {
+    result = qtb_column_grow(column);
+    if (ResultFailed(result)) return result;
+  }
+
+  qtb_column_append_null(column);
+  qtb_column_set_valid(column, column->size, false);
+
   column->size++;
   return ResultSuccess();
 }
 
+// Takes rows [size, size + n), whose cells have already been written, into
+// the column. valid is an Arrow style bitmap read from bit offset on, or NULL
+// when every row is valid; null cells are zeroed like appended ones.
+void qtb_column_commit_rows(QtbColumn *column, size_t n, const uint8_t *valid, size_t offset) {
+  bool is_valid;
+
+  if (!column->nullable) {
+    column->size += n;
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    is_valid = valid == NULL || ((valid[(offset + i) / 8] >> ((offset + i) % 8)) & 1) != 0;
+    if (!is_valid) qtb_column_append_null(column);
+
+    qtb_column_set_valid(column, column->size, is_valid);
+    column->size++;
+  }
+}
+
+// Appends every element of a one-dimensional buffer, e.g. an array.array
+// or NumPy array. Nothing is appended when this fails.
+Result qtb_column_append_buffer(QtbColumn *column, Py_buffer *view) {
+  QtbBuffer buffer;
+  Result result;
+
+  if (column->append_buffer == NULL) return ResultFailure(PyExc_TypeError, "buffer for non-numeric column");
+
+  buffer = qtb_buffer_from_view(view);
+  if (buffer.kind == QTB_BUFFER_UNSUPPORTED) return ResultFailure(PyExc_TypeError, "unsupported buffer format");
+
+  result = qtb_column_reserve(column, column->size + buffer.n);
+  if (ResultFailed(result)) return result;
+
+  result = column->append_buffer(column, &buffer);
+  if (ResultFailed(result)) return result;
+
+  if (column->nullable)
+    for (size_t i = 0; i < buffer.n; i++)
+      qtb_column_set_valid(column, column->size + i, true);
+
+  column->size += buffer.n;
+  return ResultSuccess();
+}
+
+// The rows of other that qtb_column_append_rows and qtb_column_append_taken
+// copy: start, start + step, ... or, when taken is not NULL, taken[0],
+// taken[1], ...
+typedef struct {
+  size_t start;
+  Py_ssize_t step;
+  const size_t *taken;
+} QtbColumnRows;
+
+static inline size_t qtb_column_row_of(const QtbColumnRows *rows, size_t j) {
+  if (rows->taken != NULL) return rows->taken[j];
+  return (size_t)((Py_ssize_t)rows->start + (Py_ssize_t)j * rows->step);
+}
+
+// Copies fixed-width cells. Contiguous rows are copied in runs that stop at
+// whichever chunk boundary, source or destination, comes first; other rows
+// are gathered one cell at a time, with a loop per cell size so the copies
+// compile to single loads and stores.
+static void qtb_column_copy_cells(QtbColumn *column, QtbColumn *other, const QtbColumnRows *rows, size_t n_rows) {
+  size_t cell_size;
+  size_t at;
+  size_t i;
+  size_t n;
+  char *to;
+  char *from;
+
+  cell_size = qtb_column_data_size(column->type, 1);
+
+  if (rows->taken != NULL || rows->step != 1) {
+    for (size_t j = 0; j < n_rows; j += n) {
+      at = column->size + j;
+      n = MIN(QTB_COLUMN_CHUNK_SIZE - qtb_column_offset_of(at), n_rows - j);
+      to = (char *)column->chunks[qtb_column_chunk_of(at)].data + qtb_column_offset_of(at) * cell_size;
+
+      switch (cell_size) {
+        case 1:
+          for (size_t k = 0; k < n; k++) memcpy(&to[k], qtb_column_read_cell(other, qtb_column_row_of(rows, j + k), 1), 1);
+          break;
+        case 2:
+          for (size_t k = 0; k < n; k++) memcpy(&to[2 * k], qtb_column_read_cell(other, qtb_column_row_of(rows, j + k), 2), 2);
+          break;
+        case 4:
+          for (size_t k = 0; k < n; k++) memcpy(&to[4 * k], qtb_column_read_cell(other, qtb_column_row_of(rows, j + k), 4), 4);
+          break;
+        default:
+          for (size_t k = 0; k < n; k++) memcpy(&to[8 * k], qtb_column_read_cell(other, qtb_column_row_of(rows, j + k), 8), 8);
+          break;
+      }
+    }
+
+    column->size += n_rows;
+    return;
+  }
+
+  for (size_t j = 0; j < n_rows; j += n) {
+    at = column->size + j;
+    i = rows->start + j;
+    n = MIN(QTB_COLUMN_CHUNK_SIZE - qtb_column_offset_of(at), QTB_COLUMN_CHUNK_SIZE - qtb_column_offset_of(i));
+    n = MIN(n, n_rows - j);
+
+    to = (char *)column->chunks[qtb_column_chunk_of(at)].data + qtb_column_offset_of(at) * cell_size;
+    if (other->chunks[qtb_column_chunk_of(i)].encoded == NULL) {
+      from = (char *)other->chunks[qtb_column_chunk_of(i)].data + qtb_column_offset_of(i) * cell_size;
+      memcpy(to, from, n * cell_size);
+    } else {
+      for (size_t k = 0; k < n; k++)
+        memcpy(&to[k * cell_size], qtb_column_read_cell(other, i + k, cell_size), cell_size);
+    }
+  }
+
+  column->size += n_rows;
+}
+
+static void qtb_column_copy_bools(QtbColumn *column, QtbColumn *other, const QtbColumnRows *rows, size_t n_rows) {
+  uint64_t *word;
+  uint64_t bit;
+
+  for (size_t j = 0; j < n_rows; j++) {
+    word = &qtb_column_bool_word(column, column->size);
+    bit = qtb_column_bit_of(column->size);
+
+    if (qtb_column_bool_at(other, qtb_column_row_of(rows, j))) *word |= bit;
+    else *word &= ~bit;
+
+    column->size++;
+  }
+}
+
+// Long strings are re-stored in this column's arena. Rows copied before a
+// failure are popped again.
+static Result qtb_column_copy_strs(QtbColumn *column, QtbColumn *other, const QtbColumnRows *rows, size_t n_rows) {
+  size_t first;
+  size_t i;
+  Result result;
+
+  first = column->size;
+  for (size_t j = 0; j < n_rows; j++) {
+    i = qtb_column_row_of(rows, j);
+    if (qtb_column_is_valid(other, i)) {
+      result = qtb_column_store_str(column, qtb_column_str_at(other, i), qtb_column_str_size_at(other, i));
+      if (ResultFailed(result)) {
+        while (column->size > first) qtb_column_pop(column);
+        return result;
+      }
+    } else {
+      qtb_column_append_null(column);
+    }
+
+    column->size++;
+  }
+
+  return ResultSuccess();
+}
+
+// Codes are translated by interning each of the other dictionary's values
+// once. Values interned before a failure stay in the dictionary unused.
+static Result qtb_column_copy_codes(QtbColumn *column, QtbColumn *other, const QtbColumnRows *rows, size_t n_rows) {
+  QtbDictionary *dictionary;
+  uint32_t *codes;
+  ResultSize_t code;
+  size_t i;
+
+  dictionary = &other->dictionary;
+  codes = (uint32_t *)column->malloc(MAX(dictionary->size, 1) * sizeof(uint32_t));
+  if (codes == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow column");
+
+  for (size_t k = 0; k < dictionary->size; k++) {
+    code = qtb_dictionary_intern(&column->dictionary, qtb_dictionary_value_at(dictionary, k), qtb_dictionary_value_size_at(dictionary, k));
+    if (ResultFailed(code)) {
+      free(codes);
+      return ResultFailureFromResult(code);
+    }
+
+    codes[k] = (uint32_t)ResultValue(code);
+  }
+
+  for (size_t j = 0; j < n_rows; j++) {
+    i = qtb_column_row_of(rows, j);
+    qtb_column_cell(column, uint32_t, column->size) = qtb_column_is_valid(other, i) ? codes[qtb_column_code_at(other, i)] : 0;
+    column->size++;
+  }
+
+  free(codes);
+  return ResultSuccess();
+}
+
+static Result qtb_column_copy_rows(QtbColumn *column, QtbColumn *other, const QtbColumnRows *rows, size_t n) {
+  Result result;
+
+  result = qtb_column_reserve(column, column->size + n);
+  if (ResultFailed(result)) return result;
+
+  if (column->nullable)
+    for (size_t j = 0; j < n; j++)
+      qtb_column_set_valid(column, column->size + j, qtb_column_is_valid(other, qtb_column_row_of(rows, j)));
+
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_STR:
+      return qtb_column_copy_strs(column, other, rows, n);
+    case QTB_COLUMN_TYPE_CATEGORY:
+      return qtb_column_copy_codes(column, other, rows, n);
+    case QTB_COLUMN_TYPE_BOOL:
+      qtb_column_copy_bools(column, other, rows, n);
+      return ResultSuccess();
+    default:
+      qtb_column_copy_cells(column, other, rows, n);
+      return ResultSuccess();
+  }
+}
+
+// Appends every row of other, a column of the same type. Nothing is appended
+// when this fails. Does not call into Python.
+Result qtb_column_append_column(QtbColumn *column, QtbColumn *other) {
+  return qtb_column_append_rows(column, other, 0, 1, other->size);
+}
+
+// Appends n rows of other, a column of the same type, starting at row start
+// and step rows apart; step may be negative. As with append_column, nothing
+// is appended when this fails.
+Result qtb_column_append_rows(QtbColumn *column, QtbColumn *other, size_t start, Py_ssize_t step, size_t n) {
+  QtbColumnRows rows = {start, step, NULL};
+
+  return qtb_column_copy_rows(column, other, &rows, n);
+}
+
+// Appends rows taken[0], ..., taken[n - 1] of other, a column of the same
+// type, in that order; rows may repeat. As with append_column, nothing is
+// appended when this fails.
+Result qtb_column_append_taken(QtbColumn *column, QtbColumn *other, const size_t *taken, size_t n) {
+  QtbColumnRows rows = {0, 1, taken};
+
+  return qtb_column_copy_rows(column, other, &rows, n);
+}
+
+void qtb_column_pop(QtbColumn *column) {
+  column->size--;
+  if (qtb_column_is_valid(column, column->size)) column->pop(column);
+}
+
 const char *qtb_column_type_as_string(QtbColumn *column) {
-  return column->type_as_string();
+  return column->type_as_string(column->nullable);
 }
 
+static const struct {
+  const char *name;
+  QtbColumnType type;
+} qtb_column_type_names[] = {
+  {"str", QTB_COLUMN_TYPE_STR},
+  {"int", QTB_COLUMN_TYPE_INT},
+  {"float", QTB_COLUMN_TYPE_FLOAT},
+  {"bool", QTB_COLUMN_TYPE_BOOL},
+  {"category", QTB_COLUMN_TYPE_CATEGORY},
+  {"int8", QTB_COLUMN_TYPE_INT8},
+  {"int16", QTB_COLUMN_TYPE_INT16},
+  {"int32", QTB_COLUMN_TYPE_INT32},
+  {"uint8", QTB_COLUMN_TYPE_UINT8},
+  {"uint16", QTB_COLUMN_TYPE_UINT16},
+  {"uint32", QTB_COLUMN_TYPE_UINT32},
+  {"uint64", QTB_COLUMN_TYPE_UINT64},
+  {"float32", QTB_COLUMN_TYPE_FLOAT32},
+};
+
 static Result qtb_column_type_init(QtbColumn *column, PyObject *type) {
-  if (PyUnicode_CompareWithASCIIString(type, "str") == 0)
-    column->type = QTB_COLUMN_TYPE_STR;
-  else if (PyUnicode_CompareWithASCIIString(type, "int") == 0)
-    column->type = QTB_COLUMN_TYPE_INT;
-  else if (PyUnicode_CompareWithASCIIString(type, "float") == 0)
-    column->type = QTB_COLUMN_TYPE_FLOAT;
-  else if (PyUnicode_CompareWithASCIIString(type, "bool") == 0)
-    column->type = QTB_COLUMN_TYPE_BOOL;
-  else {
-    return ResultFailure(PyExc_RuntimeError, "invalid column type");
+  const char *type_s;
+  Py_ssize_t size;
+
+  type_s = column->PyUnicode_AsUTF8AndSize(type, &size);
+  if (type_s == NULL) return ResultFailureFromPyErr();
+
+  // A trailing '?' marks the nullable variant of a type, e.g. 'int?'.
+  column->nullable = size > 0 && type_s[size - 1] == '?';
+  if (column->nullable) size--;
+
+  for (size_t i = 0; i < sizeof(qtb_column_type_names) / sizeof(qtb_column_type_names[0]); i++) {
+    if (strlen(qtb_column_type_names[i].name) == (size_t)size && strncmp(qtb_column_type_names[i].name, type_s, size) == 0) {
+      column->type = qtb_column_type_names[i].type;
+      return ResultSuccess();
+    }
   }
 
-  return ResultSuccess();
+  return ResultFailure(PyExc_RuntimeError, "invalid column type");
+}
+
+static size_t qtb_column_cells_size(QtbColumn *column, size_t rows) {
+  size_t size;
+
+  size = qtb_column_data_size(column->type, rows);
+  if (column->nullable) size += qtb_column_validity_size(rows);
+
+  return size;
+}
+
+QtbColumnMemoryUsage qtb_column_memory_usage(QtbColumn *column) {
+  QtbColumnMemoryUsage usage;
+  QtbDictionary *dictionary;
+
+  usage.used = qtb_column_chunk_of(column->size) * qtb_column_cells_size(column, QTB_COLUMN_CHUNK_SIZE);
+  usage.used += qtb_column_cells_size(column, qtb_column_offset_of(column->size));
+
+  usage.reserved = 0;
+  if (column->n_chunks > 0) {
+    usage.reserved = (column->n_chunks - 1) * qtb_column_cells_size(column, QTB_COLUMN_CHUNK_SIZE);
+    usage.reserved += qtb_column_cells_size(column, qtb_column_tail_capacity(column));
+  }
+
+  // Compressed chunks are always full ones.
+  for (size_t i = 0; i < column->n_chunks; i++) {
+    if (column->chunks[i].encoded == NULL) continue;
+
+    usage.used -= qtb_column_data_size(column->type, QTB_COLUMN_CHUNK_SIZE) - column->chunks[i].encoded->size;
+    usage.reserved -= qtb_column_data_size(column->type, QTB_COLUMN_CHUNK_SIZE) - column->chunks[i].encoded->size;
+  }
+
+  dictionary = &column->dictionary;
+  usage.strings = column->arena.reserved + dictionary->arena.reserved;
+
+  usage.overhead = sizeof(QtbColumn);
+  usage.overhead += column->name == NULL ? 0 : strlen(column->name) + 1;
+  usage.overhead += column->chunks_capacity * sizeof(QtbColumnChunk);
+  usage.overhead += column->arena.n_blocks * sizeof(char *);
+  usage.overhead += dictionary->arena.n_blocks * sizeof(char *);
+  usage.overhead += dictionary->capacity * (sizeof(QtbDictionaryEntry) + sizeof(PyObject *));
+  usage.overhead += dictionary->n_slots * sizeof(uint32_t);
+  usage.overhead += column->decoded == NULL ? 0 : QTB_ENCODING_BLOCK_SIZE * sizeof(uint64_t);
+
+  return usage;
+}
+
+// Must be called before the column is initialised.
+void qtb_column_use_allocator(QtbColumn *column, QtbAllocator *allocator) {
+  column->allocator = allocator;
+  qtb_arena_new(&column->arena, allocator);
+  qtb_dictionary_new(&column->dictionary, allocator);
 }
 
 ResultQtbColumnPtr _qtb_column_new_many(size_t n, mallocer m) {
@@ -189,12 +1097,18 @@ ResultQtbColumnPtr _qtb_column_new_many(size_t n, mallocer m) {
   for (size_t i = 0; i < n; i++) {
     columns[i].strdup = &strdup;
     columns[i].malloc = &malloc;
-    columns[i].realloc = &realloc;
     columns[i].snprintf_ = &snprintf;
     columns[i].PyTuple_New = &PyTuple_New;
-    columns[i].PyUnicode_AsUTF8 = &PyUnicode_AsUTF8;
+    columns[i].PyUnicode_AsUTF8AndSize = &PyUnicode_AsUTF8AndSize;
     columns[i].name = NULL;
-    columns[i].data = NULL;
+    columns[i].nullable = false;
+    columns[i].chunks = NULL;
+    columns[i].n_chunks = 0;
+    columns[i].chunks_capacity = 0;
+    columns[i].capacity = 0;
+    columns[i].decoded = NULL;
+    columns[i].decoded_block = SIZE_MAX;
+    qtb_column_use_allocator(&columns[i], &qtb_allocator_default);
   }
 
   return ResultQtbColumnPtrSuccess(columns);
@@ -203,8 +1117,8 @@ ResultQtbColumnPtr _qtb_column_new_many(size_t n, mallocer m) {
 static Result qtb_column_init_name(QtbColumn *column, PyObject *name) {
   const char *name_s;
 
-  name_s = column->PyUnicode_AsUTF8(name);
-  if (name == NULL) return ResultFailureFromPyErr();
+  name_s = column->PyUnicode_AsUTF8AndSize(name, NULL);
+  if (name_s == NULL) return ResultFailureFromPyErr();
 
   column->name = column->strdup(name_s);
   if (column->name == NULL) return ResultFailure(PyExc_MemoryError, "failed to initialise column");
@@ -217,7 +1131,6 @@ Result qtb_column_init(QtbColumn *column, PyObject *descriptor) {
   Result result;
 
   column->size = 0;
-  column->capacity = QTB_COLUMN_INITIAL_CAPACITY;
 
   fast_descriptor = PySequence_Fast(descriptor, "descriptor not a sequence");
   if (fast_descriptor == NULL) return ResultFailureFromPyErr();
@@ -236,9 +1149,32 @@ Result qtb_column_init(QtbColumn *column, PyObject *descriptor) {
     return result;
   }
 
-  column->data = (QtbColumnData *)malloc(sizeof(QtbColumnData) * QTB_COLUMN_INITIAL_CAPACITY);
+  result = qtb_column_add_chunk(column, QTB_COLUMN_INITIAL_CAPACITY);
   Py_DECREF(fast_descriptor);
-  if (column->data == NULL) {
+  if (ResultFailed(result)) {
+    qtb_column_dealloc(column);
+    return ResultFailure(PyExc_MemoryError, "failed to initialise column");
+  }
+
+  qtb_column_init_methods(column);
+  return ResultSuccess();
+}
+
+// Initialises an empty column with the name and type of like, without
+// going through a descriptor, so that it may run with the GIL released.
+Result qtb_column_init_like(QtbColumn *column, QtbColumn *like) {
+  Result result;
+
+  column->size = 0;
+
+  column->name = column->strdup(like->name);
+  if (column->name == NULL) return ResultFailure(PyExc_MemoryError, "failed to initialise column");
+
+  column->type = like->type;
+  column->nullable = like->nullable;
+
+  result = qtb_column_add_chunk(column, QTB_COLUMN_INITIAL_CAPACITY);
+  if (ResultFailed(result)) {
     qtb_column_dealloc(column);
     return ResultFailure(PyExc_MemoryError, "failed to initialise column");
   }
@@ -259,7 +1195,7 @@ Result qtb_column_init_many(QtbColumn *columns, PyObject *blueprint, Py_ssize_t
     result = qtb_column_init(&columns[i], PySequence_Fast_GET_ITEM(fast_blueprint, i));
     if (ResultFailed(result)) {
       Py_DECREF(fast_blueprint);
-      for (Py_ssize_t j = i - 1; i >= 0; i--)
+      for (Py_ssize_t j = i - 1; j >= 0; j--)
         qtb_column_dealloc(&columns[j]);
       return result;
     }
@@ -275,8 +1211,24 @@ void qtb_column_dealloc(QtbColumn *column) {
 
   if (column->size > 0) column->dealloc(column);
 
-  free(column->data);
-  column->data = NULL;
+  for (size_t i = 0; i < column->n_chunks; i++) {
+    qtb_free(column->allocator, column->chunks[i].data);
+    qtb_free(column->allocator, column->chunks[i].validity);
+    qtb_encoding_free(column->allocator, column->chunks[i].encoded);
+  }
+
+  qtb_free(column->allocator, column->chunks);
+  column->chunks = NULL;
+  column->n_chunks = 0;
+  column->chunks_capacity = 0;
+  column->capacity = 0;
+
+  qtb_free(column->allocator, column->decoded);
+  column->decoded = NULL;
+  column->decoded_block = SIZE_MAX;
+
+  qtb_arena_dealloc(&column->arena);
+  qtb_dictionary_dealloc(&column->dictionary);
 }
 
 ResultPyObjectPtr qtb_column_as_descriptor(QtbColumn *column) {
@@ -308,6 +1260,14 @@ ResultPyObjectPtr qtb_column_as_descriptor(QtbColumn *column) {
 }
 
 ResultCharPtr qtb_column_cell_as_string(QtbColumn *column, size_t i) {
+  char *string;
+
+  if (!qtb_column_is_valid(column, i)) {
+    string = column->strdup("None");
+    if (string == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
+    return ResultCharPtrSuccess(string);
+  }
+
   return column->cell_as_string(column, i);
 }
 
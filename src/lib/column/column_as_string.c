@@ -1,26 +1,33 @@
 #include <stdlib.h>
 #include "column_as_string.h"
 
-ResultCharPtr qtb_column_str_cell_as_string(QtbColumn *column, size_t i) {
+static ResultCharPtr qtb_column_bytes_as_string(QtbColumn *column, const char *s, size_t size) {
   char *copy;
 
-  copy = column->strdup(column->data[i].s);
+  copy = (char *)column->malloc(sizeof(char) * (size + 1));
   if (copy == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
 
+  memcpy(copy, s, size);
+  copy[size] = '\0';
+
   return ResultCharPtrSuccess(copy);
 }
 
-ResultCharPtr qtb_column_int_cell_as_string(QtbColumn *column, size_t i) {
+ResultCharPtr qtb_column_str_cell_as_string(QtbColumn *column, size_t i) {
+  return qtb_column_bytes_as_string(column, qtb_column_str_at(column, i), qtb_column_str_size_at(column, i));
+}
+
+static ResultCharPtr qtb_column_signed_as_string(QtbColumn *column, long long value) {
   char *string;
   int size;
 
-  size = column->snprintf_(NULL, 0, "%lld", column->data[i].i);
+  size = column->snprintf_(NULL, 0, "%lld", value);
   if (size < 0) return ResultCharPtrFailure(PyExc_RuntimeError, "failed to get string length of cell");
 
   string = (char *)column->malloc(sizeof(char) * (size + 1));
   if (string == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
 
-  if (column->snprintf_(string, size + 1, "%lld", column->data[i].i) != size) {
+  if (column->snprintf_(string, size + 1, "%lld", value) != size) {
     free(string);
     return ResultCharPtrFailure(PyExc_RuntimeError, "failed to write cell as string");
   }
@@ -28,17 +35,17 @@ ResultCharPtr qtb_column_int_cell_as_string(QtbColumn *column, size_t i) {
   return ResultCharPtrSuccess(string);
 }
 
-ResultCharPtr qtb_column_float_cell_as_string(QtbColumn *column, size_t i) {
+static ResultCharPtr qtb_column_unsigned_as_string(QtbColumn *column, unsigned long long value) {
   char *string;
   int size;
 
-  size = column->snprintf_(NULL, 0, "%.2f", column->data[i].f);
+  size = column->snprintf_(NULL, 0, "%llu", value);
   if (size < 0) return ResultCharPtrFailure(PyExc_RuntimeError, "failed to get string length of cell");
 
   string = (char *)column->malloc(sizeof(char) * (size + 1));
   if (string == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
 
-  if (column->snprintf_(string, size + 1, "%.2f", column->data[i].f) != size) {
+  if (column->snprintf_(string, size + 1, "%llu", value) != size) {
     free(string);
     return ResultCharPtrFailure(PyExc_RuntimeError, "failed to write cell as string");
   }
@@ -46,31 +53,100 @@ ResultCharPtr qtb_column_float_cell_as_string(QtbColumn *column, size_t i) {
   return ResultCharPtrSuccess(string);
 }
 
+static ResultCharPtr qtb_column_double_as_string(QtbColumn *column, double value) {
+  char *string;
+  int size;
+
+  size = column->snprintf_(NULL, 0, "%.2f", value);
+  if (size < 0) return ResultCharPtrFailure(PyExc_RuntimeError, "failed to get string length of cell");
+
+  string = (char *)column->malloc(sizeof(char) * (size + 1));
+  if (string == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
+
+  if (column->snprintf_(string, size + 1, "%.2f", value) != size) {
+    free(string);
+    return ResultCharPtrFailure(PyExc_RuntimeError, "failed to write cell as string");
+  }
+
+  return ResultCharPtrSuccess(string);
+}
+
+ResultCharPtr qtb_column_int_cell_as_string(QtbColumn *column, size_t i) {
+  return qtb_column_signed_as_string(column, qtb_column_int_at(column, i));
+}
+
+ResultCharPtr qtb_column_float_cell_as_string(QtbColumn *column, size_t i) {
+  return qtb_column_double_as_string(column, qtb_column_float_at(column, i));
+}
+
+#define QTB_COLUMN_DEFINE_CELL_AS_STRING(name, ctype, as_string) \
+  ResultCharPtr qtb_column_##name##_cell_as_string(QtbColumn *column, size_t i) { \
+    return as_string(column, qtb_column_value_at(column, ctype, i)); \
+  }
+
+QTB_COLUMN_DEFINE_CELL_AS_STRING(int8, int8_t, qtb_column_signed_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(int16, int16_t, qtb_column_signed_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(int32, int32_t, qtb_column_signed_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(uint8, uint8_t, qtb_column_unsigned_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(uint16, uint16_t, qtb_column_unsigned_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(uint32, uint32_t, qtb_column_unsigned_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(uint64, uint64_t, qtb_column_unsigned_as_string)
+QTB_COLUMN_DEFINE_CELL_AS_STRING(float32, float, qtb_column_double_as_string)
+
 ResultCharPtr qtb_column_bool_cell_as_string(QtbColumn *column, size_t i) {
   char *string;
 
-  string = column->strdup(column->data[i].b ? "True" : "False");
+  string = column->strdup(qtb_column_bool_at(column, i) ? "True" : "False");
   if (string == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
 
   return ResultCharPtrSuccess(string);
 }
 
-const char *qtb_column_str_type_as_string() {
-  return "str";
+ResultCharPtr qtb_column_category_cell_as_string(QtbColumn *column, size_t i) {
+  uint32_t code;
+
+  code = qtb_column_code_at(column, i);
+  return qtb_column_bytes_as_string(
+    column,
+    qtb_dictionary_value_at(&column->dictionary, code),
+    qtb_dictionary_value_size_at(&column->dictionary, code)
+  );
 }
 
-const char *qtb_column_int_type_as_string() {
-  return "int";
+const char *qtb_column_str_type_as_string(bool nullable) {
+  return nullable ? "str?" : "str";
 }
 
-const char *qtb_column_float_type_as_string() {
-  return "float";
+const char *qtb_column_int_type_as_string(bool nullable) {
+  return nullable ? "int?" : "int";
 }
 
-const char *qtb_column_bool_type_as_string() {
-  return "bool";
+const char *qtb_column_float_type_as_string(bool nullable) {
+  return nullable ? "float?" : "float";
 }
 
+const char *qtb_column_bool_type_as_string(bool nullable) {
+  return nullable ? "bool?" : "bool";
+}
+
+const char *qtb_column_category_type_as_string(bool nullable) {
+  return nullable ? "category?" : "category";
+}
+
+#define QTB_COLUMN_DEFINE_TYPE_AS_STRING(name) \
+  const char *qtb_column_##name##_type_as_string(bool nullable) { \
+    return nullable ? #name "?" : #name; \
+  }
+
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(int8)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(int16)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(int32)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(uint8)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(uint16)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(uint32)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(uint64)
+QTB_COLUMN_DEFINE_TYPE_AS_STRING(float32)
+
 ResultCharPtr qtb_column_header_as_string_(QtbColumn *column) {
   int size;
   char *string;
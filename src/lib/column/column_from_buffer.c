@@ -0,0 +1,239 @@
+#include <float.h>
+#include <math.h>
+#include "column_from_buffer.h"
+
+#if PY_LITTLE_ENDIAN
+#define QTB_BUFFER_NATIVE_ORDER(c) ((c) == '<')
+#else
+#define QTB_BUFFER_NATIVE_ORDER(c) ((c) == '>' || (c) == '!')
+#endif
+
+// Only single native-order element formats are supported, e.g. 'q', '<d' or
+// '?', whatever the exporter, be it array.array, memoryview or NumPy.
+QtbBuffer qtb_buffer_from_view(Py_buffer *view) {
+  QtbBuffer buffer;
+  const char *format;
+
+  buffer.data = (const char *)view->buf;
+  buffer.itemsize = (size_t)view->itemsize;
+  buffer.n = buffer.itemsize > 0 ? (size_t)view->len / buffer.itemsize : 0;
+  buffer.kind = QTB_BUFFER_UNSUPPORTED;
+
+  format = view->format == NULL ? "B" : view->format;
+  if (*format == '@' || *format == '=' || QTB_BUFFER_NATIVE_ORDER(*format)) format++;
+  if (format[0] == '\0' || format[1] != '\0') return buffer;
+
+  switch (format[0]) {
+    case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+      if (buffer.itemsize == 1 || buffer.itemsize == 2 || buffer.itemsize == 4 || buffer.itemsize == 8)
+        buffer.kind = QTB_BUFFER_SIGNED;
+      break;
+    case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+      if (buffer.itemsize == 1 || buffer.itemsize == 2 || buffer.itemsize == 4 || buffer.itemsize == 8)
+        buffer.kind = QTB_BUFFER_UNSIGNED;
+      break;
+    case 'f': case 'd':
+      if (buffer.itemsize == 4 || buffer.itemsize == 8) buffer.kind = QTB_BUFFER_FLOAT;
+      break;
+    case '?':
+      if (buffer.itemsize == 1) buffer.kind = QTB_BUFFER_BOOL;
+      break;
+  }
+
+  return buffer;
+}
+
+// Elements are read with memcpy as buffers need not be aligned.
+int64_t qtb_buffer_signed_at(QtbBuffer *buffer, size_t i) {
+  const char *p = &buffer->data[i * buffer->itemsize];
+  int8_t i8;
+  int16_t i16;
+  int32_t i32;
+  int64_t i64;
+
+  switch (buffer->itemsize) {
+    case 1: memcpy(&i8, p, 1); return i8;
+    case 2: memcpy(&i16, p, 2); return i16;
+    case 4: memcpy(&i32, p, 4); return i32;
+    default: memcpy(&i64, p, 8); return i64;
+  }
+}
+
+uint64_t qtb_buffer_unsigned_at(QtbBuffer *buffer, size_t i) {
+  const char *p = &buffer->data[i * buffer->itemsize];
+  uint8_t u8;
+  uint16_t u16;
+  uint32_t u32;
+  uint64_t u64;
+
+  switch (buffer->itemsize) {
+    case 1: memcpy(&u8, p, 1); return u8;
+    case 2: memcpy(&u16, p, 2); return u16;
+    case 4: memcpy(&u32, p, 4); return u32;
+    default: memcpy(&u64, p, 8); return u64;
+  }
+}
+
+static double qtb_buffer_float_at(QtbBuffer *buffer, size_t i) {
+  const char *p = &buffer->data[i * buffer->itemsize];
+  float f;
+  double d;
+
+  if (buffer->itemsize == 4) {
+    memcpy(&f, p, 4);
+    return f;
+  }
+
+  memcpy(&d, p, 8);
+  return d;
+}
+
+static bool qtb_buffer_int_at(QtbBuffer *buffer, size_t i, int64_t min, int64_t max, int64_t *value) {
+  uint64_t u;
+
+  if (buffer->kind == QTB_BUFFER_SIGNED) {
+    *value = qtb_buffer_signed_at(buffer, i);
+    return *value >= min && *value <= max;
+  }
+
+  u = qtb_buffer_unsigned_at(buffer, i);
+  *value = (int64_t)u;
+  return u <= (uint64_t)max;
+}
+
+static bool qtb_buffer_uint_at(QtbBuffer *buffer, size_t i, uint64_t max, uint64_t *value) {
+  int64_t v;
+
+  if (buffer->kind == QTB_BUFFER_UNSIGNED) {
+    *value = qtb_buffer_unsigned_at(buffer, i);
+    return *value <= max;
+  }
+
+  v = qtb_buffer_signed_at(buffer, i);
+  *value = (uint64_t)v;
+  return v >= 0 && (uint64_t)v <= max;
+}
+
+// Copies in runs that stop at chunk boundaries.
+static void qtb_column_copy_in(QtbColumn *column, QtbBuffer *buffer, size_t cell_size) {
+  size_t at;
+  size_t n;
+
+  for (size_t i = 0; i < buffer->n; i += n) {
+    at = column->size + i;
+    n = MIN(QTB_COLUMN_CHUNK_SIZE - qtb_column_offset_of(at), buffer->n - i);
+
+    memcpy(
+      (char *)column->chunks[qtb_column_chunk_of(at)].data + qtb_column_offset_of(at) * cell_size,
+      &buffer->data[i * cell_size],
+      n * cell_size
+    );
+  }
+}
+
+#define QTB_COLUMN_DEFINE_SIGNED_APPEND_BUFFER(name, ctype, min, max) \
+  Result qtb_column_##name##_append_buffer(QtbColumn *column, QtbBuffer *buffer) { \
+    int64_t value; \
+    \
+    if (buffer->kind == QTB_BUFFER_SIGNED && buffer->itemsize == sizeof(ctype)) { \
+      qtb_column_copy_in(column, buffer, sizeof(ctype)); \
+      return ResultSuccess(); \
+    } \
+    \
+    if (buffer->kind != QTB_BUFFER_SIGNED && buffer->kind != QTB_BUFFER_UNSIGNED) \
+      return ResultFailure(PyExc_TypeError, "non-int buffer for " #name " column"); \
+    \
+    for (size_t i = 0; i < buffer->n; i++) { \
+      if (!qtb_buffer_int_at(buffer, i, min, max, &value)) \
+        return ResultFailure(PyExc_OverflowError, "int out of range for " #name " column"); \
+      qtb_column_cell(column, ctype, column->size + i) = (ctype)value; \
+    } \
+    \
+    return ResultSuccess(); \
+  }
+
+QTB_COLUMN_DEFINE_SIGNED_APPEND_BUFFER(int, int64_t, INT64_MIN, INT64_MAX)
+QTB_COLUMN_DEFINE_SIGNED_APPEND_BUFFER(int8, int8_t, INT8_MIN, INT8_MAX)
+QTB_COLUMN_DEFINE_SIGNED_APPEND_BUFFER(int16, int16_t, INT16_MIN, INT16_MAX)
+QTB_COLUMN_DEFINE_SIGNED_APPEND_BUFFER(int32, int32_t, INT32_MIN, INT32_MAX)
+
+#define QTB_COLUMN_DEFINE_UNSIGNED_APPEND_BUFFER(name, ctype, max) \
+  Result qtb_column_##name##_append_buffer(QtbColumn *column, QtbBuffer *buffer) { \
+    uint64_t value; \
+    \
+    if (buffer->kind == QTB_BUFFER_UNSIGNED && buffer->itemsize == sizeof(ctype)) { \
+      qtb_column_copy_in(column, buffer, sizeof(ctype)); \
+      return ResultSuccess(); \
+    } \
+    \
+    if (buffer->kind != QTB_BUFFER_SIGNED && buffer->kind != QTB_BUFFER_UNSIGNED) \
+      return ResultFailure(PyExc_TypeError, "non-int buffer for " #name " column"); \
+    \
+    for (size_t i = 0; i < buffer->n; i++) { \
+      if (!qtb_buffer_uint_at(buffer, i, max, &value)) \
+        return ResultFailure(PyExc_OverflowError, "int out of range for " #name " column"); \
+      qtb_column_cell(column, ctype, column->size + i) = (ctype)value; \
+    } \
+    \
+    return ResultSuccess(); \
+  }
+
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_BUFFER(uint8, uint8_t, UINT8_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_BUFFER(uint16, uint16_t, UINT16_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_BUFFER(uint32, uint32_t, UINT32_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_BUFFER(uint64, uint64_t, UINT64_MAX)
+
+Result qtb_column_float_append_buffer(QtbColumn *column, QtbBuffer *buffer) {
+  if (buffer->kind != QTB_BUFFER_FLOAT)
+    return ResultFailure(PyExc_TypeError, "non-float buffer for float column");
+
+  if (buffer->itemsize == sizeof(double)) {
+    qtb_column_copy_in(column, buffer, sizeof(double));
+    return ResultSuccess();
+  }
+
+  for (size_t i = 0; i < buffer->n; i++)
+    qtb_column_cell(column, double, column->size + i) = qtb_buffer_float_at(buffer, i);
+
+  return ResultSuccess();
+}
+
+Result qtb_column_float32_append_buffer(QtbColumn *column, QtbBuffer *buffer) {
+  double value;
+
+  if (buffer->kind != QTB_BUFFER_FLOAT)
+    return ResultFailure(PyExc_TypeError, "non-float buffer for float32 column");
+
+  if (buffer->itemsize == sizeof(float)) {
+    qtb_column_copy_in(column, buffer, sizeof(float));
+    return ResultSuccess();
+  }
+
+  for (size_t i = 0; i < buffer->n; i++) {
+    value = qtb_buffer_float_at(buffer, i);
+    if (isfinite(value) && (value > FLT_MAX || value < -FLT_MAX))
+      return ResultFailure(PyExc_OverflowError, "float out of range for float32 column");
+
+    qtb_column_cell(column, float, column->size + i) = (float)value;
+  }
+
+  return ResultSuccess();
+}
+
+Result qtb_column_bool_append_buffer(QtbColumn *column, QtbBuffer *buffer) {
+  uint64_t *word;
+  uint64_t bit;
+
+  if (buffer->kind != QTB_BUFFER_BOOL)
+    return ResultFailure(PyExc_TypeError, "non-bool buffer for bool column");
+
+  for (size_t i = 0; i < buffer->n; i++) {
+    word = &qtb_column_bool_word(column, column->size + i);
+    bit = qtb_column_bit_of(column->size + i);
+
+    if (buffer->data[i] != 0) *word |= bit;
+    else *word &= ~bit;
+  }
+
+  return ResultSuccess();
+}
@@ -0,0 +1,195 @@
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include "column_from_string.h"
+
+#define QTB_COLUMN_FLOAT_STRING_MAX 128
+
+typedef enum {
+  QTB_PARSE_OK,
+  QTB_PARSE_INVALID,
+  QTB_PARSE_OVERFLOW,
+} QtbParseStatus;
+
+// An optional sign followed by decimal digits and nothing else.
+static QtbParseStatus qtb_parse_magnitude(const char *s, size_t size, bool *negative, uint64_t *magnitude) {
+  size_t i = 0;
+  uint64_t digit;
+
+  *negative = false;
+  *magnitude = 0;
+
+  if (size > 0 && (s[0] == '-' || s[0] == '+')) {
+    *negative = s[0] == '-';
+    i = 1;
+  }
+
+  if (i == size) return QTB_PARSE_INVALID;
+
+  for (; i < size; i++) {
+    if (s[i] < '0' || s[i] > '9') return QTB_PARSE_INVALID;
+
+    digit = (uint64_t)(s[i] - '0');
+    if (*magnitude > (UINT64_MAX - digit) / 10) return QTB_PARSE_OVERFLOW;
+    *magnitude = *magnitude * 10 + digit;
+  }
+
+  return QTB_PARSE_OK;
+}
+
+static QtbParseStatus qtb_parse_signed(const char *s, size_t size, int64_t min, int64_t max, int64_t *value) {
+  QtbParseStatus status;
+  uint64_t magnitude;
+  bool negative;
+
+  status = qtb_parse_magnitude(s, size, &negative, &magnitude);
+  if (status != QTB_PARSE_OK) return status;
+
+  if (!negative) {
+    if (magnitude > (uint64_t)max) return QTB_PARSE_OVERFLOW;
+    *value = (int64_t)magnitude;
+    return QTB_PARSE_OK;
+  }
+
+  if (magnitude == 0) {
+    *value = 0;
+    return QTB_PARSE_OK;
+  }
+
+  if (magnitude - 1 > (uint64_t)(-(min + 1))) return QTB_PARSE_OVERFLOW;
+  *value = -(int64_t)(magnitude - 1) - 1;
+  return QTB_PARSE_OK;
+}
+
+static QtbParseStatus qtb_parse_unsigned(const char *s, size_t size, uint64_t max, uint64_t *value) {
+  QtbParseStatus status;
+  bool negative;
+
+  status = qtb_parse_magnitude(s, size, &negative, value);
+  if (status != QTB_PARSE_OK) return status;
+  if ((negative && *value != 0) || *value > max) return QTB_PARSE_OVERFLOW;
+
+  return QTB_PARSE_OK;
+}
+
+// strtod needs a terminated string and skips leading whitespace, which a
+// cell should not be allowed to carry.
+static bool qtb_parse_double(const char *s, size_t size, double *value) {
+  char buffer[QTB_COLUMN_FLOAT_STRING_MAX + 1];
+  char *end;
+
+  if (size == 0 || size > QTB_COLUMN_FLOAT_STRING_MAX) return false;
+  if (s[0] == ' ' || s[0] == '\t') return false;
+
+  memcpy(buffer, s, size);
+  buffer[size] = '\0';
+
+  *value = strtod(buffer, &end);
+  return end == buffer + size;
+}
+
+Result qtb_column_str_append_string(QtbColumn *column, const char *s, size_t size) {
+  return qtb_column_store_str(column, s, size);
+}
+
+#define QTB_COLUMN_DEFINE_SIGNED_APPEND_STRING(name, ctype, min, max) \
+  Result qtb_column_##name##_append_string(QtbColumn *column, const char *s, size_t size) { \
+    int64_t value; \
+    \
+    switch (qtb_parse_signed(s, size, min, max, &value)) { \
+      case QTB_PARSE_INVALID: \
+        return ResultFailure(PyExc_ValueError, "non-int entry for " #name " column"); \
+      case QTB_PARSE_OVERFLOW: \
+        return ResultFailure(PyExc_OverflowError, "int out of range for " #name " column"); \
+      case QTB_PARSE_OK: \
+        break; \
+    } \
+    \
+    qtb_column_cell(column, ctype, column->size) = (ctype)value; \
+    return ResultSuccess(); \
+  }
+
+QTB_COLUMN_DEFINE_SIGNED_APPEND_STRING(int, int64_t, INT64_MIN, INT64_MAX)
+QTB_COLUMN_DEFINE_SIGNED_APPEND_STRING(int8, int8_t, INT8_MIN, INT8_MAX)
+QTB_COLUMN_DEFINE_SIGNED_APPEND_STRING(int16, int16_t, INT16_MIN, INT16_MAX)
+QTB_COLUMN_DEFINE_SIGNED_APPEND_STRING(int32, int32_t, INT32_MIN, INT32_MAX)
+
+#define QTB_COLUMN_DEFINE_UNSIGNED_APPEND_STRING(name, ctype, max) \
+  Result qtb_column_##name##_append_string(QtbColumn *column, const char *s, size_t size) { \
+    uint64_t value; \
+    \
+    switch (qtb_parse_unsigned(s, size, max, &value)) { \
+      case QTB_PARSE_INVALID: \
+        return ResultFailure(PyExc_ValueError, "non-int entry for " #name " column"); \
+      case QTB_PARSE_OVERFLOW: \
+        return ResultFailure(PyExc_OverflowError, "int out of range for " #name " column"); \
+      case QTB_PARSE_OK: \
+        break; \
+    } \
+    \
+    qtb_column_cell(column, ctype, column->size) = (ctype)value; \
+    return ResultSuccess(); \
+  }
+
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_STRING(uint8, uint8_t, UINT8_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_STRING(uint16, uint16_t, UINT16_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_STRING(uint32, uint32_t, UINT32_MAX)
+QTB_COLUMN_DEFINE_UNSIGNED_APPEND_STRING(uint64, uint64_t, UINT64_MAX)
+
+Result qtb_column_float_append_string(QtbColumn *column, const char *s, size_t size) {
+  double value;
+
+  if (!qtb_parse_double(s, size, &value))
+    return ResultFailure(PyExc_ValueError, "non-float entry for float column");
+
+  qtb_column_cell(column, double, column->size) = value;
+  return ResultSuccess();
+}
+
+Result qtb_column_float32_append_string(QtbColumn *column, const char *s, size_t size) {
+  double value;
+
+  if (!qtb_parse_double(s, size, &value))
+    return ResultFailure(PyExc_ValueError, "non-float entry for float32 column");
+
+  if (isfinite(value) && (value > FLT_MAX || value < -FLT_MAX))
+    return ResultFailure(PyExc_OverflowError, "float out of range for float32 column");
+
+  qtb_column_cell(column, float, column->size) = (float)value;
+  return ResultSuccess();
+}
+
+static bool qtb_string_equals(const char *s, size_t size, const char *literal) {
+  return strlen(literal) == size && memcmp(s, literal, size) == 0;
+}
+
+Result qtb_column_bool_append_string(QtbColumn *column, const char *s, size_t size) {
+  uint64_t *word;
+  uint64_t bit;
+  bool value;
+
+  if (qtb_string_equals(s, size, "True") || qtb_string_equals(s, size, "true") || qtb_string_equals(s, size, "1"))
+    value = true;
+  else if (qtb_string_equals(s, size, "False") || qtb_string_equals(s, size, "false") || qtb_string_equals(s, size, "0"))
+    value = false;
+  else
+    return ResultFailure(PyExc_ValueError, "non-bool entry for bool column");
+
+  word = &qtb_column_bool_word(column, column->size);
+  bit = qtb_column_bit_of(column->size);
+
+  if (value) *word |= bit;
+  else *word &= ~bit;
+
+  return ResultSuccess();
+}
+
+Result qtb_column_category_append_string(QtbColumn *column, const char *s, size_t size) {
+  ResultSize_t code;
+
+  code = qtb_dictionary_intern(&column->dictionary, s, size);
+  if (ResultFailed(code)) return ResultFailureFromResult(code);
+
+  qtb_column_cell(column, uint32_t, column->size) = (uint32_t)ResultValue(code);
+  return ResultSuccess();
+}
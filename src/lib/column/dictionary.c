@@ -0,0 +1,183 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dictionary.h"
+#include "hash.h"
+#include "result.h"
+
+void qtb_dictionary_new(QtbDictionary *dictionary, QtbAllocator *allocator) {
+  dictionary->allocator = allocator;
+
+  qtb_arena_new(&dictionary->arena, allocator);
+  dictionary->entries = NULL;
+  dictionary->values = NULL;
+  dictionary->size = 0;
+  dictionary->capacity = 0;
+  dictionary->slots = NULL;
+  dictionary->n_slots = 0;
+}
+
+static bool qtb_dictionary_entry_equals(QtbDictionary *dictionary, uint32_t code, const char *s, size_t size, uint64_t hash) {
+  QtbDictionaryEntry *entry;
+
+  entry = &dictionary->entries[code];
+  return entry->hash == hash && entry->size == size && memcmp(qtb_dictionary_value_at(dictionary, code), s, size) == 0;
+}
+
+static size_t qtb_dictionary_probe(QtbDictionary *dictionary, const char *s, size_t size, uint64_t hash) {
+  size_t mask;
+  size_t i;
+
+  mask = dictionary->n_slots - 1;
+  for (i = hash & mask; dictionary->slots[i] != 0; i = (i + 1) & mask)
+    if (qtb_dictionary_entry_equals(dictionary, dictionary->slots[i] - 1, s, size, hash)) break;
+
+  return i;
+}
+
+static Result qtb_dictionary_rehash(QtbDictionary *dictionary, size_t n_slots) {
+  uint32_t *slots;
+  size_t mask;
+  size_t j;
+
+  slots = (uint32_t *)qtb_malloc(dictionary->allocator, n_slots * sizeof(uint32_t));
+  if (slots == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow dictionary");
+  memset(slots, 0, n_slots * sizeof(uint32_t));
+
+  mask = n_slots - 1;
+  for (size_t code = 0; code < dictionary->size; code++) {
+    for (j = dictionary->entries[code].hash & mask; slots[j] != 0; j = (j + 1) & mask);
+    slots[j] = code + 1;
+  }
+
+  qtb_free(dictionary->allocator, dictionary->slots);
+  dictionary->slots = slots;
+  dictionary->n_slots = n_slots;
+
+  return ResultSuccess();
+}
+
+static Result qtb_dictionary_grow(QtbDictionary *dictionary) {
+  QtbDictionaryEntry *entries;
+  PyObject **values;
+  size_t capacity;
+  Result result;
+
+  capacity = dictionary->capacity == 0 ? QTB_DICTIONARY_INITIAL_CAPACITY : 2 * dictionary->capacity;
+  if (capacity > UINT32_MAX) return ResultFailure(PyExc_OverflowError, "too many distinct category values");
+
+  entries = (QtbDictionaryEntry *)qtb_realloc(dictionary->allocator, dictionary->entries, capacity * sizeof(QtbDictionaryEntry));
+  if (entries == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow dictionary");
+  dictionary->entries = entries;
+
+  values = (PyObject **)qtb_realloc(dictionary->allocator, dictionary->values, capacity * sizeof(PyObject *));
+  if (values == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow dictionary");
+  memset(&values[dictionary->capacity], 0, (capacity - dictionary->capacity) * sizeof(PyObject *));
+  dictionary->values = values;
+
+  // Keep the table at most half full so probe sequences stay short. Adopted
+  // dictionaries need not have a power of two capacity, their slots do. The
+  // capacity only grows with the slots, or a later intern could fill them.
+  result = qtb_dictionary_rehash(dictionary, dictionary->n_slots == 0 ? 2 * capacity : 2 * dictionary->n_slots);
+  if (ResultFailed(result)) return result;
+
+  dictionary->capacity = capacity;
+  return ResultSuccess();
+}
+
+ResultSize_t qtb_dictionary_intern(QtbDictionary *dictionary, const char *s, size_t size) {
+  Result result;
+  ResultQtbArenaSlot slot;
+  uint64_t hash;
+  size_t i;
+
+  hash = qtb_hash_bytes(s, size);
+
+  if (dictionary->n_slots > 0) {
+    i = qtb_dictionary_probe(dictionary, s, size, hash);
+    if (dictionary->slots[i] != 0) return ResultSize_tSuccess(dictionary->slots[i] - 1);
+  }
+
+  if (dictionary->size == dictionary->capacity) {
+    result = qtb_dictionary_grow(dictionary);
+    if (ResultFailed(result)) return ResultSize_tFailureFromResult(result);
+  }
+
+  slot = qtb_arena_store(&dictionary->arena, s, size);
+  if (ResultFailed(slot)) return ResultSize_tFailureFromResult(slot);
+
+  dictionary->entries[dictionary->size] = (QtbDictionaryEntry){(uint32_t)size, ResultValue(slot), hash};
+  i = qtb_dictionary_probe(dictionary, s, size, hash);
+  dictionary->slots[i] = dictionary->size + 1;
+
+  return ResultSize_tSuccess(dictionary->size++);
+}
+
+Py_ssize_t qtb_dictionary_lookup(QtbDictionary *dictionary, const char *s, size_t size) {
+  size_t i;
+
+  if (dictionary->n_slots == 0) return -1;
+
+  i = qtb_dictionary_probe(dictionary, s, size, qtb_hash_bytes(s, size));
+  return (Py_ssize_t)dictionary->slots[i] - 1;
+}
+
+ResultPyObjectPtr qtb_dictionary_get_as_pyobject(QtbDictionary *dictionary, uint32_t code) {
+  PyObject *value;
+
+  value = dictionary->values[code];
+  if (value == NULL) {
+    value = PyUnicode_FromStringAndSize(qtb_dictionary_value_at(dictionary, code), qtb_dictionary_value_size_at(dictionary, code));
+    if (value == NULL) return ResultPyObjectPtrFailureFromPyErr();
+    dictionary->values[code] = value;
+  }
+
+  Py_INCREF(value);
+  return ResultPyObjectPtrSuccess(value);
+}
+
+// Takes over size entries allocated through the dictionary's allocator whose
+// values are already in its arena. The lookup table is rebuilt rather than
+// trusted, which costs one pass over the distinct values.
+Result qtb_dictionary_adopt(QtbDictionary *dictionary, QtbDictionaryEntry *entries, size_t size) {
+  PyObject **values;
+  size_t n_slots;
+
+  if (size == 0) return ResultSuccess();
+  if (size > UINT32_MAX) return ResultFailure(PyExc_OverflowError, "too many distinct category values");
+
+  values = (PyObject **)qtb_malloc(dictionary->allocator, size * sizeof(PyObject *));
+  if (values == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow dictionary");
+  memset(values, 0, size * sizeof(PyObject *));
+
+  for (n_slots = 2 * QTB_DICTIONARY_INITIAL_CAPACITY; n_slots < 2 * size; n_slots *= 2);
+
+  for (size_t i = 0; i < dictionary->size; i++)
+    Py_XDECREF(dictionary->values[i]);
+  qtb_free(dictionary->allocator, dictionary->entries);
+  qtb_free(dictionary->allocator, dictionary->values);
+
+  dictionary->entries = entries;
+  dictionary->values = values;
+  dictionary->size = size;
+  dictionary->capacity = size;
+
+  return qtb_dictionary_rehash(dictionary, n_slots);
+}
+
+void qtb_dictionary_dealloc(QtbDictionary *dictionary) {
+  for (size_t i = 0; i < dictionary->size; i++)
+    Py_XDECREF(dictionary->values[i]);
+
+  qtb_free(dictionary->allocator, dictionary->entries);
+  qtb_free(dictionary->allocator, dictionary->values);
+  qtb_free(dictionary->allocator, dictionary->slots);
+  qtb_arena_dealloc(&dictionary->arena);
+
+  dictionary->entries = NULL;
+  dictionary->values = NULL;
+  dictionary->slots = NULL;
+  dictionary->size = 0;
+  dictionary->capacity = 0;
+  dictionary->n_slots = 0;
+}
@@ -0,0 +1,299 @@
+#include <stdlib.h>
+#include <string.h>
+#include "encoding.h"
+
+#define QTB_ENCODING_SIGN ((uint64_t)1 << 63)
+
+static unsigned qtb_encoding_width(uint64_t value) {
+  return value == 0 ? 0 : 64 - (unsigned)__builtin_clzll(value);
+}
+
+// Values are packed least significant bit first and may straddle two words,
+// which must have been zeroed.
+static void qtb_encoding_pack(uint64_t *words, size_t bit, uint64_t value, unsigned bits) {
+  size_t word = bit / 64;
+  unsigned shift = bit % 64;
+
+  if (bits == 0) return;
+
+  words[word] |= value << shift;
+  if (shift + bits > 64) words[word + 1] |= value >> (64 - shift);
+}
+
+static uint64_t qtb_encoding_unpack(const uint64_t *words, size_t bit, unsigned bits) {
+  size_t word = bit / 64;
+  unsigned shift = bit % 64;
+  uint64_t value;
+
+  if (bits == 0) return 0;
+
+  value = words[word] >> shift;
+  if (shift + bits > 64) value |= words[word + 1] << (64 - shift);
+  if (bits < 64) value &= ((uint64_t)1 << bits) - 1;
+
+  return value;
+}
+
+// Cells are handled as 64-bit keys: signed values are sign-extended and then
+// biased, unsigned ones zero-extended, so that comparing keys as unsigned
+// integers orders them like the values they stand for.
+static void qtb_encoding_load_keys(QtbEncodingCells cells, const void *data, uint64_t *keys) {
+  for (size_t i = 0; i < QTB_ENCODING_BLOCK_SIZE; i++) {
+    if (cells.kind == QTB_ENCODING_KIND_SIGNED) {
+      switch (cells.cell_size) {
+        case 1: keys[i] = (uint64_t)(int64_t)((const int8_t *)data)[i]; break;
+        case 2: keys[i] = (uint64_t)(int64_t)((const int16_t *)data)[i]; break;
+        case 4: keys[i] = (uint64_t)(int64_t)((const int32_t *)data)[i]; break;
+        default: keys[i] = (uint64_t)((const int64_t *)data)[i]; break;
+      }
+      keys[i] ^= QTB_ENCODING_SIGN;
+    } else {
+      switch (cells.cell_size) {
+        case 1: keys[i] = ((const uint8_t *)data)[i]; break;
+        case 2: keys[i] = ((const uint16_t *)data)[i]; break;
+        case 4: keys[i] = ((const uint32_t *)data)[i]; break;
+        default: keys[i] = ((const uint64_t *)data)[i]; break;
+      }
+    }
+  }
+}
+
+static void qtb_encoding_store_key(QtbEncodingCells cells, void *to, size_t i, uint64_t key) {
+  if (cells.kind == QTB_ENCODING_KIND_SIGNED) key ^= QTB_ENCODING_SIGN;
+
+  switch (cells.cell_size) {
+    case 1: ((uint8_t *)to)[i] = (uint8_t)key; break;
+    case 2: ((uint16_t *)to)[i] = (uint16_t)key; break;
+    case 4: ((uint32_t *)to)[i] = (uint32_t)key; break;
+    default: ((uint64_t *)to)[i] = key; break;
+  }
+}
+
+// Returns the number of payload words used. Every encoding is costed and the
+// smallest kept; frame of reference never needs more bits than the cells
+// themselves, so no block is ever larger than it was.
+static size_t qtb_encoding_encode_keys(const uint64_t *keys, QtbEncodedBlock *block, uint64_t *words) {
+  uint64_t min = keys[0];
+  uint64_t max = keys[0];
+  int64_t min_step = INT64_MAX;
+  int64_t max_step = INT64_MIN;
+  int64_t step;
+  size_t n_runs = 1;
+  size_t cost;
+  size_t bit = 0;
+  size_t run;
+  unsigned bits;
+  unsigned delta_bits;
+
+  for (size_t i = 1; i < QTB_ENCODING_BLOCK_SIZE; i++) {
+    if (keys[i] < min) min = keys[i];
+    if (keys[i] > max) max = keys[i];
+
+    step = (int64_t)(keys[i] - keys[i - 1]);
+    if (step < min_step) min_step = step;
+    if (step > max_step) max_step = step;
+
+    if (keys[i] != keys[i - 1]) n_runs++;
+  }
+
+  bits = qtb_encoding_width(max - min);
+  delta_bits = qtb_encoding_width((uint64_t)max_step - (uint64_t)min_step);
+
+  *block = (QtbEncodedBlock){QTB_ENCODING_FRAME_OF_REFERENCE, (uint8_t)bits, 0, 0, min, 0};
+  cost = QTB_ENCODING_BLOCK_SIZE * bits;
+
+  if ((QTB_ENCODING_BLOCK_SIZE - 1) * delta_bits < cost) {
+    *block = (QtbEncodedBlock){QTB_ENCODING_DELTA, (uint8_t)delta_bits, 0, 0, keys[0], (uint64_t)min_step};
+    cost = (QTB_ENCODING_BLOCK_SIZE - 1) * delta_bits;
+  }
+
+  if (n_runs * (bits + QTB_ENCODING_RUN_BITS) < cost) {
+    *block = (QtbEncodedBlock){QTB_ENCODING_RUN_LENGTH, (uint8_t)bits, (uint16_t)n_runs, 0, min, 0};
+    cost = n_runs * (bits + QTB_ENCODING_RUN_BITS);
+  }
+
+  switch (block->encoding) {
+    case QTB_ENCODING_FRAME_OF_REFERENCE:
+      for (size_t i = 0; i < QTB_ENCODING_BLOCK_SIZE; i++, bit += bits)
+        qtb_encoding_pack(words, bit, keys[i] - min, bits);
+      break;
+    case QTB_ENCODING_DELTA:
+      for (size_t i = 1; i < QTB_ENCODING_BLOCK_SIZE; i++, bit += delta_bits)
+        qtb_encoding_pack(words, bit, keys[i] - keys[i - 1] - (uint64_t)min_step, delta_bits);
+      break;
+    case QTB_ENCODING_RUN_LENGTH:
+      // Run values first, then run lengths less one.
+      for (size_t i = 0; i < QTB_ENCODING_BLOCK_SIZE; i += run, bit += bits) {
+        for (run = 1; i + run < QTB_ENCODING_BLOCK_SIZE && keys[i + run] == keys[i]; run++);
+        qtb_encoding_pack(words, bit, keys[i] - min, bits);
+      }
+      for (size_t i = 0; i < QTB_ENCODING_BLOCK_SIZE; i += run, bit += QTB_ENCODING_RUN_BITS) {
+        for (run = 1; i + run < QTB_ENCODING_BLOCK_SIZE && keys[i + run] == keys[i]; run++);
+        qtb_encoding_pack(words, bit, run - 1, QTB_ENCODING_RUN_BITS);
+      }
+      break;
+  }
+
+  return (cost + 63) / 64;
+}
+
+static bool qtb_encoding_bit(const uint64_t *words, size_t i) {
+  return ((words[i / 64] >> (i % 64)) & 1) != 0;
+}
+
+static size_t qtb_encoding_encode_bools(const uint64_t *data, QtbEncodedBlock *block, uint64_t *words) {
+  size_t n_runs = 1;
+  size_t bit = 0;
+  size_t run;
+
+  for (size_t i = 1; i < QTB_ENCODING_BLOCK_SIZE; i++)
+    if (qtb_encoding_bit(data, i) != qtb_encoding_bit(data, i - 1)) n_runs++;
+
+  if (n_runs * QTB_ENCODING_RUN_BITS >= QTB_ENCODING_BLOCK_SIZE) {
+    *block = (QtbEncodedBlock){QTB_ENCODING_PLAIN, 1, 0, 0, 0, 0};
+    memcpy(words, data, QTB_ENCODING_BLOCK_WORDS * sizeof(uint64_t));
+    return QTB_ENCODING_BLOCK_WORDS;
+  }
+
+  *block = (QtbEncodedBlock){QTB_ENCODING_RUN_LENGTH, 1, (uint16_t)n_runs, 0, qtb_encoding_bit(data, 0), 0};
+  for (size_t i = 0; i < QTB_ENCODING_BLOCK_SIZE; i += run, bit += QTB_ENCODING_RUN_BITS) {
+    for (run = 1; i + run < QTB_ENCODING_BLOCK_SIZE && qtb_encoding_bit(data, i + run) == qtb_encoding_bit(data, i); run++);
+    qtb_encoding_pack(words, bit, run - 1, QTB_ENCODING_RUN_BITS);
+  }
+
+  return (n_runs * QTB_ENCODING_RUN_BITS + 63) / 64;
+}
+
+// Encodes n_blocks full blocks of cells. *encoded is left NULL when the
+// encoded chunk would not be smaller than the cells themselves.
+Result qtb_encoding_encode(QtbEncodingCells cells, const void *data, size_t n_blocks, QtbAllocator *allocator, QtbEncodedChunk **encoded) {
+  QtbEncodedBlock *blocks;
+  uint64_t *words;
+  uint64_t keys[QTB_ENCODING_BLOCK_SIZE];
+  size_t block_size;
+  size_t n_words = 0;
+  size_t size;
+  QtbEncodedChunk *chunk;
+
+  *encoded = NULL;
+
+  blocks = (QtbEncodedBlock *)malloc(n_blocks * sizeof(QtbEncodedBlock));
+  words = (uint64_t *)calloc(n_blocks * QTB_ENCODING_BLOCK_SIZE, sizeof(uint64_t));
+  if (blocks == NULL || words == NULL) {
+    free(blocks);
+    free(words);
+    return ResultFailure(PyExc_MemoryError, "failed to compress column");
+  }
+
+  block_size = cells.kind == QTB_ENCODING_KIND_BOOL ? QTB_ENCODING_BLOCK_WORDS * sizeof(uint64_t) : QTB_ENCODING_BLOCK_SIZE * cells.cell_size;
+
+  for (size_t b = 0; b < n_blocks; b++) {
+    if (cells.kind == QTB_ENCODING_KIND_BOOL) {
+      size = qtb_encoding_encode_bools((const uint64_t *)data + b * QTB_ENCODING_BLOCK_WORDS, &blocks[b], &words[n_words]);
+    } else {
+      qtb_encoding_load_keys(cells, (const char *)data + b * block_size, keys);
+      size = qtb_encoding_encode_keys(keys, &blocks[b], &words[n_words]);
+    }
+
+    blocks[b].offset = (uint32_t)n_words;
+    n_words += size;
+  }
+
+  size = sizeof(QtbEncodedChunk) + n_blocks * sizeof(QtbEncodedBlock) + n_words * sizeof(uint64_t);
+  if (size >= n_blocks * block_size) {
+    free(blocks);
+    free(words);
+    return ResultSuccess();
+  }
+
+  chunk = (QtbEncodedChunk *)qtb_malloc(allocator, size);
+  if (chunk == NULL) {
+    free(blocks);
+    free(words);
+    return ResultFailure(PyExc_MemoryError, "failed to compress column");
+  }
+
+  chunk->n_blocks = n_blocks;
+  chunk->size = size;
+  chunk->blocks = (QtbEncodedBlock *)(chunk + 1);
+  chunk->payload = (uint64_t *)(chunk->blocks + n_blocks);
+  memcpy(chunk->blocks, blocks, n_blocks * sizeof(QtbEncodedBlock));
+  memcpy(chunk->payload, words, n_words * sizeof(uint64_t));
+
+  free(blocks);
+  free(words);
+  *encoded = chunk;
+  return ResultSuccess();
+}
+
+static void qtb_encoding_decode_bools(const QtbEncodedBlock *block, const uint64_t *words, uint64_t *to) {
+  size_t i = 0;
+  size_t run;
+  bool value;
+
+  if (block->encoding == QTB_ENCODING_PLAIN) {
+    memcpy(to, words, QTB_ENCODING_BLOCK_WORDS * sizeof(uint64_t));
+    return;
+  }
+
+  memset(to, 0, QTB_ENCODING_BLOCK_WORDS * sizeof(uint64_t));
+  value = block->reference != 0;
+  for (size_t r = 0; r < block->n_runs; r++, value = !value) {
+    run = qtb_encoding_unpack(words, r * QTB_ENCODING_RUN_BITS, QTB_ENCODING_RUN_BITS) + 1;
+    if (value)
+      for (size_t j = i; j < i + run; j++) to[j / 64] |= (uint64_t)1 << (j % 64);
+    i += run;
+  }
+}
+
+// Writes one block's cells, or for bool cells its words, to to.
+void qtb_encoding_decode_block(QtbEncodingCells cells, const QtbEncodedChunk *encoded, size_t block, void *to) {
+  const QtbEncodedBlock *b = &encoded->blocks[block];
+  const uint64_t *words = &encoded->payload[b->offset];
+  uint64_t key;
+  size_t i = 0;
+  size_t run;
+  size_t lengths;
+
+  if (cells.kind == QTB_ENCODING_KIND_BOOL) {
+    qtb_encoding_decode_bools(b, words, (uint64_t *)to);
+    return;
+  }
+
+  switch (b->encoding) {
+    case QTB_ENCODING_FRAME_OF_REFERENCE:
+      for (i = 0; i < QTB_ENCODING_BLOCK_SIZE; i++)
+        qtb_encoding_store_key(cells, to, i, b->reference + qtb_encoding_unpack(words, i * b->bits, b->bits));
+      break;
+    case QTB_ENCODING_DELTA:
+      key = b->reference;
+      qtb_encoding_store_key(cells, to, 0, key);
+      for (i = 1; i < QTB_ENCODING_BLOCK_SIZE; i++) {
+        key += b->step + qtb_encoding_unpack(words, (i - 1) * b->bits, b->bits);
+        qtb_encoding_store_key(cells, to, i, key);
+      }
+      break;
+    case QTB_ENCODING_RUN_LENGTH:
+      lengths = (size_t)b->n_runs * b->bits;
+      for (size_t r = 0; r < b->n_runs; r++) {
+        key = b->reference + qtb_encoding_unpack(words, r * b->bits, b->bits);
+        run = qtb_encoding_unpack(words, lengths + r * QTB_ENCODING_RUN_BITS, QTB_ENCODING_RUN_BITS) + 1;
+        for (size_t j = i; j < i + run; j++) qtb_encoding_store_key(cells, to, j, key);
+        i += run;
+      }
+      break;
+  }
+}
+
+void qtb_encoding_decode(QtbEncodingCells cells, const QtbEncodedChunk *encoded, void *to) {
+  size_t block_size;
+
+  block_size = cells.kind == QTB_ENCODING_KIND_BOOL ? QTB_ENCODING_BLOCK_WORDS * sizeof(uint64_t) : QTB_ENCODING_BLOCK_SIZE * cells.cell_size;
+
+  for (size_t b = 0; b < encoded->n_blocks; b++)
+    qtb_encoding_decode_block(cells, encoded, b, (char *)to + b * block_size);
+}
+
+void qtb_encoding_free(QtbAllocator *allocator, QtbEncodedChunk *encoded) {
+  qtb_free(allocator, encoded);
+}
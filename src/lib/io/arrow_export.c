@@ -0,0 +1,557 @@
+#include <errno.h>
+#include "arrow.h"
+
+// Points empty buffers at something, as some consumers reject NULL.
+static const uint64_t qtb_arrow_empty[1] = {0};
+
+// Arrow format of each column type along with its cell width in bits. bool
+// cells and validity bitmaps are words of little-endian bits, which is
+// Arrow's bitmap layout on little-endian hosts. category cells are exported
+// as int32 indices into a utf8 dictionary.
+static const char *qtb_arrow_format(QtbColumnType type, size_t *bits) {
+  switch (type) {
+    case QTB_COLUMN_TYPE_STR: *bits = 0; return "u";
+    case QTB_COLUMN_TYPE_INT: *bits = 64; return "l";
+    case QTB_COLUMN_TYPE_FLOAT: *bits = 64; return "g";
+    case QTB_COLUMN_TYPE_BOOL: *bits = 1; return "b";
+    case QTB_COLUMN_TYPE_CATEGORY: *bits = 32; return "i";
+    case QTB_COLUMN_TYPE_INT8: *bits = 8; return "c";
+    case QTB_COLUMN_TYPE_INT16: *bits = 16; return "s";
+    case QTB_COLUMN_TYPE_INT32: *bits = 32; return "i";
+    case QTB_COLUMN_TYPE_UINT8: *bits = 8; return "C";
+    case QTB_COLUMN_TYPE_UINT16: *bits = 16; return "S";
+    case QTB_COLUMN_TYPE_UINT32: *bits = 32; return "I";
+    case QTB_COLUMN_TYPE_UINT64: *bits = 64; return "L";
+    case QTB_COLUMN_TYPE_FLOAT32: *bits = 32; return "f";
+  }
+
+  *bits = 0;
+  return NULL;
+}
+
+// ===== schemas =====
+
+typedef struct {
+  char *name;
+  struct ArrowSchema **children;
+  int64_t n_children;
+  struct ArrowSchema *dictionary;
+} QtbArrowSchemaPrivate;
+
+static void qtb_arrow_schema_release(struct ArrowSchema *schema) {
+  QtbArrowSchemaPrivate *private = (QtbArrowSchemaPrivate *)schema->private_data;
+
+  for (int64_t i = 0; private->children != NULL && i < private->n_children; i++) {
+    if (private->children[i] == NULL) continue;
+    if (private->children[i]->release != NULL) private->children[i]->release(private->children[i]);
+    free(private->children[i]);
+  }
+
+  if (private->dictionary != NULL) {
+    if (private->dictionary->release != NULL) private->dictionary->release(private->dictionary);
+    free(private->dictionary);
+  }
+
+  free(private->children);
+  free(private->name);
+  free(private);
+  schema->release = NULL;
+}
+
+// Once this returns, successfully or not, schema is released like any other
+// so that a half built schema can be torn down as a whole.
+static Result qtb_arrow_schema_init(struct ArrowSchema *schema, const char *format, const char *name, int64_t flags, int64_t n_children) {
+  QtbArrowSchemaPrivate *private;
+
+  schema->release = NULL;
+
+  private = (QtbArrowSchemaPrivate *)calloc(1, sizeof(QtbArrowSchemaPrivate));
+  if (private == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  *schema = (struct ArrowSchema){format, NULL, NULL, flags, n_children, NULL, NULL, &qtb_arrow_schema_release, private};
+
+  private->name = strdup(name);
+  private->children = (struct ArrowSchema **)calloc(n_children > 0 ? (size_t)n_children : 1, sizeof(struct ArrowSchema *));
+  if (private->name == NULL || private->children == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  private->n_children = n_children;
+  schema->name = private->name;
+  schema->children = private->children;
+
+  for (int64_t i = 0; i < n_children; i++) {
+    private->children[i] = (struct ArrowSchema *)calloc(1, sizeof(struct ArrowSchema));
+    if (private->children[i] == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+  }
+
+  return ResultSuccess();
+}
+
+static Result qtb_arrow_schema_init_column(struct ArrowSchema *schema, QtbColumn *column) {
+  QtbArrowSchemaPrivate *private;
+  Result result;
+  size_t bits;
+
+  result = qtb_arrow_schema_init(schema, qtb_arrow_format(column->type, &bits), column->name, column->nullable ? ARROW_FLAG_NULLABLE : 0, 0);
+  if (ResultFailed(result) || column->type != QTB_COLUMN_TYPE_CATEGORY) return result;
+
+  private = (QtbArrowSchemaPrivate *)schema->private_data;
+  private->dictionary = (struct ArrowSchema *)calloc(1, sizeof(struct ArrowSchema));
+  if (private->dictionary == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+  schema->dictionary = private->dictionary;
+
+  return qtb_arrow_schema_init(schema->dictionary, "u", "", 0, 0);
+}
+
+static Result qtb_arrow_table_schema(QtbTable *table, struct ArrowSchema *schema) {
+  Result result;
+
+  result = qtb_arrow_schema_init(schema, "+s", "", 0, table->width);
+
+  for (Py_ssize_t i = 0; i < table->width && ResultSuccessful(result); i++)
+    result = qtb_arrow_schema_init_column(schema->children[i], &table->columns[i]);
+
+  if (ResultFailed(result) && schema->release != NULL) schema->release(schema);
+  return result;
+}
+
+// ===== arrays =====
+
+// Every array holds a reference to its table and counts as one of its
+// exports, so that buffers pointing into chunks stay valid even when a
+// consumer moves a child array out and releases the rest.
+typedef struct {
+  QtbTable *table;
+  const void *buffers[3];
+  void *owned[3];
+  struct ArrowArray **children;
+  int64_t n_children;
+  struct ArrowArray *dictionary;
+} QtbArrowArrayPrivate;
+
+// Consumers may release arrays from any thread.
+static void qtb_arrow_array_release(struct ArrowArray *array) {
+  QtbArrowArrayPrivate *private = (QtbArrowArrayPrivate *)array->private_data;
+  PyGILState_STATE gil;
+
+  for (int64_t i = 0; private->children != NULL && i < private->n_children; i++) {
+    if (private->children[i] == NULL) continue;
+    if (private->children[i]->release != NULL) private->children[i]->release(private->children[i]);
+    free(private->children[i]);
+  }
+
+  if (private->dictionary != NULL) {
+    if (private->dictionary->release != NULL) private->dictionary->release(private->dictionary);
+    free(private->dictionary);
+  }
+
+  for (int i = 0; i < 3; i++)
+    free(private->owned[i]);
+
+  gil = PyGILState_Ensure();
+  private->table->exports--;
+  Py_DECREF(private->table);
+  PyGILState_Release(gil);
+
+  free(private->children);
+  free(private);
+  array->release = NULL;
+}
+
+// Like qtb_arrow_schema_init, array is released like any other once this
+// returns. Must be called with the GIL held.
+static Result qtb_arrow_array_init(struct ArrowArray *array, QtbTable *table, size_t length, int64_t n_buffers, int64_t n_children) {
+  QtbArrowArrayPrivate *private;
+
+  array->release = NULL;
+
+  private = (QtbArrowArrayPrivate *)calloc(1, sizeof(QtbArrowArrayPrivate));
+  if (private == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  Py_INCREF(table);
+  table->exports++;
+  private->table = table;
+
+  *array = (struct ArrowArray){(int64_t)length, 0, 0, n_buffers, n_children, private->buffers, NULL, NULL, &qtb_arrow_array_release, private};
+
+  private->children = (struct ArrowArray **)calloc(n_children > 0 ? (size_t)n_children : 1, sizeof(struct ArrowArray *));
+  if (private->children == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  private->n_children = n_children;
+  array->children = private->children;
+
+  for (int64_t i = 0; i < n_children; i++) {
+    private->children[i] = (struct ArrowArray *)calloc(1, sizeof(struct ArrowArray));
+    if (private->children[i] == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+  }
+
+  return ResultSuccess();
+}
+
+static const void *qtb_arrow_chunk_buffer(QtbColumn *column, bool validity, size_t chunk) {
+  return validity ? (const void *)column->chunks[chunk].validity : (const void *)column->chunks[chunk].data;
+}
+
+// Rows [start, start + n) of a column's cells, or of its validity bitmap, as
+// one contiguous buffer. start is the first row of a chunk. Rows within a
+// single chunk are handed out in place; longer ranges are copied, which is a
+// plain concatenation as chunks hold a whole number of bytes of any width.
+static Result qtb_arrow_gather(QtbColumn *column, bool validity, size_t bits, size_t start, size_t n, const void **buffer, void **owned) {
+  size_t first;
+  size_t chunk_size;
+  size_t size;
+  char *copy;
+  Result result;
+
+  if (n == 0) {
+    *buffer = qtb_arrow_empty;
+    return ResultSuccess();
+  }
+
+  first = qtb_column_chunk_of(start);
+
+  // Compressed chunks are exported as plain cells and stay that way.
+  for (size_t chunk = first; !validity && chunk <= qtb_column_chunk_of(start + n - 1); chunk++) {
+    result = qtb_column_decompress_chunk(column, chunk);
+    if (ResultFailed(result)) return result;
+  }
+
+  if (qtb_column_chunk_of(start + n - 1) == first) {
+    *buffer = qtb_arrow_chunk_buffer(column, validity, first);
+    return ResultSuccess();
+  }
+
+  chunk_size = QTB_COLUMN_CHUNK_SIZE / 8 * bits;
+  size = (n * bits + 7) / 8;
+
+  copy = (char *)malloc(size);
+  if (copy == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  for (size_t at = 0; at < size; at += chunk_size)
+    memcpy(&copy[at], qtb_arrow_chunk_buffer(column, validity, first + at / chunk_size), MIN(chunk_size, size - at));
+
+  *buffer = copy;
+  *owned = copy;
+  return ResultSuccess();
+}
+
+static int64_t qtb_arrow_null_count(const uint8_t *valid, size_t n) {
+  size_t count = 0;
+
+  for (size_t i = 0; i < n / 8; i++)
+    count += (size_t)__builtin_popcount(valid[i]);
+
+  if (n % 8 != 0) count += (size_t)__builtin_popcount(valid[n / 8] & ((1u << (n % 8)) - 1));
+
+  return (int64_t)(n - count);
+}
+
+// Allocates utf8 offset and data buffers for n values of total bytes.
+static Result qtb_arrow_utf8_buffers(QtbArrowArrayPrivate *private, size_t n, size_t total) {
+  if (total > INT32_MAX) return ResultFailure(PyExc_OverflowError, "str column too large for arrow");
+
+  private->owned[1] = malloc((n + 1) * sizeof(int32_t));
+  private->owned[2] = malloc(total > 0 ? total : 1);
+  if (private->owned[1] == NULL || private->owned[2] == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  private->buffers[1] = private->owned[1];
+  private->buffers[2] = private->owned[2];
+  ((int32_t *)private->owned[1])[0] = 0;
+
+  return ResultSuccess();
+}
+
+static Result qtb_arrow_str_buffers(QtbColumn *column, size_t start, size_t n, QtbArrowArrayPrivate *private) {
+  int32_t *offsets;
+  char *data;
+  size_t total = 0;
+  size_t size;
+  Result result;
+
+  for (size_t i = start; i < start + n; i++)
+    if (qtb_column_is_valid(column, i)) total += qtb_column_str_size_at(column, i);
+
+  result = qtb_arrow_utf8_buffers(private, n, total);
+  if (ResultFailed(result)) return result;
+
+  offsets = (int32_t *)private->owned[1];
+  data = (char *)private->owned[2];
+  total = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    if (qtb_column_is_valid(column, start + i)) {
+      size = qtb_column_str_size_at(column, start + i);
+      memcpy(&data[total], qtb_column_str_at(column, start + i), size);
+      total += size;
+    }
+    offsets[i + 1] = (int32_t)total;
+  }
+
+  return ResultSuccess();
+}
+
+static Result qtb_arrow_dictionary_array(QtbTable *table, QtbDictionary *dictionary, struct ArrowArray *array) {
+  QtbArrowArrayPrivate *private;
+  int32_t *offsets;
+  char *data;
+  size_t total = 0;
+  size_t size;
+  Result result;
+
+  result = qtb_arrow_array_init(array, table, dictionary->size, 3, 0);
+  if (ResultFailed(result)) return result;
+
+  private = (QtbArrowArrayPrivate *)array->private_data;
+  for (size_t code = 0; code < dictionary->size; code++)
+    total += qtb_dictionary_value_size_at(dictionary, code);
+
+  result = qtb_arrow_utf8_buffers(private, dictionary->size, total);
+  if (ResultFailed(result)) return result;
+
+  offsets = (int32_t *)private->owned[1];
+  data = (char *)private->owned[2];
+  total = 0;
+
+  for (size_t code = 0; code < dictionary->size; code++) {
+    size = qtb_dictionary_value_size_at(dictionary, code);
+    memcpy(&data[total], qtb_dictionary_value_at(dictionary, code), size);
+    total += size;
+    offsets[code + 1] = (int32_t)total;
+  }
+
+  return ResultSuccess();
+}
+
+// Rows [start, start + n) of a column, start being the first row of a chunk.
+static Result qtb_arrow_column_array(QtbTable *table, QtbColumn *column, size_t start, size_t n, struct ArrowArray *array) {
+  QtbArrowArrayPrivate *private;
+  Result result;
+  size_t bits;
+
+  qtb_arrow_format(column->type, &bits);
+
+  result = qtb_arrow_array_init(array, table, n, column->type == QTB_COLUMN_TYPE_STR ? 3 : 2, 0);
+  if (ResultFailed(result)) return result;
+
+  private = (QtbArrowArrayPrivate *)array->private_data;
+
+  if (column->nullable) {
+    result = qtb_arrow_gather(column, true, 1, start, n, &private->buffers[0], &private->owned[0]);
+    if (ResultFailed(result)) return result;
+
+    array->null_count = qtb_arrow_null_count((const uint8_t *)private->buffers[0], n);
+  }
+
+  if (column->type == QTB_COLUMN_TYPE_STR) return qtb_arrow_str_buffers(column, start, n, private);
+
+  result = qtb_arrow_gather(column, false, bits, start, n, &private->buffers[1], &private->owned[1]);
+  if (ResultFailed(result) || column->type != QTB_COLUMN_TYPE_CATEGORY) return result;
+
+  private->dictionary = (struct ArrowArray *)calloc(1, sizeof(struct ArrowArray));
+  if (private->dictionary == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+  array->dictionary = private->dictionary;
+
+  return qtb_arrow_dictionary_array(table, &column->dictionary, array->dictionary);
+}
+
+// A struct array of rows [start, start + n), with one child per column.
+static Result qtb_arrow_batch(QtbTable *table, size_t start, size_t n, struct ArrowArray *array) {
+  Result result;
+
+  result = qtb_arrow_array_init(array, table, n, 1, table->width);
+
+  for (Py_ssize_t i = 0; i < table->width && ResultSuccessful(result); i++)
+    result = qtb_arrow_column_array(table, &table->columns[i], start, n, array->children[i]);
+
+  if (ResultFailed(result) && array->release != NULL) array->release(array);
+  return result;
+}
+
+// ===== capsules =====
+
+static void qtb_arrow_schema_capsule_free(PyObject *capsule) {
+  struct ArrowSchema *schema = (struct ArrowSchema *)PyCapsule_GetPointer(capsule, "arrow_schema");
+
+  if (schema->release != NULL) schema->release(schema);
+  free(schema);
+}
+
+static void qtb_arrow_array_capsule_free(PyObject *capsule) {
+  struct ArrowArray *array = (struct ArrowArray *)PyCapsule_GetPointer(capsule, "arrow_array");
+
+  if (array->release != NULL) array->release(array);
+  free(array);
+}
+
+static void qtb_arrow_stream_capsule_free(PyObject *capsule) {
+  struct ArrowArrayStream *stream = (struct ArrowArrayStream *)PyCapsule_GetPointer(capsule, "arrow_array_stream");
+
+  if (stream->release != NULL) stream->release(stream);
+  free(stream);
+}
+
+ResultPyObjectPtr qtb_arrow_schema_capsule_(QtbTable *table) {
+  struct ArrowSchema *schema;
+  PyObject *capsule;
+  Result result;
+
+  schema = (struct ArrowSchema *)malloc(sizeof(struct ArrowSchema));
+  if (schema == NULL) return ResultPyObjectPtrFailure(PyExc_MemoryError, "memory error");
+
+  result = qtb_arrow_table_schema(table, schema);
+  if (ResultFailed(result)) {
+    free(schema);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  capsule = PyCapsule_New(schema, "arrow_schema", &qtb_arrow_schema_capsule_free);
+  if (capsule == NULL) {
+    schema->release(schema);
+    free(schema);
+    return ResultPyObjectPtrFailureFromPyErr();
+  }
+
+  return ResultPyObjectPtrSuccess(capsule);
+}
+
+// The whole table as a single batch, which takes copies of every buffer once
+// it spans more than one chunk. Streams avoid those.
+ResultPyObjectPtr qtb_arrow_array_capsules_(QtbTable *table) {
+  ResultPyObjectPtr schema;
+  struct ArrowArray *array;
+  PyObject *capsule;
+  PyObject *capsules;
+  Result result;
+
+  schema = qtb_arrow_schema_capsule_(table);
+  if (ResultFailed(schema)) return schema;
+
+  array = (struct ArrowArray *)malloc(sizeof(struct ArrowArray));
+  if (array == NULL) {
+    Py_DECREF(ResultValue(schema));
+    return ResultPyObjectPtrFailure(PyExc_MemoryError, "memory error");
+  }
+
+  result = qtb_arrow_batch(table, 0, (size_t)table->size, array);
+  if (ResultFailed(result)) {
+    Py_DECREF(ResultValue(schema));
+    free(array);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  capsule = PyCapsule_New(array, "arrow_array", &qtb_arrow_array_capsule_free);
+  if (capsule == NULL) {
+    Py_DECREF(ResultValue(schema));
+    array->release(array);
+    free(array);
+    return ResultPyObjectPtrFailureFromPyErr();
+  }
+
+  capsules = PyTuple_Pack(2, ResultValue(schema), capsule);
+  Py_DECREF(ResultValue(schema));
+  Py_DECREF(capsule);
+  if (capsules == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  return ResultPyObjectPtrSuccess(capsules);
+}
+
+// ===== streams =====
+
+// A stream pins its table for as long as it lives so that the batches it
+// has yet to produce are those of the table it was created from.
+typedef struct {
+  QtbTable *table;
+  size_t next;
+  const char *error;
+} QtbArrowStreamPrivate;
+
+static int qtb_arrow_stream_errno(QtbArrowStreamPrivate *private, Result result) {
+  private->error = ResultFailureMessage(result);
+
+  if (result.value.error.value.new.py_err_class == PyExc_MemoryError) return ENOMEM;
+  if (result.value.error.value.new.py_err_class == PyExc_OverflowError) return EOVERFLOW;
+  return EINVAL;
+}
+
+static int qtb_arrow_stream_get_schema(struct ArrowArrayStream *stream, struct ArrowSchema *out) {
+  QtbArrowStreamPrivate *private = (QtbArrowStreamPrivate *)stream->private_data;
+  PyGILState_STATE gil;
+  Result result;
+
+  gil = PyGILState_Ensure();
+  result = qtb_arrow_table_schema(private->table, out);
+  PyGILState_Release(gil);
+
+  return ResultFailed(result) ? qtb_arrow_stream_errno(private, result) : 0;
+}
+
+static int qtb_arrow_stream_get_next(struct ArrowArrayStream *stream, struct ArrowArray *out) {
+  QtbArrowStreamPrivate *private = (QtbArrowStreamPrivate *)stream->private_data;
+  PyGILState_STATE gil;
+  size_t start;
+  Result result = ResultSuccess();
+
+  gil = PyGILState_Ensure();
+
+  start = private->next * QTB_COLUMN_CHUNK_SIZE;
+  if (start >= (size_t)private->table->size) {
+    out->release = NULL;
+  } else {
+    result = qtb_arrow_batch(private->table, start, MIN(QTB_COLUMN_CHUNK_SIZE, (size_t)private->table->size - start), out);
+    if (ResultSuccessful(result)) private->next++;
+  }
+
+  PyGILState_Release(gil);
+
+  return ResultFailed(result) ? qtb_arrow_stream_errno(private, result) : 0;
+}
+
+static const char *qtb_arrow_stream_get_last_error(struct ArrowArrayStream *stream) {
+  return ((QtbArrowStreamPrivate *)stream->private_data)->error;
+}
+
+static void qtb_arrow_stream_release(struct ArrowArrayStream *stream) {
+  QtbArrowStreamPrivate *private = (QtbArrowStreamPrivate *)stream->private_data;
+  PyGILState_STATE gil;
+
+  gil = PyGILState_Ensure();
+  private->table->exports--;
+  Py_DECREF(private->table);
+  PyGILState_Release(gil);
+
+  free(private);
+  stream->release = NULL;
+}
+
+ResultPyObjectPtr qtb_arrow_stream_capsule_(QtbTable *table) {
+  struct ArrowArrayStream *stream;
+  QtbArrowStreamPrivate *private;
+  PyObject *capsule;
+
+  stream = (struct ArrowArrayStream *)malloc(sizeof(struct ArrowArrayStream));
+  private = (QtbArrowStreamPrivate *)malloc(sizeof(QtbArrowStreamPrivate));
+  if (stream == NULL || private == NULL) {
+    free(stream);
+    free(private);
+    return ResultPyObjectPtrFailure(PyExc_MemoryError, "memory error");
+  }
+
+  Py_INCREF(table);
+  table->exports++;
+  *private = (QtbArrowStreamPrivate){table, 0, NULL};
+  *stream = (struct ArrowArrayStream){
+    &qtb_arrow_stream_get_schema,
+    &qtb_arrow_stream_get_next,
+    &qtb_arrow_stream_get_last_error,
+    &qtb_arrow_stream_release,
+    private
+  };
+
+  capsule = PyCapsule_New(stream, "arrow_array_stream", &qtb_arrow_stream_capsule_free);
+  if (capsule == NULL) {
+    stream->release(stream);
+    free(stream);
+    return ResultPyObjectPtrFailureFromPyErr();
+  }
+
+  return ResultPyObjectPtrSuccess(capsule);
+}
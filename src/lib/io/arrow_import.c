@@ -0,0 +1,349 @@
+#include "arrow.h"
+
+// Blueprint type of an Arrow field, the reverse of the export mapping, along
+// with large strings and dictionaries of any integer index type.
+static const char *qtb_arrow_column_type(struct ArrowSchema *schema) {
+  const char *format = schema->format;
+
+  if (schema->dictionary != NULL) {
+    if (strlen(format) != 1 || strchr("csilCSIL", format[0]) == NULL) return NULL;
+    if (strcmp(schema->dictionary->format, "u") != 0 && strcmp(schema->dictionary->format, "U") != 0) return NULL;
+    return "category";
+  }
+
+  if (strcmp(format, "u") == 0 || strcmp(format, "U") == 0) return "str";
+  if (strlen(format) != 1) return NULL;
+
+  switch (format[0]) {
+    case 'l': return "int";
+    case 'g': return "float";
+    case 'b': return "bool";
+    case 'c': return "int8";
+    case 's': return "int16";
+    case 'i': return "int32";
+    case 'C': return "uint8";
+    case 'S': return "uint16";
+    case 'I': return "uint32";
+    case 'L': return "uint64";
+    case 'f': return "float32";
+    default: return NULL;
+  }
+}
+
+static ResultPyObjectPtr qtb_arrow_blueprint(struct ArrowSchema *schema) {
+  PyObject *blueprint;
+  PyObject *descriptor;
+  struct ArrowSchema *field;
+  const char *type;
+
+  if (strcmp(schema->format, "+s") != 0)
+    return ResultPyObjectPtrFailure(PyExc_TypeError, "from_arrow needs struct arrays");
+
+  blueprint = PyList_New((Py_ssize_t)schema->n_children);
+  if (blueprint == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    field = schema->children[i];
+    type = qtb_arrow_column_type(field);
+    if (type == NULL) {
+      Py_DECREF(blueprint);
+      PyErr_Format(PyExc_TypeError, "unsupported arrow format '%s' for column '%s'", field->format, field->name == NULL ? "" : field->name);
+      return ResultPyObjectPtrFailureFromPyErr();
+    }
+
+    descriptor = Py_BuildValue("(sN)", field->name == NULL ? "" : field->name, PyUnicode_FromFormat("%s%s", type, (field->flags & ARROW_FLAG_NULLABLE) ? "?" : ""));
+    if (descriptor == NULL) {
+      Py_DECREF(blueprint);
+      return ResultPyObjectPtrFailureFromPyErr();
+    }
+
+    PyList_SET_ITEM(blueprint, i, descriptor);
+  }
+
+  return ResultPyObjectPtrSuccess(blueprint);
+}
+
+#define qtb_arrow_bit_at(bitmap, i) ((((const uint8_t *)(bitmap))[(i) / 8] >> ((i) % 8)) & 1)
+
+static int64_t qtb_arrow_index_at(const void *indices, char format, size_t i) {
+  switch (format) {
+    case 'c': return ((const int8_t *)indices)[i];
+    case 's': return ((const int16_t *)indices)[i];
+    case 'i': return ((const int32_t *)indices)[i];
+    case 'C': return ((const uint8_t *)indices)[i];
+    case 'S': return ((const uint16_t *)indices)[i];
+    case 'I': return ((const uint32_t *)indices)[i];
+    default: return ((const int64_t *)indices)[i];
+  }
+}
+
+// Offsets of a utf8 ('u') or large utf8 ('U') array.
+static int64_t qtb_arrow_offset_at(const void *offsets, bool large, size_t i) {
+  return large ? ((const int64_t *)offsets)[i] : ((const int32_t *)offsets)[i];
+}
+
+static Result qtb_arrow_append_strs(QtbColumn *column, struct ArrowSchema *schema, struct ArrowArray *array, size_t offset, size_t n, const void *valid) {
+  bool large = schema->format[0] == 'U';
+  const char *data = (const char *)array->buffers[2];
+  int64_t start;
+  Result result;
+
+  for (size_t i = offset; i < offset + n; i++) {
+    if (valid != NULL && !qtb_arrow_bit_at(valid, i)) {
+      result = qtb_column_append_none(column);
+    } else {
+      start = qtb_arrow_offset_at(array->buffers[1], large, i);
+      result = qtb_column_append_string(column, &data[start], (size_t)(qtb_arrow_offset_at(array->buffers[1], large, i + 1) - start));
+    }
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+// Dictionary values are interned once each, then indices are translated
+// into codes. Values interned before a failure stay in the dictionary unused.
+static Result qtb_arrow_append_codes(QtbColumn *column, struct ArrowSchema *schema, struct ArrowArray *array, size_t offset, size_t n, const void *valid) {
+  struct ArrowArray *dictionary = array->dictionary;
+  bool large = schema->dictionary->format[0] == 'U';
+  const char *data = (const char *)dictionary->buffers[2];
+  uint32_t *codes;
+  int64_t start;
+  int64_t index;
+  ResultSize_t code;
+
+  codes = (uint32_t *)malloc((dictionary->length > 0 ? (size_t)dictionary->length : 1) * sizeof(uint32_t));
+  if (codes == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  for (int64_t j = 0; j < dictionary->length; j++) {
+    start = qtb_arrow_offset_at(dictionary->buffers[1], large, (size_t)(dictionary->offset + j));
+    code = qtb_dictionary_intern(&column->dictionary, &data[start], (size_t)(qtb_arrow_offset_at(dictionary->buffers[1], large, (size_t)(dictionary->offset + j + 1)) - start));
+    if (ResultFailed(code)) {
+      free(codes);
+      return ResultFailureFromResult(code);
+    }
+    codes[j] = (uint32_t)ResultValue(code);
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (valid != NULL && !qtb_arrow_bit_at(valid, offset + i)) continue;
+
+    index = qtb_arrow_index_at(array->buffers[1], schema->format[0], offset + i);
+    if (index < 0 || index >= dictionary->length) {
+      free(codes);
+      return ResultFailure(PyExc_ValueError, "from_arrow with dictionary index out of range");
+    }
+
+    qtb_column_cell(column, uint32_t, column->size + i) = codes[index];
+  }
+
+  free(codes);
+  qtb_column_commit_rows(column, n, (const uint8_t *)valid, offset);
+  return ResultSuccess();
+}
+
+static void qtb_arrow_append_bools(QtbColumn *column, struct ArrowArray *array, size_t offset, size_t n, const void *valid) {
+  uint64_t *word;
+  uint64_t bit;
+
+  for (size_t i = 0; i < n; i++) {
+    word = &qtb_column_bool_word(column, column->size + i);
+    bit = qtb_column_bit_of(column->size + i);
+
+    if (qtb_arrow_bit_at(array->buffers[1], offset + i)) *word |= bit;
+    else *word &= ~bit;
+  }
+
+  qtb_column_commit_rows(column, n, (const uint8_t *)valid, offset);
+}
+
+// Fixed-width cells go through the column's buffer method, which copies
+// them in runs as the blueprint was derived from these very formats.
+static Result qtb_arrow_append_cells(QtbColumn *column, struct ArrowSchema *schema, struct ArrowArray *array, size_t offset, size_t n, const void *valid) {
+  QtbBuffer buffer;
+  Result result;
+
+  switch (schema->format[0]) {
+    case 'g': case 'f': buffer.kind = QTB_BUFFER_FLOAT; break;
+    case 'C': case 'S': case 'I': case 'L': buffer.kind = QTB_BUFFER_UNSIGNED; break;
+    default: buffer.kind = QTB_BUFFER_SIGNED; break;
+  }
+
+  switch (schema->format[0]) {
+    case 'c': case 'C': buffer.itemsize = 1; break;
+    case 's': case 'S': buffer.itemsize = 2; break;
+    case 'i': case 'I': case 'f': buffer.itemsize = 4; break;
+    default: buffer.itemsize = 8; break;
+  }
+
+  buffer.data = (const char *)array->buffers[1] + offset * buffer.itemsize;
+  buffer.n = n;
+
+  result = column->append_buffer(column, &buffer);
+  if (ResultFailed(result)) return result;
+
+  qtb_column_commit_rows(column, n, (const uint8_t *)valid, offset);
+  return ResultSuccess();
+}
+
+// Appends rows [offset, offset + n) of an Arrow array to a column that has
+// room for them.
+static Result qtb_arrow_append_column(QtbColumn *column, struct ArrowSchema *schema, struct ArrowArray *array, size_t offset, size_t n) {
+  const void *valid = NULL;
+
+  offset += (size_t)array->offset;
+
+  if (array->null_count != 0 && array->buffers[0] != NULL) {
+    valid = array->buffers[0];
+
+    if (!column->nullable)
+      for (size_t i = offset; i < offset + n; i++)
+        if (!qtb_arrow_bit_at(valid, i)) return ResultFailure(PyExc_ValueError, "from_arrow with null in non-nullable column");
+  }
+
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_STR: return qtb_arrow_append_strs(column, schema, array, offset, n, valid);
+    case QTB_COLUMN_TYPE_CATEGORY: return qtb_arrow_append_codes(column, schema, array, offset, n, valid);
+    case QTB_COLUMN_TYPE_BOOL:
+      qtb_arrow_append_bools(column, array, offset, n, valid);
+      return ResultSuccess();
+    default: return qtb_arrow_append_cells(column, schema, array, offset, n, valid);
+  }
+}
+
+// Either every row of the batch is appended or none are.
+static Result qtb_arrow_append_batch(QtbTable *table, struct ArrowSchema *schema, struct ArrowArray *batch) {
+  size_t n = (size_t)batch->length;
+  Result result;
+
+  if (batch->n_children != table->width) return ResultFailure(PyExc_ValueError, "from_arrow with mismatching batch width");
+
+  result = qtb_table_reserve_(table, table->size + (Py_ssize_t)n);
+
+  for (Py_ssize_t j = 0; j < table->width && ResultSuccessful(result); j++)
+    result = qtb_arrow_append_column(&table->columns[j], schema->children[j], batch->children[j], (size_t)batch->offset, n);
+
+  if (ResultSuccessful(result)) result = qtb_table_commit_rows_(table, (Py_ssize_t)n);
+  if (ResultFailed(result)) qtb_table_truncate_columns(table);
+
+  return result;
+}
+
+static ResultPyObjectPtr qtb_arrow_new_table(PyTypeObject *type, struct ArrowSchema *schema, PyObject *kwargs) {
+  ResultPyObjectPtr blueprint;
+  PyObject *args;
+  PyObject *table;
+
+  blueprint = qtb_arrow_blueprint(schema);
+  if (ResultFailed(blueprint)) return blueprint;
+
+  args = PyTuple_Pack(1, ResultValue(blueprint));
+  Py_DECREF(ResultValue(blueprint));
+  if (args == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  table = PyObject_Call((PyObject *)type, args, kwargs);
+  Py_DECREF(args);
+  if (table == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  return ResultPyObjectPtrSuccess(table);
+}
+
+static Result qtb_arrow_stream_failure(struct ArrowArrayStream *stream, int code) {
+  const char *error;
+
+  error = stream->get_last_error(stream);
+  PyErr_Format(PyExc_RuntimeError, "from_arrow stream failed: %s", error != NULL ? error : strerror(code));
+  return ResultFailureFromPyErr();
+}
+
+static ResultPyObjectPtr qtb_arrow_import_stream(PyTypeObject *type, struct ArrowArrayStream *stream, PyObject *kwargs) {
+  struct ArrowSchema schema;
+  struct ArrowArray batch;
+  ResultPyObjectPtr table;
+  Result result = ResultSuccess();
+  int code;
+
+  code = stream->get_schema(stream, &schema);
+  if (code != 0) return ResultPyObjectPtrFailureFromResult(qtb_arrow_stream_failure(stream, code));
+
+  table = qtb_arrow_new_table(type, &schema, kwargs);
+
+  while (ResultSuccessful(table) && ResultSuccessful(result)) {
+    code = stream->get_next(stream, &batch);
+    if (code != 0) {
+      result = qtb_arrow_stream_failure(stream, code);
+      break;
+    }
+    if (batch.release == NULL) break;
+
+    result = qtb_arrow_append_batch((QtbTable *)ResultValue(table), &schema, &batch);
+    batch.release(&batch);
+  }
+
+  schema.release(&schema);
+
+  if (ResultSuccessful(table) && ResultFailed(result)) {
+    Py_DECREF(ResultValue(table));
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  return table;
+}
+
+static ResultPyObjectPtr qtb_arrow_import_array(PyTypeObject *type, PyObject *capsules, PyObject *kwargs) {
+  struct ArrowSchema *schema;
+  struct ArrowArray *array;
+  ResultPyObjectPtr table;
+  Result result;
+
+  if (!PyTuple_Check(capsules) || PyTuple_GET_SIZE(capsules) != 2)
+    return ResultPyObjectPtrFailure(PyExc_TypeError, "__arrow_c_array__ must return a pair of capsules");
+
+  schema = (struct ArrowSchema *)PyCapsule_GetPointer(PyTuple_GET_ITEM(capsules, 0), "arrow_schema");
+  if (schema == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  array = (struct ArrowArray *)PyCapsule_GetPointer(PyTuple_GET_ITEM(capsules, 1), "arrow_array");
+  if (array == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  table = qtb_arrow_new_table(type, schema, kwargs);
+  if (ResultFailed(table)) return table;
+
+  result = qtb_arrow_append_batch((QtbTable *)ResultValue(table), schema, array);
+  if (ResultFailed(result)) {
+    Py_DECREF(ResultValue(table));
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  return table;
+}
+
+// Streams are preferred as they need not gather the data into one batch.
+// The capsules keep ownership of what they hold and release it once gone.
+ResultPyObjectPtr qtb_arrow_import_(PyTypeObject *type, PyObject *data, PyObject *kwargs) {
+  PyObject *capsule;
+  struct ArrowArrayStream *stream;
+  ResultPyObjectPtr result;
+
+  if (PyObject_HasAttrString(data, "__arrow_c_stream__")) {
+    capsule = PyObject_CallMethod(data, "__arrow_c_stream__", NULL);
+    if (capsule == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+    stream = (struct ArrowArrayStream *)PyCapsule_GetPointer(capsule, "arrow_array_stream");
+    if (stream == NULL) {
+      Py_DECREF(capsule);
+      return ResultPyObjectPtrFailureFromPyErr();
+    }
+
+    result = qtb_arrow_import_stream(type, stream, kwargs);
+  } else if (PyObject_HasAttrString(data, "__arrow_c_array__")) {
+    capsule = PyObject_CallMethod(data, "__arrow_c_array__", NULL);
+    if (capsule == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+    result = qtb_arrow_import_array(type, capsule, kwargs);
+  } else {
+    return ResultPyObjectPtrFailure(PyExc_TypeError, "from_arrow needs an object implementing the Arrow PyCapsule interface");
+  }
+
+  Py_DECREF(capsule);
+  return result;
+}
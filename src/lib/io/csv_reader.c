@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <string.h>
+#include "csv.h"
+#include "reader.h"
+#include "result.h"
+#include "utf8.h"
+
+// Returns the start of the record after the one at p. Quotes are tracked so
+// that newlines inside quoted fields do not end the record.
+static const char *qtb_csv_skip_record(const char *p, const char *end, const void *options) {
+  bool quoted = false;
+
+  for (; p < end; p++) {
+    if (*p == '"') quoted = !quoted;
+    else if (*p == '\n' && !quoted) return p + 1;
+  }
+
+  return end;
+}
+
+// Splits [begin, end) into at most n runs of whole records, writing n + 1
+// bounds, and returns the number of runs. Quoting can only be known from the
+// start of the data, so this is a serial pass, but a much cheaper one than
+// the parse it divides up.
+static size_t qtb_csv_split(const char *begin, const char *end, size_t n, const char **bounds, const void *options) {
+  size_t size;
+  size_t k = 1;
+  bool quoted = false;
+
+  size = end - begin;
+  bounds[0] = begin;
+
+  for (const char *p = begin; p + 1 < end && k < n; p++) {
+    if (*p == '"') quoted = !quoted;
+    else if (*p == '\n' && !quoted && (size_t)(p + 1 - begin) >= k * (size / n)) bounds[k++] = p + 1;
+  }
+
+  bounds[k] = end;
+  return k;
+}
+
+static Result qtb_csv_read_quoted(QtbReaderWorker *worker, const char **p, const char **s, size_t *size) {
+  const char *start;
+  const char *q;
+  bool escaped = false;
+  ResultCharPtr scratch;
+  size_t n = 0;
+
+  start = *p + 1;
+  q = start;
+
+  for (;;) {
+    q = (const char *)memchr(q, '"', worker->end - q);
+    if (q == NULL) return ResultFailure(PyExc_ValueError, "read_csv with unterminated quoted field");
+    if (q + 1 < worker->end && q[1] == '"') {
+      escaped = true;
+      q += 2;
+      continue;
+    }
+    break;
+  }
+
+  *p = q + 1;
+
+  if (!escaped) {
+    *s = start;
+    *size = q - start;
+    return ResultSuccess();
+  }
+
+  scratch = qtb_reader_scratch(worker, q - start);
+  if (ResultFailed(scratch)) return ResultFailureFromResult(scratch);
+
+  for (const char *c = start; c < q; c++) {
+    ResultValue(scratch)[n++] = *c;
+    if (*c == '"') c++;
+  }
+
+  *s = ResultValue(scratch);
+  *size = n;
+  return ResultSuccess();
+}
+
+static Result qtb_csv_worker_parse(QtbReaderWorker *worker) {
+  const char *p;
+  const char *end;
+  const char *s;
+  size_t size;
+  bool quoted;
+  bool skip_empty;
+  Py_ssize_t i;
+  QtbColumn *column;
+  Result result;
+  char delimiter;
+
+  p = worker->begin;
+  end = worker->end;
+  delimiter = ((const QtbCsvOptions *)worker->options)->delimiter;
+
+  // Empty lines are skipped, except in a table of one nullable column where
+  // they are how a null row is written.
+  skip_empty = worker->width != 1 || !worker->columns[0].nullable;
+
+  while (p < end) {
+    if (skip_empty && *p == '\n') {
+      p++;
+      continue;
+    }
+    if (skip_empty && *p == '\r' && p + 1 < end && p[1] == '\n') {
+      p += 2;
+      continue;
+    }
+
+    for (i = 0;; i++) {
+      quoted = p < end && *p == '"';
+
+      if (quoted) {
+        result = qtb_csv_read_quoted(worker, &p, &s, &size);
+        if (ResultFailed(result)) return qtb_reader_fail(worker, result, i);
+
+        if (p < end && *p == '\r' && p + 1 < end && p[1] == '\n') p++;
+        if (p < end && *p != delimiter && *p != '\n')
+          return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_csv with malformed quoted field"), i);
+      } else {
+        s = p;
+        while (p < end && *p != delimiter && *p != '\n') p++;
+        size = p - s;
+        if (size > 0 && s[size - 1] == '\r' && (p == end || *p == '\n')) size--;
+      }
+
+      if (i >= worker->width)
+        return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_csv with mismatching row length"), -1);
+
+      // An empty, unquoted field is a null where the column allows one and
+      // an empty string otherwise.
+      column = &worker->columns[i];
+      if ((column->type == QTB_COLUMN_TYPE_STR || column->type == QTB_COLUMN_TYPE_CATEGORY) && !qtb_utf8_valid(s, size))
+        return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_csv with invalid UTF-8"), i);
+
+      if (size == 0 && !quoted && column->nullable) result = qtb_column_append_none(column);
+      else result = qtb_column_append_string(column, s, size);
+      if (ResultFailed(result)) return qtb_reader_fail(worker, result, i);
+
+      if (p < end && *p == delimiter) p++;
+      else break;
+    }
+
+    if (p < end) p++;
+
+    if (i + 1 != worker->width)
+      return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_csv with mismatching row length"), -1);
+
+    worker->rows++;
+  }
+
+  return ResultSuccess();
+}
+
+// Appends the records of a CSV file to table; see qtb_reader_read_into_.
+Result qtb_csv_read_into_(QtbTable *table, const char *path, QtbCsvOptions *options) {
+  QtbReader reader;
+
+  if (options->delimiter == '"' || options->delimiter == '\n' || options->delimiter == '\r')
+    return ResultFailure(PyExc_ValueError, "invalid delimiter");
+
+  reader = (QtbReader){
+    options->header ? &qtb_csv_skip_record : NULL,
+    &qtb_csv_split,
+    &qtb_csv_worker_parse,
+    options,
+    options->n_threads,
+  };
+
+  return qtb_reader_read_into_(table, path, &reader);
+}
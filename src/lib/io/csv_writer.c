@@ -0,0 +1,382 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "csv.h"
+#include "result.h"
+
+// Cells are formatted straight into one buffer that is handed to the
+// destination whenever the next cell does not fit. Flushes only happen
+// between cells, so a text file is never given half of a UTF-8 character,
+// and the buffer only outgrows QTB_CSV_WRITE_BUFFER_SIZE for a cell that is
+// larger still.
+typedef struct {
+  char *data;
+  size_t size;
+  size_t capacity;
+  char delimiter;
+
+  // Either a file descriptor opened from path or a Python file object,
+  // written to as str when it is a text file.
+  int fd;
+  const char *path;
+  PyObject *file;
+  bool text;
+} QtbCsvWriter;
+
+// Longest output of "%.17g", e.g. -2.2250738585072014e-308, with room to
+// spare.
+#define QTB_CSV_NUMBER_MAX_SIZE 32
+
+static Result qtb_csv_writer_flush(QtbCsvWriter *writer) {
+  PyObject *chunk;
+  PyObject *written;
+  ssize_t n;
+  size_t done = 0;
+  int error = 0;
+
+  if (writer->size == 0) return ResultSuccess();
+
+  if (writer->file == NULL) {
+    Py_BEGIN_ALLOW_THREADS
+    while (done < writer->size) {
+      n = write(writer->fd, writer->data + done, writer->size - done);
+      if (n == -1 && errno == EINTR) continue;
+      if (n == -1) {
+        error = errno;
+        break;
+      }
+      done += (size_t)n;
+    }
+    Py_END_ALLOW_THREADS
+
+    if (error != 0) {
+      errno = error;
+      PyErr_SetFromErrnoWithFilename(PyExc_OSError, writer->path);
+      return ResultFailureFromPyErr();
+    }
+  } else {
+    if (writer->text) chunk = PyUnicode_DecodeUTF8(writer->data, (Py_ssize_t)writer->size, NULL);
+    else chunk = PyBytes_FromStringAndSize(writer->data, (Py_ssize_t)writer->size);
+    if (chunk == NULL) return ResultFailureFromPyErr();
+
+    written = PyObject_CallMethod(writer->file, "write", "O", chunk);
+    Py_DECREF(chunk);
+    if (written == NULL) return ResultFailureFromPyErr();
+    Py_DECREF(written);
+  }
+
+  writer->size = 0;
+  return ResultSuccess();
+}
+
+static Result qtb_csv_writer_reserve(QtbCsvWriter *writer, size_t n) {
+  char *data;
+  Result result;
+
+  if (writer->capacity - writer->size >= n) return ResultSuccess();
+
+  result = qtb_csv_writer_flush(writer);
+  if (ResultFailed(result)) return result;
+  if (writer->capacity >= n) return ResultSuccess();
+
+  data = (char *)realloc(writer->data, n);
+  if (data == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  writer->data = data;
+  writer->capacity = n;
+  return ResultSuccess();
+}
+
+static void qtb_csv_write_unsigned(QtbCsvWriter *writer, uint64_t value) {
+  char digits[20];
+  size_t n = 0;
+
+  do {
+    digits[n++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  while (n > 0) writer->data[writer->size++] = digits[--n];
+}
+
+static void qtb_csv_write_signed(QtbCsvWriter *writer, int64_t value) {
+  if (value >= 0) {
+    qtb_csv_write_unsigned(writer, (uint64_t)value);
+    return;
+  }
+
+  writer->data[writer->size++] = '-';
+  qtb_csv_write_unsigned(writer, -(uint64_t)value);
+}
+
+static bool qtb_csv_same(double a, double b, bool single) {
+  if (single) return (float)a == (float)b;
+
+  return a == b;
+}
+
+// Most values in practice have a handful of decimals. Such a value is the
+// correctly rounded quotient m / 10^d for an integer m and small d, which is
+// exactly what strtod makes of the digits of m with the point moved d places,
+// so those digits can be written without going through snprintf.
+static bool qtb_csv_write_decimal(QtbCsvWriter *writer, double value, bool single) {
+  static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+  static const uint64_t int_powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+  double m;
+  uint64_t magnitude;
+  uint64_t fraction;
+
+  for (size_t d = 0; d < sizeof(powers) / sizeof(powers[0]); d++) {
+    m = nearbyint(value * powers[d]);
+    if (!(fabs(m) < 9007199254740992.0)) return false;
+    if (!qtb_csv_same(m / powers[d], value, single)) continue;
+
+    if (signbit(value)) writer->data[writer->size++] = '-';
+
+    magnitude = (uint64_t)fabs(m);
+    qtb_csv_write_unsigned(writer, magnitude / int_powers[d]);
+    if (d == 0) return true;
+
+    writer->data[writer->size++] = '.';
+    fraction = magnitude % int_powers[d];
+    for (size_t k = d; k > 0; k--) {
+      writer->data[writer->size + k - 1] = (char)('0' + fraction % 10);
+      fraction /= 10;
+    }
+    writer->size += d;
+    return true;
+  }
+
+  return false;
+}
+
+// Prefers the shorter precision whenever it reads back as the same value, so
+// that 0.1 is written as 0.1 and not 0.10000000000000001.
+static void qtb_csv_write_double(QtbCsvWriter *writer, double value, bool single) {
+  char *at;
+  int n;
+
+  if (isfinite(value) && qtb_csv_write_decimal(writer, value, single)) return;
+
+  at = &writer->data[writer->size];
+  n = snprintf(at, QTB_CSV_NUMBER_MAX_SIZE, "%.*g", single ? 6 : 15, value);
+  if (isfinite(value) && !qtb_csv_same(strtod(at, NULL), value, single))
+    n = snprintf(at, QTB_CSV_NUMBER_MAX_SIZE, "%.*g", single ? 9 : 17, value);
+
+  writer->size += (size_t)n;
+}
+
+// Fields holding the delimiter, a quote or a line break are quoted, with
+// quotes doubled. quote_empty marks an empty string apart from a null.
+static Result qtb_csv_write_text(QtbCsvWriter *writer, const char *s, size_t size, bool quote_empty) {
+  bool quoted;
+  Result result;
+
+  quoted = quote_empty && size == 0;
+  for (size_t i = 0; i < size && !quoted; i++)
+    quoted = s[i] == writer->delimiter || s[i] == '"' || s[i] == '\n' || s[i] == '\r';
+
+  if (!quoted) {
+    result = qtb_csv_writer_reserve(writer, size);
+    if (ResultFailed(result)) return result;
+
+    memcpy(&writer->data[writer->size], s, size);
+    writer->size += size;
+    return ResultSuccess();
+  }
+
+  result = qtb_csv_writer_reserve(writer, 2 * size + 2);
+  if (ResultFailed(result)) return result;
+
+  writer->data[writer->size++] = '"';
+  for (size_t i = 0; i < size; i++) {
+    if (s[i] == '"') writer->data[writer->size++] = '"';
+    writer->data[writer->size++] = s[i];
+  }
+  writer->data[writer->size++] = '"';
+
+  return ResultSuccess();
+}
+
+// An empty string is quoted in a nullable column, where an empty field is a
+// null, and in a table of one column, where it would be an empty line that
+// read_csv skips.
+static Result qtb_csv_write_cell(QtbCsvWriter *writer, QtbColumn *column, size_t i, bool alone) {
+  QtbDictionary *dictionary;
+  const char *b;
+  Result result;
+
+  if (!qtb_column_is_valid(column, i)) return ResultSuccess();
+
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_STR:
+      return qtb_csv_write_text(writer, qtb_column_str_at(column, i), qtb_column_str_size_at(column, i), column->nullable || alone);
+    case QTB_COLUMN_TYPE_CATEGORY:
+      dictionary = &column->dictionary;
+      return qtb_csv_write_text(
+        writer,
+        qtb_dictionary_value_at(dictionary, qtb_column_code_at(column, i)),
+        qtb_dictionary_value_size_at(dictionary, qtb_column_code_at(column, i)),
+        column->nullable || alone
+      );
+    default:
+      break;
+  }
+
+  result = qtb_csv_writer_reserve(writer, QTB_CSV_NUMBER_MAX_SIZE);
+  if (ResultFailed(result)) return result;
+
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_INT:
+      qtb_csv_write_signed(writer, qtb_column_int_at(column, i));
+      break;
+    case QTB_COLUMN_TYPE_INT8:
+      qtb_csv_write_signed(writer, qtb_column_value_at(column, int8_t, i));
+      break;
+    case QTB_COLUMN_TYPE_INT16:
+      qtb_csv_write_signed(writer, qtb_column_value_at(column, int16_t, i));
+      break;
+    case QTB_COLUMN_TYPE_INT32:
+      qtb_csv_write_signed(writer, qtb_column_value_at(column, int32_t, i));
+      break;
+    case QTB_COLUMN_TYPE_UINT8:
+      qtb_csv_write_unsigned(writer, qtb_column_value_at(column, uint8_t, i));
+      break;
+    case QTB_COLUMN_TYPE_UINT16:
+      qtb_csv_write_unsigned(writer, qtb_column_value_at(column, uint16_t, i));
+      break;
+    case QTB_COLUMN_TYPE_UINT32:
+      qtb_csv_write_unsigned(writer, qtb_column_value_at(column, uint32_t, i));
+      break;
+    case QTB_COLUMN_TYPE_UINT64:
+      qtb_csv_write_unsigned(writer, qtb_column_value_at(column, uint64_t, i));
+      break;
+    case QTB_COLUMN_TYPE_FLOAT:
+      qtb_csv_write_double(writer, qtb_column_float_at(column, i), false);
+      break;
+    case QTB_COLUMN_TYPE_FLOAT32:
+      qtb_csv_write_double(writer, qtb_column_cell(column, float, i), true);
+      break;
+    case QTB_COLUMN_TYPE_BOOL:
+      b = qtb_column_bool_at(column, i) ? "True" : "False";
+      memcpy(&writer->data[writer->size], b, strlen(b));
+      writer->size += strlen(b);
+      break;
+    case QTB_COLUMN_TYPE_STR:
+    case QTB_COLUMN_TYPE_CATEGORY:
+      break;
+  }
+
+  return ResultSuccess();
+}
+
+// Every field is followed by the delimiter, or a newline for the last one.
+static Result qtb_csv_write_separator(QtbCsvWriter *writer, Py_ssize_t j, Py_ssize_t width) {
+  Result result;
+
+  result = qtb_csv_writer_reserve(writer, 1);
+  if (ResultFailed(result)) return result;
+
+  writer->data[writer->size++] = j + 1 < width ? writer->delimiter : '\n';
+  return ResultSuccess();
+}
+
+static Result qtb_csv_write_rows(QtbCsvWriter *writer, QtbTable *table, bool header) {
+  Result result;
+
+  for (Py_ssize_t j = 0; header && j < table->width; j++) {
+    result = qtb_csv_write_text(writer, table->columns[j].name, strlen(table->columns[j].name), false);
+    if (ResultFailed(result)) return result;
+
+    result = qtb_csv_write_separator(writer, j, table->width);
+    if (ResultFailed(result)) return result;
+  }
+
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    for (Py_ssize_t j = 0; j < table->width; j++) {
+      result = qtb_csv_write_cell(writer, &table->columns[j], qtb_table_row(table, i), table->width == 1);
+      if (ResultFailed(result)) return result;
+
+      result = qtb_csv_write_separator(writer, j, table->width);
+      if (ResultFailed(result)) return result;
+    }
+  }
+
+  return qtb_csv_writer_flush(writer);
+}
+
+static Result qtb_csv_writer_open_file(QtbCsvWriter *writer, PyObject *file) {
+  PyObject *io;
+  PyObject *text_io;
+  int text;
+
+  if (!PyObject_HasAttrString(file, "write"))
+    return ResultFailure(PyExc_TypeError, "to_csv destination must be a path or a file object");
+
+  if ((io = PyImport_ImportModule("io")) == NULL) return ResultFailureFromPyErr();
+  text_io = PyObject_GetAttrString(io, "TextIOBase");
+  Py_DECREF(io);
+  if (text_io == NULL) return ResultFailureFromPyErr();
+
+  text = PyObject_IsInstance(file, text_io);
+  Py_DECREF(text_io);
+  if (text == -1) return ResultFailureFromPyErr();
+
+  writer->file = file;
+  writer->text = text == 1;
+  return ResultSuccess();
+}
+
+// Writes the table to destination, a path or a file object, one record per
+// row. Nulls are written as empty fields and empty strings in nullable
+// columns as "", so that read_csv reads back what was written.
+Result qtb_csv_write_(QtbTable *table, PyObject *destination, QtbCsvOptions *options) {
+  QtbCsvWriter writer = {NULL, 0, 0, options->delimiter, -1, NULL, NULL, false};
+  QtbTable *root;
+  PyObject *path = NULL;
+  Result result;
+
+  if (options->delimiter == '"' || options->delimiter == '\n' || options->delimiter == '\r')
+    return ResultFailure(PyExc_ValueError, "invalid delimiter");
+
+  if (PyUnicode_Check(destination) || PyBytes_Check(destination) || PyObject_HasAttrString(destination, "__fspath__")) {
+    if (!PyUnicode_FSConverter(destination, &path)) return ResultFailureFromPyErr();
+
+    writer.path = PyBytes_AS_STRING(path);
+    writer.fd = open(writer.path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (writer.fd == -1) {
+      PyErr_SetFromErrnoWithFilename(PyExc_OSError, writer.path);
+      Py_DECREF(path);
+      return ResultFailureFromPyErr();
+    }
+  } else {
+    result = qtb_csv_writer_open_file(&writer, destination);
+    if (ResultFailed(result)) return result;
+  }
+
+  writer.data = (char *)malloc(QTB_CSV_WRITE_BUFFER_SIZE);
+  if (writer.data == NULL) result = ResultFailure(PyExc_MemoryError, "memory error");
+  else {
+    writer.capacity = QTB_CSV_WRITE_BUFFER_SIZE;
+
+    // Flushing calls file.write or releases the GIL, either of which lets
+    // other code run; the table, or a view's base, is pinned meanwhile.
+    root = table->base != NULL ? (QtbTable *)table->base : table;
+    root->exports++;
+    result = qtb_csv_write_rows(&writer, table, options->header);
+    root->exports--;
+  }
+
+  if (writer.fd != -1 && close(writer.fd) == -1 && ResultSuccessful(result)) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, writer.path);
+    result = ResultFailureFromPyErr();
+  }
+
+  free(writer.data);
+  Py_XDECREF(path);
+  return result;
+}
@@ -0,0 +1,357 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jsonl.h"
+#include "reader.h"
+#include "result.h"
+#include "utf8.h"
+
+// JSON Lines holds one object per line. Only the members named in the
+// blueprint are read, straight into their columns; others are skipped
+// without being decoded. Members missing from a line are null.
+
+static bool qtb_jsonl_is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char *qtb_jsonl_skip_space(const char *p, const char *end) {
+  while (p < end && qtb_jsonl_is_space(*p)) p++;
+  return p;
+}
+
+// Lines cannot hold a raw newline, not even inside strings, so runs only
+// need to end on one.
+static size_t qtb_jsonl_split(const char *begin, const char *end, size_t n, const char **bounds, const void *options) {
+  const char *p;
+  size_t size;
+  size_t k = 1;
+
+  size = end - begin;
+  bounds[0] = begin;
+
+  while (k < n) {
+    p = begin + k * (size / n);
+    if (p < bounds[k - 1]) p = bounds[k - 1];
+    p = (const char *)memchr(p, '\n', end - p);
+    if (p == NULL || p + 1 >= end) break;
+    bounds[k++] = p + 1;
+  }
+
+  bounds[k] = end;
+  return k;
+}
+
+static unsigned qtb_jsonl_hex(const char *p) {
+  unsigned value = 0;
+  unsigned digit;
+
+  for (int i = 0; i < 4; i++) {
+    if (p[i] >= '0' && p[i] <= '9') digit = p[i] - '0';
+    else if (p[i] >= 'a' && p[i] <= 'f') digit = p[i] - 'a' + 10;
+    else if (p[i] >= 'A' && p[i] <= 'F') digit = p[i] - 'A' + 10;
+    else return UINT32_MAX;
+    value = value << 4 | digit;
+  }
+
+  return value;
+}
+
+static size_t qtb_jsonl_put_utf8(char *to, uint32_t code_point) {
+  if (code_point < 0x80) {
+    to[0] = (char)code_point;
+    return 1;
+  }
+  if (code_point < 0x800) {
+    to[0] = (char)(0xc0 | code_point >> 6);
+    to[1] = (char)(0x80 | (code_point & 0x3f));
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    to[0] = (char)(0xe0 | code_point >> 12);
+    to[1] = (char)(0x80 | (code_point >> 6 & 0x3f));
+    to[2] = (char)(0x80 | (code_point & 0x3f));
+    return 3;
+  }
+  to[0] = (char)(0xf0 | code_point >> 18);
+  to[1] = (char)(0x80 | (code_point >> 12 & 0x3f));
+  to[2] = (char)(0x80 | (code_point >> 6 & 0x3f));
+  to[3] = (char)(0x80 | (code_point & 0x3f));
+  return 4;
+}
+
+// Decodes the escapes of the string body [start, close) into the worker's
+// scratch. No escape decodes to more bytes than it is written with.
+static Result qtb_jsonl_unescape(QtbReaderWorker *worker, const char *start, const char *close, const char **s, size_t *size) {
+  ResultCharPtr scratch;
+  char *to;
+  size_t n = 0;
+  uint32_t code_point;
+  unsigned low;
+
+  scratch = qtb_reader_scratch(worker, close - start);
+  if (ResultFailed(scratch)) return ResultFailureFromResult(scratch);
+  to = ResultValue(scratch);
+
+  for (const char *c = start; c < close; c++) {
+    if (*c != '\\') {
+      to[n++] = *c;
+      continue;
+    }
+
+    c++;
+    switch (*c) {
+      case '"': to[n++] = '"'; break;
+      case '\\': to[n++] = '\\'; break;
+      case '/': to[n++] = '/'; break;
+      case 'b': to[n++] = '\b'; break;
+      case 'f': to[n++] = '\f'; break;
+      case 'n': to[n++] = '\n'; break;
+      case 'r': to[n++] = '\r'; break;
+      case 't': to[n++] = '\t'; break;
+      case 'u':
+        if (close - c < 5 || (code_point = qtb_jsonl_hex(c + 1)) == UINT32_MAX)
+          return ResultFailure(PyExc_ValueError, "read_jsonl with invalid string escape");
+        c += 4;
+
+        // A high surrogate must be followed by an escaped low surrogate.
+        if (code_point >= 0xd800 && code_point < 0xdc00) {
+          if (close - c < 7 || c[1] != '\\' || c[2] != 'u' || (low = qtb_jsonl_hex(c + 3)) < 0xdc00 || low >= 0xe000)
+            return ResultFailure(PyExc_ValueError, "read_jsonl with invalid string escape");
+          code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+          c += 6;
+        } else if (code_point >= 0xdc00 && code_point < 0xe000) {
+          return ResultFailure(PyExc_ValueError, "read_jsonl with invalid string escape");
+        }
+
+        n += qtb_jsonl_put_utf8(&to[n], code_point);
+        break;
+      default:
+        return ResultFailure(PyExc_ValueError, "read_jsonl with invalid string escape");
+    }
+  }
+
+  *s = to;
+  *size = n;
+  return ResultSuccess();
+}
+
+// Reads the string at *p, which is at a quote, into *s and *size, pointing
+// straight into the input unless the string holds escapes.
+static Result qtb_jsonl_read_string(QtbReaderWorker *worker, const char **p, const char *end, const char **s, size_t *size) {
+  const char *start;
+  const char *q;
+  bool escaped = false;
+
+  start = *p + 1;
+  for (q = start; q < end && *q != '"'; q++) {
+    if (*q == '\\') {
+      escaped = true;
+      q++;
+    }
+  }
+  if (q >= end) return ResultFailure(PyExc_ValueError, "read_jsonl with unterminated string");
+
+  *p = q + 1;
+
+  if (!escaped) {
+    *s = start;
+    *size = q - start;
+    return ResultSuccess();
+  }
+
+  return qtb_jsonl_unescape(worker, start, q, s, size);
+}
+
+// Skips the value at *p, nested or not, without decoding it.
+static Result qtb_jsonl_skip_value(const char **p, const char *end) {
+  const char *q = *p;
+  size_t depth = 0;
+
+  do {
+    if (q >= end) return ResultFailure(PyExc_ValueError, "read_jsonl with malformed line");
+
+    if (*q == '"') {
+      for (q++; q < end && *q != '"'; q++)
+        if (*q == '\\') q++;
+      if (q >= end) return ResultFailure(PyExc_ValueError, "read_jsonl with unterminated string");
+      q++;
+    } else if (*q == '{' || *q == '[') {
+      depth++;
+      q++;
+    } else if (*q == '}' || *q == ']') {
+      if (depth == 0) return ResultFailure(PyExc_ValueError, "read_jsonl with malformed line");
+      depth--;
+      q++;
+    } else if (depth > 0) {
+      q++;
+    } else {
+      // A number or a literal ends at the next separator.
+      while (q < end && *q != ',' && *q != '}' && *q != ']' && !qtb_jsonl_is_space(*q)) q++;
+      if (q == *p) return ResultFailure(PyExc_ValueError, "read_jsonl with malformed line");
+    }
+  } while (depth > 0);
+
+  *p = q;
+  return ResultSuccess();
+}
+
+static bool qtb_jsonl_is_numeric(QtbColumnType type) {
+  return type != QTB_COLUMN_TYPE_STR && type != QTB_COLUMN_TYPE_BOOL && type != QTB_COLUMN_TYPE_CATEGORY;
+}
+
+// Appends the value at *p to column. Strings go to str and category columns,
+// true and false to bool columns and numbers to int and float columns, each
+// parsed as its text would be in a CSV field.
+static Result qtb_jsonl_read_value(QtbReaderWorker *worker, QtbColumn *column, const char **p, const char *end) {
+  const char *s = *p;
+  size_t size;
+  Result result;
+
+  if (*s == '"') {
+    if (column->type != QTB_COLUMN_TYPE_STR && column->type != QTB_COLUMN_TYPE_CATEGORY)
+      return ResultFailure(PyExc_TypeError, "read_jsonl with string for non-str column");
+
+    result = qtb_jsonl_read_string(worker, p, end, &s, &size);
+    if (ResultFailed(result)) return result;
+    if (!qtb_utf8_valid(s, size)) return ResultFailure(PyExc_ValueError, "read_jsonl with invalid UTF-8");
+    return qtb_column_append_string(column, s, size);
+  }
+
+  if (*s == '{' || *s == '[')
+    return ResultFailure(PyExc_TypeError, "read_jsonl with nested value");
+
+  while (*p < end && **p != ',' && **p != '}' && !qtb_jsonl_is_space(**p)) (*p)++;
+  size = *p - s;
+
+  if (size == 4 && memcmp(s, "null", 4) == 0) {
+    if (!column->nullable) return ResultFailure(PyExc_TypeError, "read_jsonl with null for non-nullable column");
+    return qtb_column_append_none(column);
+  }
+
+  if ((size == 4 && memcmp(s, "true", 4) == 0) || (size == 5 && memcmp(s, "false", 5) == 0)) {
+    if (column->type != QTB_COLUMN_TYPE_BOOL) return ResultFailure(PyExc_TypeError, "read_jsonl with bool for non-bool column");
+    return qtb_column_append_string(column, s, size);
+  }
+
+  if (size == 0) return ResultFailure(PyExc_ValueError, "read_jsonl with malformed line");
+  if (!qtb_jsonl_is_numeric(column->type))
+    return ResultFailure(PyExc_TypeError, "read_jsonl with number for non-number column");
+
+  return qtb_column_append_string(column, s, size);
+}
+
+// Returns the column named by the key [s, s + size), or -1. Keys usually
+// come in the same order on every line, so the column after the last one
+// found is tried first.
+static Py_ssize_t qtb_jsonl_find_column(QtbReaderWorker *worker, const char *s, size_t size, Py_ssize_t hint) {
+  const char *name;
+
+  for (Py_ssize_t k = 0; k < worker->width; k++) {
+    Py_ssize_t i = (hint + k) % worker->width;
+
+    name = worker->columns[i].name;
+    if (strlen(name) == size && memcmp(name, s, size) == 0) return i;
+  }
+
+  return -1;
+}
+
+static Result qtb_jsonl_parse_line(QtbReaderWorker *worker, const char *p, const char *end, bool *seen) {
+  const char *key;
+  size_t key_size;
+  Py_ssize_t i;
+  Py_ssize_t hint = 0;
+  Result result;
+
+  memset(seen, 0, worker->width * sizeof(bool));
+
+  if (*p != '{') return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with non-object line"), -1);
+  p = qtb_jsonl_skip_space(p + 1, end);
+
+  if (p < end && *p == '}') {
+    p++;
+  } else {
+    for (;;) {
+      if (p >= end || *p != '"') return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with malformed line"), -1);
+
+      result = qtb_jsonl_read_string(worker, &p, end, &key, &key_size);
+      if (ResultFailed(result)) return qtb_reader_fail(worker, result, -1);
+
+      p = qtb_jsonl_skip_space(p, end);
+      if (p >= end || *p != ':') return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with malformed line"), -1);
+      p = qtb_jsonl_skip_space(p + 1, end);
+      if (p >= end) return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with malformed line"), -1);
+
+      i = worker->width > 0 ? qtb_jsonl_find_column(worker, key, key_size, hint) : -1;
+      if (i < 0) {
+        result = qtb_jsonl_skip_value(&p, end);
+        if (ResultFailed(result)) return qtb_reader_fail(worker, result, -1);
+      } else {
+        if (seen[i]) return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with duplicate key"), i);
+        seen[i] = true;
+        hint = i + 1;
+
+        result = qtb_jsonl_read_value(worker, &worker->columns[i], &p, end);
+        if (ResultFailed(result)) return qtb_reader_fail(worker, result, i);
+      }
+
+      p = qtb_jsonl_skip_space(p, end);
+      if (p < end && *p == ',') {
+        p = qtb_jsonl_skip_space(p + 1, end);
+        continue;
+      }
+      if (p < end && *p == '}') {
+        p++;
+        break;
+      }
+      return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with malformed line"), -1);
+    }
+  }
+
+  if (qtb_jsonl_skip_space(p, end) != end)
+    return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with malformed line"), -1);
+
+  for (i = 0; i < worker->width; i++) {
+    if (seen[i]) continue;
+    if (!worker->columns[i].nullable)
+      return qtb_reader_fail(worker, ResultFailure(PyExc_ValueError, "read_jsonl with missing key"), i);
+
+    result = qtb_column_append_none(&worker->columns[i]);
+    if (ResultFailed(result)) return qtb_reader_fail(worker, result, i);
+  }
+
+  return ResultSuccess();
+}
+
+static Result qtb_jsonl_worker_parse(QtbReaderWorker *worker) {
+  const char *p;
+  const char *line_end;
+  bool *seen;
+  Result result = ResultSuccess();
+
+  seen = (bool *)malloc(worker->width > 0 ? worker->width * sizeof(bool) : 1);
+  if (seen == NULL) return qtb_reader_fail(worker, ResultFailure(PyExc_MemoryError, "memory error"), -1);
+
+  for (p = worker->begin; p < worker->end; p = line_end + 1) {
+    line_end = (const char *)memchr(p, '\n', worker->end - p);
+    if (line_end == NULL) line_end = worker->end;
+
+    // Blank lines are skipped.
+    p = qtb_jsonl_skip_space(p, line_end);
+    if (p == line_end) continue;
+
+    result = qtb_jsonl_parse_line(worker, p, line_end, seen);
+    if (ResultFailed(result)) break;
+
+    worker->rows++;
+  }
+
+  free(seen);
+  return result;
+}
+
+// Appends the lines of a JSON Lines file to table; see qtb_reader_read_into_.
+Result qtb_jsonl_read_into_(QtbTable *table, const char *path, QtbJsonlOptions *options) {
+  QtbReader reader = {NULL, &qtb_jsonl_split, &qtb_jsonl_worker_parse, options, options->n_threads};
+
+  return qtb_reader_read_into_(table, path, &reader);
+}
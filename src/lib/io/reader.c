@@ -0,0 +1,261 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "reader.h"
+#include "result.h"
+
+typedef struct {
+  QtbReaderWorker *worker;
+  Result (*parse)(QtbReaderWorker *);
+} QtbReaderThread;
+
+Result qtb_reader_fail(QtbReaderWorker *worker, Result result, Py_ssize_t column) {
+  worker->result = result;
+  worker->failed_column = column;
+  return result;
+}
+
+// Returns a worker buffer of at least size bytes, kept across fields.
+ResultCharPtr qtb_reader_scratch(QtbReaderWorker *worker, size_t size) {
+  char *scratch;
+
+  if (worker->scratch_capacity < size) {
+    scratch = (char *)realloc(worker->scratch, size);
+    if (scratch == NULL) return ResultCharPtrFailure(PyExc_MemoryError, "memory error");
+    worker->scratch = scratch;
+    worker->scratch_capacity = size;
+  }
+
+  return ResultCharPtrSuccess(worker->scratch);
+}
+
+static void *qtb_reader_thread_run(void *thread) {
+  QtbReaderThread *t = (QtbReaderThread *)thread;
+
+  t->parse(t->worker);
+  return NULL;
+}
+
+static size_t qtb_reader_n_threads(QtbReader *reader, size_t size) {
+  size_t n;
+  long cpus;
+
+  n = reader->n_threads;
+  if (n == 0) {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    n = MIN(cpus > 0 ? (size_t)cpus : 1, 1 + size / QTB_READER_MIN_BYTES_PER_THREAD);
+  }
+
+  return MIN(n, QTB_READER_MAX_THREADS);
+}
+
+static void qtb_reader_workers_dealloc(QtbReaderWorker *workers, size_t n) {
+  for (size_t k = 0; k < n; k++) {
+    for (Py_ssize_t i = 0; i < workers[k].width; i++)
+      qtb_column_dealloc(&workers[k].columns[i]);
+    free(workers[k].columns);
+    free(workers[k].scratch);
+  }
+}
+
+// Worker columns take their name and type from the table's and use the libc
+// allocator, the only one that is safe to use from several threads. The
+// table's own columns are left alone while the GIL is released, as other
+// threads may still be reading them.
+static Result qtb_reader_worker_init(QtbReaderWorker *worker, QtbTable *table) {
+  ResultQtbColumnPtr columns;
+  Result result;
+
+  worker->width = 0;
+  worker->columns = NULL;
+  worker->scratch = NULL;
+  worker->scratch_capacity = 0;
+  worker->rows = 0;
+  worker->result = ResultSuccess();
+  worker->failed_column = -1;
+
+  columns = _qtb_column_new_many((size_t)(table->width > 0 ? table->width : 1), &malloc);
+  if (ResultFailed(columns)) return ResultFailureFromResult(columns);
+  worker->columns = ResultValue(columns);
+  worker->width = table->width;
+
+  for (Py_ssize_t i = 0; i < table->width; i++) {
+    result = qtb_column_init_like(&worker->columns[i], &table->columns[i]);
+    if (ResultFailed(result)) {
+      worker->width = i;
+      return result;
+    }
+  }
+
+  return ResultSuccess();
+}
+
+static void qtb_reader_run_workers(QtbReaderWorker *workers, size_t n, Result (*parse)(QtbReaderWorker *)) {
+  pthread_t threads[QTB_READER_MAX_THREADS];
+  QtbReaderThread runs[QTB_READER_MAX_THREADS];
+  bool started[QTB_READER_MAX_THREADS];
+
+  for (size_t k = 0; k < n; k++) runs[k] = (QtbReaderThread){&workers[k], parse};
+
+  // The calling thread takes the first run itself. A thread that fails to
+  // start has its run parsed here as well.
+  for (size_t k = 1; k < n; k++)
+    started[k] = pthread_create(&threads[k], NULL, &qtb_reader_thread_run, &runs[k]) == 0;
+
+  qtb_reader_thread_run(&runs[0]);
+
+  for (size_t k = 1; k < n; k++) {
+    if (started[k]) pthread_join(threads[k], NULL);
+    else qtb_reader_thread_run(&runs[k]);
+  }
+}
+
+// Raises the first failure, in file order, with the table row and column it
+// happened at.
+static Result qtb_reader_raise_failure(QtbTable *table, QtbReaderWorker *workers, size_t n) {
+  size_t row;
+  QtbReaderWorker *worker;
+  ResultErrorNew error;
+
+  row = (size_t)table->size;
+  for (size_t k = 0; k < n; k++) {
+    worker = &workers[k];
+    if (ResultSuccessful(worker->result)) {
+      row += worker->rows;
+      continue;
+    }
+
+    error = worker->result.value.error.value.new;
+    row += worker->rows;
+    if (worker->failed_column < 0)
+      PyErr_Format(error.py_err_class, "%s (row %zu)", error.message, row);
+    else
+      PyErr_Format(error.py_err_class, "%s (row %zu, column '%s')", error.message, row, table->columns[worker->failed_column].name);
+    break;
+  }
+
+  return ResultFailureFromPyErr();
+}
+
+// An empty table on the libc allocator takes the first worker's columns as
+// they are instead of copying them, leaving the worker its empty columns.
+static void qtb_reader_adopt_first(QtbTable *table, QtbReaderWorker *worker) {
+  QtbColumn column;
+
+  if (table->size != 0 || table->allocator != &qtb_allocator_default) return;
+
+  for (Py_ssize_t i = 0; i < table->width; i++) {
+    column = table->columns[i];
+    table->columns[i] = worker->columns[i];
+    worker->columns[i] = column;
+  }
+}
+
+static Result qtb_reader_parse(QtbTable *table, const char *begin, const char *end, QtbReader *reader) {
+  const char *bounds[QTB_READER_MAX_THREADS + 1];
+  QtbReaderWorker workers[QTB_READER_MAX_THREADS];
+  size_t n;
+  size_t n_init;
+  size_t total;
+  Result result = ResultSuccess();
+
+  n = reader->split(begin, end, qtb_reader_n_threads(reader, end - begin), bounds, reader->options);
+
+  for (n_init = 0; n_init < n; n_init++) {
+    workers[n_init].begin = bounds[n_init];
+    workers[n_init].end = bounds[n_init + 1];
+    workers[n_init].options = reader->options;
+
+    result = qtb_reader_worker_init(&workers[n_init], table);
+    if (ResultFailed(result)) {
+      n_init++;
+      break;
+    }
+  }
+
+  if (ResultFailed(result)) {
+    qtb_reader_workers_dealloc(workers, n_init);
+    return result;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  qtb_reader_run_workers(workers, n, reader->parse);
+  Py_END_ALLOW_THREADS
+
+  total = 0;
+  for (size_t k = 0; k < n; k++) {
+    if (ResultFailed(workers[k].result)) {
+      result = qtb_reader_raise_failure(table, workers, n);
+      break;
+    }
+    total += workers[k].rows;
+  }
+
+  if (ResultSuccessful(result)) qtb_reader_adopt_first(table, &workers[0]);
+  if (ResultSuccessful(result)) result = qtb_table_reserve_(table, table->size + total);
+
+  for (Py_ssize_t i = 0; i < table->width && ResultSuccessful(result); i++) {
+    for (size_t k = 0; k < n; k++) {
+      result = qtb_column_append_column(&table->columns[i], &workers[k].columns[i]);
+      if (ResultFailed(result)) break;
+    }
+  }
+
+  if (ResultSuccessful(result)) result = qtb_table_commit_rows_(table, (Py_ssize_t)total);
+  if (ResultFailed(result)) qtb_table_truncate_columns(table);
+
+  qtb_reader_workers_dealloc(workers, n);
+  return result;
+}
+
+// Appends the records of a text file to table, whose blueprint gives each
+// field's column and type. The file is mapped and split into runs of whole
+// records that are parsed on separate threads with the GIL released, then
+// stitched onto the table in file order. Either every record is appended or
+// none are.
+Result qtb_reader_read_into_(QtbTable *table, const char *path, QtbReader *reader) {
+  int fd;
+  struct stat st;
+  char *data;
+  const char *begin;
+  Result result;
+
+  fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    return ResultFailureFromPyErr();
+  }
+
+  if (fstat(fd, &st) == -1) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    close(fd);
+    return ResultFailureFromPyErr();
+  }
+
+  if (st.st_size == 0) {
+    close(fd);
+    return ResultSuccess();
+  }
+
+  data = (char *)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    close(fd);
+    return ResultFailureFromPyErr();
+  }
+  madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+  begin = data;
+  if (reader->skip_header != NULL) begin = reader->skip_header(begin, data + st.st_size, reader->options);
+
+  result = qtb_reader_parse(table, begin, data + st.st_size, reader);
+
+  munmap(data, (size_t)st.st_size);
+  close(fd);
+  return result;
+}
@@ -0,0 +1,727 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "table_file.h"
+#include "allocator.h"
+#include "column.h"
+#include "result.h"
+
+// ===== save =====
+
+// Blocks are written through one buffer, flushed with the GIL released. Full
+// chunks are larger than the buffer and are written straight from the table.
+typedef struct {
+  char *data;
+  size_t size;
+  size_t capacity;
+
+  // Bytes of the file written before data
+  uint64_t flushed;
+  int fd;
+  const char *path;
+} QtbTableFileWriter;
+
+static Result qtb_table_file_write_out(QtbTableFileWriter *writer, const char *data, size_t size) {
+  ssize_t n;
+  size_t done = 0;
+  int error = 0;
+
+  Py_BEGIN_ALLOW_THREADS
+  while (done < size) {
+    n = write(writer->fd, data + done, size - done);
+    if (n == -1 && errno == EINTR) continue;
+    if (n == -1) {
+      error = errno;
+      break;
+    }
+    done += (size_t)n;
+  }
+  Py_END_ALLOW_THREADS
+
+  if (error != 0) {
+    errno = error;
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, writer->path);
+    return ResultFailureFromPyErr();
+  }
+
+  writer->flushed += size;
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_flush(QtbTableFileWriter *writer) {
+  Result result;
+
+  result = qtb_table_file_write_out(writer, writer->data, writer->size);
+  if (ResultFailed(result)) return result;
+
+  writer->size = 0;
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_write(QtbTableFileWriter *writer, const void *data, size_t size) {
+  Result result;
+
+  if (writer->capacity - writer->size < size) {
+    result = qtb_table_file_flush(writer);
+    if (ResultFailed(result)) return result;
+    if (size >= writer->capacity) return qtb_table_file_write_out(writer, (const char *)data, size);
+  }
+
+  memcpy(writer->data + writer->size, data, size);
+  writer->size += size;
+  return ResultSuccess();
+}
+
+// Pads the file so that the block's bytes, which the caller writes next,
+// start aligned, and writes their header. *offset is set to where they start.
+static Result qtb_table_file_begin_block(QtbTableFileWriter *writer, size_t size, uint64_t *offset) {
+  static const char zeros[QTB_TABLE_FILE_ALIGNMENT];
+  QtbAllocationHeader header = {size, 0};
+  uint64_t position;
+  size_t padding;
+  Result result;
+
+  position = writer->flushed + writer->size + sizeof(QtbAllocationHeader);
+  padding = (QTB_TABLE_FILE_ALIGNMENT - position % QTB_TABLE_FILE_ALIGNMENT) % QTB_TABLE_FILE_ALIGNMENT;
+
+  result = qtb_table_file_write(writer, zeros, padding);
+  if (ResultFailed(result)) return result;
+
+  result = qtb_table_file_write(writer, &header, sizeof(QtbAllocationHeader));
+  if (ResultFailed(result)) return result;
+
+  *offset = position + padding;
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_write_block(QtbTableFileWriter *writer, const void *data, size_t size, uint64_t *offset) {
+  Result result;
+
+  result = qtb_table_file_begin_block(writer, size, offset);
+  if (ResultFailed(result)) return result;
+
+  return qtb_table_file_write(writer, data, size);
+}
+
+// Long str values and category values are packed into heap blocks in order,
+// a block being closed once the next value would take its offsets past
+// UINT32_MAX. Values are placed twice, once to size the blocks and once to
+// write them, and then a third time for str cells to point at them.
+typedef struct {
+  uint64_t *sizes;
+  uint64_t *offsets;
+  size_t n_blocks;
+  QtbArenaSlot next;
+
+  // Blocks begun and bytes written to the last of them
+  size_t begun;
+  size_t written;
+} QtbTableFileHeap;
+
+static QtbArenaSlot qtb_table_file_heap_place(QtbTableFileHeap *heap, size_t size) {
+  QtbArenaSlot slot;
+
+  if ((uint64_t)heap->next.offset + size > UINT32_MAX) heap->next = (QtbArenaSlot){heap->next.block + 1, 0};
+
+  slot = heap->next;
+  heap->next.offset += (uint32_t)size;
+  return slot;
+}
+
+// Value i of a str column is its i-th cell, if long; of a category column
+// the i-th value of its dictionary.
+static size_t qtb_table_file_heap_values(QtbColumn *column) {
+  return column->type == QTB_COLUMN_TYPE_STR ? column->size : column->dictionary.size;
+}
+
+static bool qtb_table_file_heap_value(QtbColumn *column, size_t i, const char **s, size_t *size) {
+  if (column->type == QTB_COLUMN_TYPE_CATEGORY) {
+    *s = qtb_dictionary_value_at(&column->dictionary, i);
+    *size = qtb_dictionary_value_size_at(&column->dictionary, i);
+    return true;
+  }
+
+  *size = qtb_column_str_size_at(column, i);
+  if (*size <= QTB_COLUMN_STR_INLINE_SIZE) return false;
+
+  *s = qtb_column_str_at(column, i);
+  return true;
+}
+
+// Blocks hold at least one byte, so that every block starts inside the file
+// even when all values are empty.
+static Result qtb_table_file_size_heap(QtbTableFileHeap *heap, QtbColumn *column) {
+  uint64_t *sizes;
+  QtbArenaSlot slot;
+  const char *s;
+  size_t size;
+
+  for (size_t i = 0; i < qtb_table_file_heap_values(column); i++) {
+    if (!qtb_table_file_heap_value(column, i, &s, &size)) continue;
+
+    slot = qtb_table_file_heap_place(heap, size);
+    if (slot.block == heap->n_blocks) {
+      sizes = (uint64_t *)realloc(heap->sizes, (heap->n_blocks + 1) * sizeof(uint64_t));
+      if (sizes == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+      heap->sizes = sizes;
+      heap->sizes[heap->n_blocks++] = 1;
+    }
+
+    heap->sizes[slot.block] = MAX(heap->sizes[slot.block], (uint64_t)slot.offset + size);
+  }
+
+  heap->offsets = (uint64_t *)calloc(MAX(heap->n_blocks, 1), sizeof(uint64_t));
+  if (heap->offsets == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  heap->next = (QtbArenaSlot){0, 0};
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_finish_heap_block(QtbTableFileWriter *writer, QtbTableFileHeap *heap, size_t block) {
+  static const char zeros[1];
+
+  if (heap->written == heap->sizes[block]) return ResultSuccess();
+
+  return qtb_table_file_write(writer, zeros, heap->sizes[block] - heap->written);
+}
+
+static Result qtb_table_file_write_heap(QtbTableFileWriter *writer, QtbTableFileHeap *heap, QtbColumn *column) {
+  QtbArenaSlot slot;
+  const char *s;
+  size_t size;
+  Result result;
+
+  for (size_t i = 0; i < qtb_table_file_heap_values(column); i++) {
+    if (!qtb_table_file_heap_value(column, i, &s, &size)) continue;
+
+    slot = qtb_table_file_heap_place(heap, size);
+    if (slot.block == heap->begun) {
+      if (heap->begun > 0) {
+        result = qtb_table_file_finish_heap_block(writer, heap, slot.block - 1);
+        if (ResultFailed(result)) return result;
+      }
+
+      result = qtb_table_file_begin_block(writer, heap->sizes[slot.block], &heap->offsets[slot.block]);
+      if (ResultFailed(result)) return result;
+      heap->begun++;
+      heap->written = 0;
+    }
+
+    result = qtb_table_file_write(writer, s, size);
+    if (ResultFailed(result)) return result;
+    heap->written += size;
+  }
+
+  if (heap->n_blocks > 0) {
+    result = qtb_table_file_finish_heap_block(writer, heap, heap->n_blocks - 1);
+    if (ResultFailed(result)) return result;
+  }
+
+  heap->next = (QtbArenaSlot){0, 0};
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_write_str_cells(QtbTableFileWriter *writer, QtbTableFileHeap *heap, QtbColumn *column, size_t chunk) {
+  QtbColumnStr cell;
+  size_t start;
+  size_t rows;
+  Result result;
+
+  start = chunk * QTB_COLUMN_CHUNK_SIZE;
+  rows = qtb_column_chunk_rows(column, chunk);
+  for (size_t i = start; i < start + rows; i++) {
+    cell = *qtb_column_str_cell(column, i);
+    if (cell.size > QTB_COLUMN_STR_INLINE_SIZE) cell.value.ref.slot = qtb_table_file_heap_place(heap, cell.size);
+
+    result = qtb_table_file_write(writer, &cell, sizeof(QtbColumnStr));
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_write_entries(QtbTableFileWriter *writer, QtbTableFileHeap *heap, QtbDictionary *dictionary, uint64_t *offset) {
+  QtbDictionaryEntry entry;
+  Result result;
+
+  result = qtb_table_file_begin_block(writer, dictionary->size * sizeof(QtbDictionaryEntry), offset);
+  if (ResultFailed(result)) return result;
+
+  // Entries are copied field by field so that their padding is written as
+  // zeros.
+  for (size_t code = 0; code < dictionary->size; code++) {
+    memset(&entry, 0, sizeof(QtbDictionaryEntry));
+    entry.size = dictionary->entries[code].size;
+    entry.slot = qtb_table_file_heap_place(heap, entry.size);
+    entry.hash = dictionary->entries[code].hash;
+
+    result = qtb_table_file_write(writer, &entry, sizeof(QtbDictionaryEntry));
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+// Compressed chunks are stored plain, decoded one at a time.
+static Result qtb_table_file_write_decoded(QtbTableFileWriter *writer, QtbColumn *column, size_t chunk, uint64_t *offset) {
+  size_t size;
+  char *data;
+  Result result;
+
+  size = qtb_column_data_size(column->type, QTB_COLUMN_CHUNK_SIZE);
+  data = (char *)malloc(size);
+  if (data == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  qtb_column_decode_chunk(column, chunk, data);
+  result = qtb_table_file_write_block(writer, data, size, offset);
+  free(data);
+  return result;
+}
+
+static Result qtb_table_file_write_chunks(QtbTableFileWriter *writer, QtbTableFileHeap *heap, QtbColumn *column, QtbTableFileColumn *record) {
+  uint64_t *offsets;
+  size_t n_chunks;
+  size_t rows;
+  Result result = ResultSuccess();
+
+  n_chunks = qtb_column_chunk_of(column->size + QTB_COLUMN_CHUNK_MASK);
+  if (n_chunks == 0) return ResultSuccess();
+
+  offsets = (uint64_t *)calloc(2 * n_chunks, sizeof(uint64_t));
+  if (offsets == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  for (size_t chunk = 0; chunk < n_chunks && ResultSuccessful(result); chunk++) {
+    rows = qtb_column_chunk_rows(column, chunk);
+
+    if (column->type == QTB_COLUMN_TYPE_STR) {
+      result = qtb_table_file_begin_block(writer, qtb_column_data_size(column->type, rows), &offsets[2 * chunk]);
+      if (ResultSuccessful(result)) result = qtb_table_file_write_str_cells(writer, heap, column, chunk);
+    } else if (column->chunks[chunk].encoded != NULL) {
+      result = qtb_table_file_write_decoded(writer, column, chunk, &offsets[2 * chunk]);
+    } else {
+      result = qtb_table_file_write_block(writer, column->chunks[chunk].data, qtb_column_data_size(column->type, rows), &offsets[2 * chunk]);
+    }
+
+    if (ResultSuccessful(result) && column->nullable)
+      result = qtb_table_file_write_block(writer, column->chunks[chunk].validity, qtb_column_validity_size(rows), &offsets[2 * chunk + 1]);
+  }
+
+  if (ResultSuccessful(result)) result = qtb_table_file_write_block(writer, offsets, 2 * n_chunks * sizeof(uint64_t), &record->chunks);
+
+  free(offsets);
+  return result;
+}
+
+static Result qtb_table_file_write_column(QtbTableFileWriter *writer, QtbColumn *column, QtbTableFileColumn *record) {
+  QtbTableFileHeap heap = {NULL, NULL, 0, {0, 0}, 0, 0};
+  const char *type;
+  Result result;
+
+  result = qtb_table_file_write_block(writer, column->name, strlen(column->name) + 1, &record->name);
+  if (ResultFailed(result)) return result;
+
+  type = qtb_column_type_as_string(column);
+  result = qtb_table_file_write_block(writer, type, strlen(type) + 1, &record->type);
+  if (ResultFailed(result)) return result;
+
+  if (column->type == QTB_COLUMN_TYPE_STR || column->type == QTB_COLUMN_TYPE_CATEGORY) {
+    result = qtb_table_file_size_heap(&heap, column);
+    if (ResultSuccessful(result)) result = qtb_table_file_write_heap(writer, &heap, column);
+    if (ResultSuccessful(result) && heap.n_blocks > 0)
+      result = qtb_table_file_write_block(writer, heap.offsets, heap.n_blocks * sizeof(uint64_t), &record->heap);
+    record->n_heap = heap.n_blocks;
+  }
+
+  if (ResultSuccessful(result) && column->type == QTB_COLUMN_TYPE_CATEGORY && column->dictionary.size > 0) {
+    result = qtb_table_file_write_entries(writer, &heap, &column->dictionary, &record->entries);
+    record->dictionary_size = column->dictionary.size;
+  }
+
+  if (ResultSuccessful(result)) result = qtb_table_file_write_chunks(writer, &heap, column, record);
+
+  free(heap.sizes);
+  free(heap.offsets);
+  return result;
+}
+
+static Result qtb_table_file_pwrite(QtbTableFileWriter *writer, const void *data, size_t size, off_t offset) {
+  ssize_t n;
+  size_t done = 0;
+
+  while (done < size) {
+    n = pwrite(writer->fd, (const char *)data + done, size - done, offset + (off_t)done);
+    if (n == -1 && errno == EINTR) continue;
+    if (n == -1) {
+      PyErr_SetFromErrnoWithFilename(PyExc_OSError, writer->path);
+      return ResultFailureFromPyErr();
+    }
+    done += (size_t)n;
+  }
+
+  return ResultSuccess();
+}
+
+// The header and column records are written last, over zeros reserved for
+// them, once the offsets of all blocks are known.
+static Result qtb_table_file_write_table(QtbTableFileWriter *writer, QtbTable *table, QtbTableFileColumn *records) {
+  QtbTableFileHeader header;
+  Result result;
+
+  memset(&header, 0, sizeof(QtbTableFileHeader));
+  result = qtb_table_file_write(writer, &header, sizeof(QtbTableFileHeader));
+  if (ResultFailed(result)) return result;
+
+  result = qtb_table_file_write(writer, records, (size_t)table->width * sizeof(QtbTableFileColumn));
+  if (ResultFailed(result)) return result;
+
+  for (Py_ssize_t i = 0; i < table->width; i++) {
+    result = qtb_table_file_write_column(writer, &table->columns[i], &records[i]);
+    if (ResultFailed(result)) return result;
+  }
+
+  result = qtb_table_file_flush(writer);
+  if (ResultFailed(result)) return result;
+
+  memcpy(header.magic, QTB_TABLE_FILE_MAGIC, sizeof(header.magic));
+  header.version = QTB_TABLE_FILE_VERSION;
+  header.byte_order = QTB_TABLE_FILE_BYTE_ORDER;
+  header.size = (uint64_t)table->size;
+  header.width = (uint64_t)table->width;
+  header.chunk_size = QTB_COLUMN_CHUNK_SIZE;
+
+  result = qtb_table_file_pwrite(writer, records, (size_t)table->width * sizeof(QtbTableFileColumn), sizeof(QtbTableFileHeader));
+  if (ResultFailed(result)) return result;
+
+  return qtb_table_file_pwrite(writer, &header, sizeof(QtbTableFileHeader), 0);
+}
+
+// The table is pinned while it is written, as the GIL is released for
+// writes.
+Result qtb_table_file_save_(QtbTable *table, const char *path) {
+  QtbTableFileWriter writer = {NULL, 0, 0, 0, -1, path};
+  QtbTableFileColumn *records;
+  Result result;
+
+  records = (QtbTableFileColumn *)calloc(MAX(table->width, 1), sizeof(QtbTableFileColumn));
+  writer.data = (char *)malloc(QTB_TABLE_FILE_WRITE_BUFFER_SIZE);
+  if (records == NULL || writer.data == NULL) {
+    free(records);
+    free(writer.data);
+    return ResultFailure(PyExc_MemoryError, "memory error");
+  }
+  writer.capacity = QTB_TABLE_FILE_WRITE_BUFFER_SIZE;
+
+  writer.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (writer.fd == -1) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    result = ResultFailureFromPyErr();
+  } else {
+    table->exports++;
+    result = qtb_table_file_write_table(&writer, table, records);
+    table->exports--;
+  }
+
+  if (writer.fd != -1 && close(writer.fd) == -1 && ResultSuccessful(result)) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    result = ResultFailureFromPyErr();
+  }
+
+  free(records);
+  free(writer.data);
+  return result;
+}
+
+// ===== load =====
+
+static Result qtb_table_file_corrupt(void) {
+  return ResultFailure(PyExc_ValueError, "corrupt table file");
+}
+
+// Finds the block whose bytes start at offset, checking that it lies within
+// the image and holds at least min_size bytes.
+static Result qtb_table_file_block(QtbAllocator *allocator, uint64_t offset, size_t min_size, char **block, size_t *size) {
+  QtbAllocationHeader *header;
+
+  if (offset % QTB_TABLE_FILE_ALIGNMENT != 0 || offset < sizeof(QtbAllocationHeader) || offset >= allocator->image_size)
+    return qtb_table_file_corrupt();
+
+  header = qtb_allocation_header_of(allocator->image + offset);
+  if (header->size == 0 || header->size > allocator->image_size - offset || header->size < min_size)
+    return qtb_table_file_corrupt();
+
+  *block = allocator->image + offset;
+  if (size != NULL) *size = header->size;
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_string(QtbAllocator *allocator, uint64_t offset, char **s) {
+  size_t size;
+  Result result;
+
+  result = qtb_table_file_block(allocator, offset, 1, s, &size);
+  if (ResultFailed(result)) return result;
+  if (strnlen(*s, size) == size) return qtb_table_file_corrupt();
+
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_read_image(QtbAllocator *allocator, const char *path, bool mapped) {
+  struct stat st;
+  char *image;
+  size_t done = 0;
+  ssize_t n;
+  int fd;
+  int error = 0;
+
+  fd = open(path, O_RDONLY);
+  if (fd == -1 || fstat(fd, &st) == -1) {
+    error = errno;
+    if (fd != -1) close(fd);
+    errno = error;
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    return ResultFailureFromPyErr();
+  }
+
+  if ((size_t)st.st_size < sizeof(QtbTableFileHeader)) {
+    close(fd);
+    return ResultFailure(PyExc_ValueError, "not a table file");
+  }
+
+  if (mapped) {
+    image = (char *)mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (image == MAP_FAILED) error = errno;
+  } else {
+    image = (char *)malloc((size_t)st.st_size);
+    if (image == NULL) {
+      close(fd);
+      return ResultFailure(PyExc_MemoryError, "memory error");
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    while (done < (size_t)st.st_size) {
+      n = read(fd, image + done, (size_t)st.st_size - done);
+      if (n == -1 && errno == EINTR) continue;
+      if (n <= 0) {
+        error = n == 0 ? EIO : errno;
+        break;
+      }
+      done += (size_t)n;
+    }
+    Py_END_ALLOW_THREADS
+
+    if (error != 0) free(image);
+  }
+
+  close(fd);
+  if (error != 0) {
+    errno = error;
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+    return ResultFailureFromPyErr();
+  }
+
+  qtb_allocator_mapped_new(allocator, image, (size_t)st.st_size, mapped);
+  return ResultSuccess();
+}
+
+static Result qtb_table_file_check_header(QtbAllocator *allocator, QtbTableFileHeader *header) {
+  if (memcmp(header->magic, QTB_TABLE_FILE_MAGIC, sizeof(header->magic)) != 0)
+    return ResultFailure(PyExc_ValueError, "not a table file");
+  if (header->version != QTB_TABLE_FILE_VERSION)
+    return ResultFailure(PyExc_ValueError, "unsupported table file version");
+  if (header->byte_order != QTB_TABLE_FILE_BYTE_ORDER)
+    return ResultFailure(PyExc_ValueError, "table file has a different byte order");
+  if (header->chunk_size != QTB_COLUMN_CHUNK_SIZE)
+    return ResultFailure(PyExc_ValueError, "table file has a different chunk size");
+
+  if (header->width > (allocator->image_size - sizeof(QtbTableFileHeader)) / sizeof(QtbTableFileColumn) || header->size > PY_SSIZE_T_MAX)
+    return qtb_table_file_corrupt();
+
+  return ResultSuccess();
+}
+
+static ResultPyObjectPtr qtb_table_file_blueprint(QtbAllocator *allocator, QtbTableFileColumn *records, size_t width) {
+  PyObject *blueprint;
+  PyObject *descriptor;
+  char *name;
+  char *type;
+  Result result;
+
+  blueprint = PyList_New((Py_ssize_t)width);
+  if (blueprint == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  for (size_t i = 0; i < width; i++) {
+    result = qtb_table_file_string(allocator, records[i].name, &name);
+    if (ResultSuccessful(result)) result = qtb_table_file_string(allocator, records[i].type, &type);
+    if (ResultFailed(result)) {
+      Py_DECREF(blueprint);
+      return ResultPyObjectPtrFailureFromResult(result);
+    }
+
+    descriptor = Py_BuildValue("(ss)", name, type);
+    if (descriptor == NULL) {
+      Py_DECREF(blueprint);
+      return ResultPyObjectPtrFailureFromPyErr();
+    }
+    PyList_SET_ITEM(blueprint, (Py_ssize_t)i, descriptor);
+  }
+
+  return ResultPyObjectPtrSuccess(blueprint);
+}
+
+static Result qtb_table_file_adopt_heap(QtbAllocator *allocator, QtbArena *arena, QtbTableFileColumn *record) {
+  uint64_t *offsets;
+  char **blocks;
+  size_t *sizes;
+  Result result;
+
+  if (record->n_heap == 0) return ResultSuccess();
+  if (record->n_heap > allocator->image_size / sizeof(uint64_t)) return qtb_table_file_corrupt();
+
+  result = qtb_table_file_block(allocator, record->heap, record->n_heap * sizeof(uint64_t), (char **)&offsets, NULL);
+  if (ResultFailed(result)) return result;
+
+  blocks = (char **)malloc(record->n_heap * sizeof(char *));
+  sizes = (size_t *)malloc(record->n_heap * sizeof(size_t));
+  if (blocks == NULL || sizes == NULL) result = ResultFailure(PyExc_MemoryError, "memory error");
+
+  for (size_t i = 0; i < record->n_heap && ResultSuccessful(result); i++)
+    result = qtb_table_file_block(allocator, offsets[i], 1, &blocks[i], &sizes[i]);
+
+  if (ResultSuccessful(result)) result = qtb_arena_adopt_blocks(arena, blocks, sizes, record->n_heap);
+
+  free(blocks);
+  free(sizes);
+  return result;
+}
+
+static Result qtb_table_file_adopt_dictionary(QtbAllocator *allocator, QtbDictionary *dictionary, QtbTableFileColumn *record) {
+  QtbDictionaryEntry *entries;
+  QtbDictionaryEntry *entry;
+  Result result;
+
+  result = qtb_table_file_adopt_heap(allocator, &dictionary->arena, record);
+  if (ResultFailed(result) || record->dictionary_size == 0) return result;
+  if (record->dictionary_size > allocator->image_size / sizeof(QtbDictionaryEntry)) return qtb_table_file_corrupt();
+
+  result = qtb_table_file_block(allocator, record->entries, record->dictionary_size * sizeof(QtbDictionaryEntry), (char **)&entries, NULL);
+  if (ResultFailed(result)) return result;
+
+  // Values are read through their slots, so unlike cells those are checked.
+  for (size_t code = 0; code < record->dictionary_size; code++) {
+    entry = &entries[code];
+    if (entry->slot.block >= dictionary->arena.n_blocks) return qtb_table_file_corrupt();
+    if ((uint64_t)entry->slot.offset + entry->size > qtb_allocation_header_of(dictionary->arena.blocks[entry->slot.block])->size)
+      return qtb_table_file_corrupt();
+  }
+
+  return qtb_dictionary_adopt(dictionary, entries, record->dictionary_size);
+}
+
+static Result qtb_table_file_adopt_chunks(QtbAllocator *allocator, QtbColumn *column, QtbTableFileColumn *record, size_t size) {
+  QtbColumnChunk *chunks;
+  uint64_t *offsets;
+  size_t n_chunks;
+  size_t rows;
+  Result result;
+
+  n_chunks = qtb_column_chunk_of(size + QTB_COLUMN_CHUNK_MASK);
+  if (n_chunks == 0) return ResultSuccess();
+  if (n_chunks > allocator->image_size / (2 * sizeof(uint64_t))) return qtb_table_file_corrupt();
+
+  result = qtb_table_file_block(allocator, record->chunks, 2 * n_chunks * sizeof(uint64_t), (char **)&offsets, NULL);
+  if (ResultFailed(result)) return result;
+
+  chunks = (QtbColumnChunk *)calloc(n_chunks, sizeof(QtbColumnChunk));
+  if (chunks == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+
+  for (size_t chunk = 0; chunk < n_chunks && ResultSuccessful(result); chunk++) {
+    rows = MIN(size - chunk * QTB_COLUMN_CHUNK_SIZE, QTB_COLUMN_CHUNK_SIZE);
+
+    result = qtb_table_file_block(allocator, offsets[2 * chunk], qtb_column_data_size(column->type, rows), (char **)&chunks[chunk].data, NULL);
+    if (ResultSuccessful(result) && column->nullable)
+      result = qtb_table_file_block(allocator, offsets[2 * chunk + 1], qtb_column_validity_size(rows), (char **)&chunks[chunk].validity, NULL);
+  }
+
+  if (ResultSuccessful(result)) result = qtb_column_adopt_chunks(column, chunks, n_chunks, size);
+
+  free(chunks);
+  return result;
+}
+
+static Result qtb_table_file_adopt_column(QtbAllocator *allocator, QtbColumn *column, QtbTableFileColumn *record, size_t size) {
+  Result result = ResultSuccess();
+
+  if (column->type == QTB_COLUMN_TYPE_STR) result = qtb_table_file_adopt_heap(allocator, &column->arena, record);
+  else if (column->type == QTB_COLUMN_TYPE_CATEGORY) result = qtb_table_file_adopt_dictionary(allocator, &column->dictionary, record);
+  if (ResultFailed(result)) return result;
+
+  return qtb_table_file_adopt_chunks(allocator, column, record, size);
+}
+
+// Loads a table of the given type saved with qtb_table_file_save_. Its
+// columns are pointed at the file's blocks, which are only read as they are
+// used, and the image is released along with the table through its mapped
+// allocator. The layout is checked but cell contents are not, since that
+// would read every page: str slots and category codes are trusted, so only
+// files from trusted sources should be loaded.
+ResultPyObjectPtr qtb_table_file_load_(PyTypeObject *type, const char *path, bool mapped) {
+  QtbAllocator allocator;
+  QtbTableFileHeader *header;
+  QtbTableFileColumn *records;
+  ResultPyObjectPtr blueprint;
+  PyObject *no_args;
+  QtbTable *table;
+  Result result;
+
+  result = qtb_table_file_read_image(&allocator, path, mapped);
+  if (ResultFailed(result)) return ResultPyObjectPtrFailureFromResult(result);
+
+  header = (QtbTableFileHeader *)allocator.image;
+  records = (QtbTableFileColumn *)(allocator.image + sizeof(QtbTableFileHeader));
+
+  result = qtb_table_file_check_header(&allocator, header);
+  if (ResultFailed(result)) {
+    qtb_allocator_dealloc(&allocator);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  blueprint = qtb_table_file_blueprint(&allocator, records, (size_t)header->width);
+  if (ResultFailed(blueprint)) {
+    qtb_allocator_dealloc(&allocator);
+    return blueprint;
+  }
+
+  table = NULL;
+  if ((no_args = PyTuple_New(0)) != NULL) {
+    table = (QtbTable *)type->tp_new(type, no_args, NULL);
+    Py_DECREF(no_args);
+  }
+  if (table == NULL) {
+    Py_DECREF(ResultValue(blueprint));
+    qtb_allocator_dealloc(&allocator);
+    return ResultPyObjectPtrFailureFromPyErr();
+  }
+
+  // From here on the image belongs to the table.
+  table->owned_allocator = allocator;
+  table->allocator = &table->owned_allocator;
+
+  result = qtb_table_init_(table, ResultValue(blueprint));
+  Py_DECREF(ResultValue(blueprint));
+
+  for (Py_ssize_t i = 0; i < table->width && ResultSuccessful(result); i++)
+    result = qtb_table_file_adopt_column(table->allocator, &table->columns[i], &records[i], (size_t)header->size);
+
+  if (ResultFailed(result)) {
+    Py_DECREF(table);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  table->size = (Py_ssize_t)header->size;
+  return ResultPyObjectPtrSuccess((PyObject *)table);
+}
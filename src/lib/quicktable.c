@@ -1,13 +1,146 @@
 #include <Python.h>
+#include "table.h"
+#include "csv.h"
+#include "jsonl.h"
+#include "table_file.h"
 
 extern PyTypeObject QtbTableType;
+extern PyTypeObject QtbPoolType;
+extern PyTypeObject QtbColumnBufferType;
+extern PyTypeObject QtbTableIteratorType;
+extern PyTypeObject QtbColumnViewType;
+
+// Table(blueprint, capacity=capacity, allocator=allocator), for the readers.
+static PyObject *quicktable_new_table(PyObject *blueprint, Py_ssize_t capacity, PyObject *allocator) {
+  PyObject *table_args;
+  PyObject *table_kwargs;
+  PyObject *table = NULL;
+
+  table_args = PyTuple_Pack(1, blueprint);
+  table_kwargs = Py_BuildValue("{s:n,s:O}", "capacity", capacity, "allocator", allocator);
+  if (table_args != NULL && table_kwargs != NULL) table = PyObject_Call((PyObject *)&QtbTableType, table_args, table_kwargs);
+  Py_XDECREF(table_args);
+  Py_XDECREF(table_kwargs);
+
+  return table;
+}
+
+// read_csv(path, blueprint, *, delimiter=',', header=True, threads=0,
+// capacity=0, allocator=None); capacity and allocator are passed on to Table.
+static PyObject *quicktable_read_csv(PyObject *module, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"path", "blueprint", "delimiter", "header", "threads", "capacity", "allocator", NULL};
+  PyObject *path;
+  PyObject *blueprint;
+  PyObject *allocator = Py_None;
+  PyObject *table;
+  int delimiter = ',';
+  int header = 1;
+  Py_ssize_t threads = 0;
+  Py_ssize_t capacity = 0;
+  QtbCsvOptions options;
+  Result result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&O|$CpnnO", kwlist, &PyUnicode_FSConverter, &path, &blueprint, &delimiter, &header, &threads, &capacity, &allocator))
+    return NULL;
+
+  if (threads < 0 || delimiter > 127) {
+    Py_DECREF(path);
+    PyErr_SetString(PyExc_ValueError, threads < 0 ? "threads must be non-negative" : "invalid delimiter");
+    return NULL;
+  }
+
+  table = quicktable_new_table(blueprint, capacity, allocator);
+  if (table == NULL) {
+    Py_DECREF(path);
+    return NULL;
+  }
+
+  options = (QtbCsvOptions){(char)delimiter, header != 0, (size_t)threads};
+  result = qtb_csv_read_into_((QtbTable *)table, PyBytes_AS_STRING(path), &options);
+  Py_DECREF(path);
+  if (ResultFailed(result)) {
+    Py_DECREF(table);
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return table;
+}
+
+// read_jsonl(path, blueprint, *, threads=0, capacity=0, allocator=None);
+// each line is an object whose members named in the blueprint fill a row.
+static PyObject *quicktable_read_jsonl(PyObject *module, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"path", "blueprint", "threads", "capacity", "allocator", NULL};
+  PyObject *path;
+  PyObject *blueprint;
+  PyObject *allocator = Py_None;
+  PyObject *table;
+  Py_ssize_t threads = 0;
+  Py_ssize_t capacity = 0;
+  QtbJsonlOptions options;
+  Result result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&O|$nnO", kwlist, &PyUnicode_FSConverter, &path, &blueprint, &threads, &capacity, &allocator))
+    return NULL;
+
+  if (threads < 0) {
+    Py_DECREF(path);
+    PyErr_SetString(PyExc_ValueError, "threads must be non-negative");
+    return NULL;
+  }
+
+  table = quicktable_new_table(blueprint, capacity, allocator);
+  if (table == NULL) {
+    Py_DECREF(path);
+    return NULL;
+  }
+
+  options = (QtbJsonlOptions){(size_t)threads};
+  result = qtb_jsonl_read_into_((QtbTable *)table, PyBytes_AS_STRING(path), &options);
+  Py_DECREF(path);
+  if (ResultFailed(result)) {
+    Py_DECREF(table);
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return table;
+}
+
+// load(path, *, mmap=True); with mmap the file is mapped and its pages are
+// read as they are used, otherwise it is read whole.
+static PyObject *quicktable_load(PyObject *module, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"path", "mmap", NULL};
+  PyObject *path;
+  int mapped = 1;
+  ResultPyObjectPtr result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&|$p", kwlist, &PyUnicode_FSConverter, &path, &mapped))
+    return NULL;
+
+  result = qtb_table_file_load_(&QtbTableType, PyBytes_AS_STRING(path), mapped != 0);
+  Py_DECREF(path);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyMethodDef quicktable_methods[] = {
+  {"read_csv", (PyCFunction)quicktable_read_csv, METH_VARARGS | METH_KEYWORDS, "table read from a CSV file"},
+  {"read_jsonl", (PyCFunction)quicktable_read_jsonl, METH_VARARGS | METH_KEYWORDS, "table read from a JSON Lines file"},
+  {"load", (PyCFunction)quicktable_load, METH_VARARGS | METH_KEYWORDS, "table saved with Table.save"},
+  {NULL, NULL}
+};
 
 static PyModuleDef quicktable_module = {
   PyModuleDef_HEAD_INIT,
   "quicktable",
   "quicktable",
   -1,
-  NULL,
+  quicktable_methods,
   NULL,
   NULL,
   NULL,
@@ -18,6 +151,10 @@ PyMODINIT_FUNC PyInit_quicktable() {
   PyObject *module;
 
   if (PyType_Ready(&QtbTableType) < 0) return NULL;
+  if (PyType_Ready(&QtbPoolType) < 0) return NULL;
+  if (PyType_Ready(&QtbColumnBufferType) < 0) return NULL;
+  if (PyType_Ready(&QtbTableIteratorType) < 0) return NULL;
+  if (PyType_Ready(&QtbColumnViewType) < 0) return NULL;
 
   module = PyModule_Create(&quicktable_module);
   if (module == NULL) return NULL;
@@ -25,5 +162,16 @@ PyMODINIT_FUNC PyInit_quicktable() {
   Py_INCREF(&QtbTableType);
   if (PyModule_AddObject(module, "Table", (PyObject *)&QtbTableType) == -1) return NULL;
 
+  Py_INCREF(&QtbPoolType);
+  if (PyModule_AddObject(module, "Pool", (PyObject *)&QtbPoolType) == -1) return NULL;
+
+  Py_INCREF(&QtbColumnBufferType);
+  if (PyModule_AddObject(module, "ColumnBuffer", (PyObject *)&QtbColumnBufferType) == -1) return NULL;
+
+  Py_INCREF(&QtbColumnViewType);
+  if (PyModule_AddObject(module, "ColumnView", (PyObject *)&QtbColumnViewType) == -1) return NULL;
+
+  if (PyModule_AddIntConstant(module, "CHUNK_SIZE", QTB_COLUMN_CHUNK_SIZE) == -1) return NULL;
+
   return module;
 }
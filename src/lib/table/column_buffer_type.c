@@ -0,0 +1,165 @@
+#include <Python.h>
+#include "column_buffer.h"
+
+// struct module formats of the types whose cells are plain C numbers. bool is
+// bit-packed and str and category cells are references, so they have none.
+static const char *qtb_column_buffer_format(QtbColumnType type, Py_ssize_t *itemsize) {
+  switch (type) {
+    case QTB_COLUMN_TYPE_INT: *itemsize = sizeof(int64_t); return "q";
+    case QTB_COLUMN_TYPE_FLOAT: *itemsize = sizeof(double); return "d";
+    case QTB_COLUMN_TYPE_INT8: *itemsize = sizeof(int8_t); return "b";
+    case QTB_COLUMN_TYPE_INT16: *itemsize = sizeof(int16_t); return "h";
+    case QTB_COLUMN_TYPE_INT32: *itemsize = sizeof(int32_t); return "i";
+    case QTB_COLUMN_TYPE_UINT8: *itemsize = sizeof(uint8_t); return "B";
+    case QTB_COLUMN_TYPE_UINT16: *itemsize = sizeof(uint16_t); return "H";
+    case QTB_COLUMN_TYPE_UINT32: *itemsize = sizeof(uint32_t); return "I";
+    case QTB_COLUMN_TYPE_UINT64: *itemsize = sizeof(uint64_t); return "Q";
+    case QTB_COLUMN_TYPE_FLOAT32: *itemsize = sizeof(float); return "f";
+    default: return NULL;
+  }
+}
+
+ResultPyObjectPtr qtb_column_buffer_new_(QtbTable *table, size_t column, size_t chunk) {
+  QtbColumnBuffer *self;
+  const char *format;
+  Py_ssize_t itemsize;
+
+  format = qtb_column_buffer_format(table->columns[column].type, &itemsize);
+  if (format == NULL) return ResultPyObjectPtrFailure(PyExc_TypeError, "column_buffer of non-numeric column");
+
+  self = PyObject_New(QtbColumnBuffer, &QtbColumnBufferType);
+  if (self == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  Py_INCREF(table);
+  self->table = table;
+  self->column = column;
+  self->chunk = chunk;
+  self->format = format;
+  self->itemsize = itemsize;
+  self->shape = 0;
+  self->strides = itemsize;
+
+  return ResultPyObjectPtrSuccess((PyObject *)self);
+}
+
+static void qtb_column_buffer_dealloc(QtbColumnBuffer *self) {
+  Py_DECREF(self->table);
+  PyObject_Free(self);
+}
+
+// Rows of the chunk the table holds now. Rows popped since the buffer was
+// made are not exported, so the chunk may well be empty.
+static size_t qtb_column_buffer_rows(QtbColumnBuffer *self) {
+  size_t start = self->chunk * QTB_COLUMN_CHUNK_SIZE;
+  QtbColumn *column = &self->table->columns[self->column];
+
+  if (column->size <= start) return 0;
+  return MIN(column->size - start, QTB_COLUMN_CHUNK_SIZE);
+}
+
+static int qtb_column_buffer_getbuffer(QtbColumnBuffer *self, Py_buffer *view, int flags) {
+  QtbColumn *column = &self->table->columns[self->column];
+  size_t rows;
+  Result result;
+
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    view->obj = NULL;
+    PyErr_SetString(PyExc_BufferError, "column buffers are read-only");
+    return -1;
+  }
+
+  rows = qtb_column_buffer_rows(self);
+  self->shape = (Py_ssize_t)rows;
+
+  if (rows > 0) {
+    result = qtb_column_decompress_chunk(column, self->chunk);
+    if (ResultFailed(result)) {
+      view->obj = NULL;
+      ResultFailureRaise(result);
+      return -1;
+    }
+  }
+
+  view->buf = rows > 0 ? column->chunks[self->chunk].data : (void *)&self->shape;
+  view->obj = (PyObject *)self;
+  Py_INCREF(self);
+  view->len = self->shape * self->itemsize;
+  view->readonly = 1;
+  view->itemsize = self->itemsize;
+  view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? (char *)self->format : NULL;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) == PyBUF_ND ? &self->shape : NULL;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &self->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+
+  self->table->exports++;
+  return 0;
+}
+
+static void qtb_column_buffer_releasebuffer(QtbColumnBuffer *self, Py_buffer *view) {
+  self->table->exports--;
+}
+
+static Py_ssize_t qtb_column_buffer_length(QtbColumnBuffer *self) {
+  return (Py_ssize_t)qtb_column_buffer_rows(self);
+}
+
+static PyObject *qtb_column_buffer_format_getter(QtbColumnBuffer *self, void *closure) {
+  return PyUnicode_FromString(self->format);
+}
+
+static PyGetSetDef qtb_column_buffer_getsetters[] = {
+  {"format", (getter)qtb_column_buffer_format_getter, NULL, "struct module format of the cells", NULL},
+  {NULL}
+};
+
+static PySequenceMethods qtb_column_buffer_as_sequence = {
+  (lenfunc)qtb_column_buffer_length,  // sq_length
+};
+
+static PyBufferProcs qtb_column_buffer_as_buffer = {
+  (getbufferproc)qtb_column_buffer_getbuffer,  // bf_getbuffer
+  (releasebufferproc)qtb_column_buffer_releasebuffer,  // bf_releasebuffer
+};
+
+PyTypeObject QtbColumnBufferType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "quicktable.ColumnBuffer",  // tp_name
+    sizeof(QtbColumnBuffer),  // tp_basicsize
+    0,  // tp_itemsize
+    (destructor)qtb_column_buffer_dealloc,  // tp_dealloc
+    0,  // tp_print
+    0,  // tp_getattr
+    0,  // tp_setattr
+    0,  // tp_reserved
+    0,  // tp_repr
+    0,  // tp_as_number
+    &qtb_column_buffer_as_sequence,  // tp_as_sequence
+    0,  // tp_as_mapping
+    0,  // tp_hash
+    0,  // tp_call
+    0,  // tp_str
+    0,  // tp_getattro
+    0,  // tp_setattro
+    &qtb_column_buffer_as_buffer,  // tp_as_buffer
+    Py_TPFLAGS_DEFAULT,  // tp_flags
+    "Read-only buffer over one chunk of a numeric column",  // tp_doc
+    0,  // tp_traverse
+    0,  // tp_clear
+    0,  // tp_richcompare
+    0,  // tp_weaklistoffset
+    0,  // tp_iter
+    0,  // tp_iternext
+    0,  // tp_methods
+    0,  // tp_members
+    qtb_column_buffer_getsetters,  // tp_getset
+    0,  // tp_base
+    0,  // tp_dict
+    0,  // tp_descr_get
+    0,  // tp_descr_set
+    0,  // tp_dictoffset
+    0,  // tp_init
+    0,  // tp_alloc
+    0  // tp_new
+};
@@ -0,0 +1,253 @@
+#include <Python.h>
+#include "column_view.h"
+
+ResultPyObjectPtr qtb_column_view_new_(QtbTable *table, size_t column) {
+  QtbColumnView *self;
+
+  self = PyObject_New(QtbColumnView, &QtbColumnViewType);
+  if (self == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  Py_INCREF(table);
+  self->table = table;
+  self->column = column;
+
+  return ResultPyObjectPtrSuccess((PyObject *)self);
+}
+
+static void qtb_column_view_dealloc(QtbColumnView *self) {
+  Py_DECREF(self->table);
+  PyObject_Free(self);
+}
+
+static QtbColumn *qtb_column_view_column(QtbColumnView *self) {
+  return &self->table->columns[self->column];
+}
+
+static Py_ssize_t qtb_column_view_length(QtbColumnView *self) {
+  return self->table->size;
+}
+
+static PyObject *qtb_column_view_item(QtbColumnView *self, Py_ssize_t i) {
+  ResultPyObjectPtr result;
+
+  if (i < 0) i += self->table->size;
+  if (i < 0 || i >= self->table->size) {
+    PyErr_SetString(PyExc_IndexError, "row index out of range");
+    return NULL;
+  }
+
+  result = qtb_column_get_as_pyobject(qtb_column_view_column(self), qtb_table_row(self->table, i));
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+// A slice is the same column of a view of the table.
+static PyObject *qtb_column_view_subscript(QtbColumnView *self, PyObject *key) {
+  Py_ssize_t i;
+  ResultPyObjectPtr view;
+  ResultPyObjectPtr result;
+
+  if (PyIndex_Check(key)) {
+    i = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (i == -1 && PyErr_Occurred()) return NULL;
+
+    return qtb_column_view_item(self, i);
+  }
+
+  if (!PySlice_Check(key)) {
+    PyErr_SetString(PyExc_TypeError, "column indices must be integers or slices");
+    return NULL;
+  }
+
+  view = qtb_table_slice_(self->table, key);
+  if (ResultFailed(view)) {
+    ResultFailureRaise(view);
+    return NULL;
+  }
+
+  result = qtb_column_view_new_((QtbTable *)ResultValue(view), self->column);
+  Py_DECREF(ResultValue(view));
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+// The list is allocated at its final size and filled in a single pass.
+static PyObject *qtb_column_view_tolist(QtbColumnView *self) {
+  QtbTable *table = self->table;
+  QtbColumn *column = qtb_column_view_column(self);
+  PyObject *list;
+  ResultPyObjectPtr cell;
+
+  list = PyList_New(table->size);
+  if (list == NULL) return NULL;
+
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    cell = qtb_column_get_as_pyobject(column, qtb_table_row(table, i));
+    if (ResultFailed(cell)) {
+      Py_DECREF(list);
+      ResultFailureRaise(cell);
+      return NULL;
+    }
+
+    PyList_SET_ITEM(list, i, ResultValue(cell));
+  }
+
+  return list;
+}
+
+static __int128 qtb_column_view_int_cell(QtbColumn *column, size_t i) {
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_INT8: return qtb_column_value_at(column, int8_t, i);
+    case QTB_COLUMN_TYPE_INT16: return qtb_column_value_at(column, int16_t, i);
+    case QTB_COLUMN_TYPE_INT32: return qtb_column_value_at(column, int32_t, i);
+    case QTB_COLUMN_TYPE_UINT8: return qtb_column_value_at(column, uint8_t, i);
+    case QTB_COLUMN_TYPE_UINT16: return qtb_column_value_at(column, uint16_t, i);
+    case QTB_COLUMN_TYPE_UINT32: return qtb_column_value_at(column, uint32_t, i);
+    case QTB_COLUMN_TYPE_UINT64: return qtb_column_value_at(column, uint64_t, i);
+    case QTB_COLUMN_TYPE_BOOL: return qtb_column_bool_at(column, i);
+    default: return qtb_column_int_at(column, i);
+  }
+}
+
+// An int of 128 bits, as the high 64 bits shifted onto the low ones.
+static PyObject *qtb_column_view_int128_as_pyobject(__int128 value) {
+  PyObject *high;
+  PyObject *low;
+  PyObject *shift;
+  PyObject *shifted;
+  PyObject *result = NULL;
+
+  if (value >= INT64_MIN && value <= INT64_MAX) return PyLong_FromLongLong((long long)value);
+
+  high = PyLong_FromLongLong((long long)(value >> 64));
+  low = PyLong_FromUnsignedLongLong((unsigned long long)(uint64_t)value);
+  shift = PyLong_FromLong(64);
+  shifted = high != NULL && shift != NULL ? PyNumber_Lshift(high, shift) : NULL;
+  if (shifted != NULL && low != NULL) result = PyNumber_Or(shifted, low);
+
+  Py_XDECREF(high);
+  Py_XDECREF(low);
+  Py_XDECREF(shift);
+  Py_XDECREF(shifted);
+  return result;
+}
+
+// Sum of the non-null cells: an int for int-like and bool columns, True
+// counting as 1, and a float for float columns. Ints are summed in 128 bits,
+// which no column can overflow.
+static PyObject *qtb_column_view_sum(QtbColumnView *self) {
+  QtbTable *table = self->table;
+  QtbColumn *column = qtb_column_view_column(self);
+  size_t at;
+  __int128 total = 0;
+  double float_total = 0.0;
+
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_STR:
+    case QTB_COLUMN_TYPE_CATEGORY:
+      PyErr_SetString(PyExc_TypeError, "sum of non-numeric column");
+      return NULL;
+    case QTB_COLUMN_TYPE_FLOAT:
+    case QTB_COLUMN_TYPE_FLOAT32:
+      for (Py_ssize_t i = 0; i < table->size; i++) {
+        at = qtb_table_row(table, i);
+        if (!qtb_column_is_valid(column, at)) continue;
+        float_total += column->type == QTB_COLUMN_TYPE_FLOAT ? qtb_column_float_at(column, at) : qtb_column_value_at(column, float, at);
+      }
+      return PyFloat_FromDouble(float_total);
+    default:
+      for (Py_ssize_t i = 0; i < table->size; i++) {
+        at = qtb_table_row(table, i);
+        if (qtb_column_is_valid(column, at)) total += qtb_column_view_int_cell(column, at);
+      }
+      return qtb_column_view_int128_as_pyobject(total);
+  }
+}
+
+static PyObject *qtb_column_view_name(QtbColumnView *self, void *closure) {
+  return PyUnicode_FromString(qtb_column_view_column(self)->name);
+}
+
+static PyObject *qtb_column_view_type(QtbColumnView *self, void *closure) {
+  return PyUnicode_FromString(qtb_column_type_as_string(qtb_column_view_column(self)));
+}
+
+static PyObject *qtb_column_view_repr(QtbColumnView *self) {
+  QtbColumn *column = qtb_column_view_column(self);
+
+  return PyUnicode_FromFormat("<quicktable.ColumnView %s (%s), %zd rows>", column->name, qtb_column_type_as_string(column), self->table->size);
+}
+
+static PyMethodDef qtb_column_view_methods[] = {
+  {"tolist", (PyCFunction)qtb_column_view_tolist, METH_NOARGS, "list of the column's values"},
+  {"sum", (PyCFunction)qtb_column_view_sum, METH_NOARGS, "sum of the column's non-null values"},
+  {NULL, NULL}
+};
+
+static PyGetSetDef qtb_column_view_getsetters[] = {
+  {"name", (getter)qtb_column_view_name, NULL, "column name", NULL},
+  {"type", (getter)qtb_column_view_type, NULL, "column type, e.g. int?", NULL},
+  {NULL}
+};
+
+static PySequenceMethods qtb_column_view_as_sequence = {
+  (lenfunc)qtb_column_view_length,  // sq_length
+  0,  // sq_concat
+  0,  // sq_repeat
+  (ssizeargfunc)qtb_column_view_item,  // sq_item
+};
+
+static PyMappingMethods qtb_column_view_as_mapping = {
+  (lenfunc)qtb_column_view_length,  // mp_length
+  (binaryfunc)qtb_column_view_subscript,  // mp_subscript
+  0,  // mp_ass_subscript
+};
+
+PyTypeObject QtbColumnViewType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "quicktable.ColumnView",  // tp_name
+    sizeof(QtbColumnView),  // tp_basicsize
+    0,  // tp_itemsize
+    (destructor)qtb_column_view_dealloc,  // tp_dealloc
+    0,  // tp_print
+    0,  // tp_getattr
+    0,  // tp_setattr
+    0,  // tp_reserved
+    (reprfunc)qtb_column_view_repr,  // tp_repr
+    0,  // tp_as_number
+    &qtb_column_view_as_sequence,  // tp_as_sequence
+    &qtb_column_view_as_mapping,  // tp_as_mapping
+    0,  // tp_hash
+    0,  // tp_call
+    0,  // tp_str
+    0,  // tp_getattro
+    0,  // tp_setattro
+    0,  // tp_as_buffer
+    Py_TPFLAGS_DEFAULT,  // tp_flags
+    "One column of a table, read in place",  // tp_doc
+    0,  // tp_traverse
+    0,  // tp_clear
+    0,  // tp_richcompare
+    0,  // tp_weaklistoffset
+    0,  // tp_iter
+    0,  // tp_iternext
+    qtb_column_view_methods,  // tp_methods
+    0,  // tp_members
+    qtb_column_view_getsetters,  // tp_getset
+    0,  // tp_base
+    0,  // tp_dict
+    0,  // tp_descr_get
+    0,  // tp_descr_set
+    0,  // tp_dictoffset
+    0,  // tp_init
+    0,  // tp_alloc
+    0  // tp_new
+};
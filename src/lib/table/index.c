@@ -0,0 +1,337 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "index.h"
+#include "hash.h"
+#include "result.h"
+
+static QtbIndexKey qtb_index_key_at(QtbColumn *column, size_t i) {
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_STR: return (QtbIndexKey){qtb_column_str_at(column, i), qtb_column_str_size_at(column, i), 0};
+    case QTB_COLUMN_TYPE_CATEGORY: return (QtbIndexKey){NULL, 0, qtb_column_code_at(column, i)};
+    case QTB_COLUMN_TYPE_INT8: return (QtbIndexKey){NULL, 0, (uint64_t)(int64_t)qtb_column_value_at(column, int8_t, i)};
+    case QTB_COLUMN_TYPE_INT16: return (QtbIndexKey){NULL, 0, (uint64_t)(int64_t)qtb_column_value_at(column, int16_t, i)};
+    case QTB_COLUMN_TYPE_INT32: return (QtbIndexKey){NULL, 0, (uint64_t)(int64_t)qtb_column_value_at(column, int32_t, i)};
+    case QTB_COLUMN_TYPE_UINT8: return (QtbIndexKey){NULL, 0, qtb_column_value_at(column, uint8_t, i)};
+    case QTB_COLUMN_TYPE_UINT16: return (QtbIndexKey){NULL, 0, qtb_column_value_at(column, uint16_t, i)};
+    case QTB_COLUMN_TYPE_UINT32: return (QtbIndexKey){NULL, 0, qtb_column_value_at(column, uint32_t, i)};
+    case QTB_COLUMN_TYPE_UINT64: return (QtbIndexKey){NULL, 0, qtb_column_value_at(column, uint64_t, i)};
+    default: return (QtbIndexKey){NULL, 0, (uint64_t)qtb_column_int_at(column, i)};
+  }
+}
+
+static uint64_t qtb_index_hash(QtbColumn *column, QtbIndexKey *key) {
+  if (column->type == QTB_COLUMN_TYPE_STR) return qtb_hash_bytes(key->s, key->size);
+  return qtb_hash_int(key->bits);
+}
+
+// Str cells are compared by size and prefix before their arena bytes are
+// touched.
+static bool qtb_index_key_equals(QtbColumn *column, size_t i, QtbIndexKey *key) {
+  if (column->type == QTB_COLUMN_TYPE_STR) return qtb_column_str_equals(column, i, key->s, key->size);
+
+  return qtb_index_key_at(column, i).bits == key->bits;
+}
+
+static size_t qtb_index_probe(QtbIndex *index, QtbColumn *column, QtbIndexKey *key, uint64_t hash) {
+  size_t mask;
+  size_t i;
+
+  mask = index->n_slots - 1;
+  for (i = hash & mask; index->slots[i] != 0; i = (i + 1) & mask)
+    if (qtb_index_key_equals(column, index->slots[i] - 1, key)) break;
+
+  return i;
+}
+
+static size_t qtb_index_home_of(QtbIndex *index, QtbColumn *column, size_t slot) {
+  QtbIndexKey key;
+
+  key = qtb_index_key_at(column, index->slots[slot] - 1);
+  return qtb_index_hash(column, &key) & (index->n_slots - 1);
+}
+
+static Result qtb_index_rehash(QtbIndex *index, QtbColumn *column, size_t n_slots) {
+  size_t *slots;
+  size_t mask;
+  size_t j;
+  QtbIndexKey key;
+
+  slots = (size_t *)qtb_malloc(index->allocator, n_slots * sizeof(size_t));
+  if (slots == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow index");
+  memset(slots, 0, n_slots * sizeof(size_t));
+
+  mask = n_slots - 1;
+  for (size_t i = 0; i < index->n_slots; i++) {
+    if (index->slots[i] == 0) continue;
+
+    key = qtb_index_key_at(column, index->slots[i] - 1);
+    for (j = qtb_index_hash(column, &key) & mask; slots[j] != 0; j = (j + 1) & mask);
+    slots[j] = index->slots[i];
+  }
+
+  qtb_free(index->allocator, index->slots);
+  index->slots = slots;
+  index->n_slots = n_slots;
+
+  return ResultSuccess();
+}
+
+// Empties slot i, moving later slots of its probe run back so that no key is
+// left past an empty slot it would have been found before.
+static void qtb_index_remove_slot(QtbIndex *index, QtbColumn *column, size_t i) {
+  size_t mask;
+  size_t j;
+  size_t home;
+
+  mask = index->n_slots - 1;
+  for (j = (i + 1) & mask; index->slots[j] != 0; j = (j + 1) & mask) {
+    home = qtb_index_home_of(index, column, j);
+
+    // Keys whose home lies cyclically in (i, j] stay where they are.
+    if (i <= j ? (home > i && home <= j) : (home > i || home <= j)) continue;
+
+    index->slots[i] = index->slots[j];
+    i = j;
+  }
+
+  index->slots[i] = 0;
+}
+
+static Result qtb_index_insert(QtbIndex *index, QtbColumn *column, size_t row) {
+  QtbIndexKey key;
+  size_t i;
+  Result result;
+
+  index->previous[row] = 0;
+  if (!qtb_column_is_valid(column, row)) return ResultSuccess();
+
+  // Keep the table at most half full so probe sequences stay short.
+  if (2 * (index->n_keys + 1) > index->n_slots) {
+    result = qtb_index_rehash(index, column, 2 * index->n_slots);
+    if (ResultFailed(result)) return result;
+  }
+
+  key = qtb_index_key_at(column, row);
+  i = qtb_index_probe(index, column, &key, qtb_index_hash(column, &key));
+  if (index->slots[i] != 0) {
+    if (index->unique) return ResultFailure(PyExc_ValueError, "duplicate key in unique index");
+    index->previous[row] = index->slots[i];
+  } else {
+    index->n_keys++;
+  }
+
+  index->slots[i] = row + 1;
+  return ResultSuccess();
+}
+
+static Result qtb_index_reserve(QtbIndex *index, size_t capacity) {
+  size_t *previous;
+  size_t new_capacity;
+
+  if (capacity <= index->capacity) return ResultSuccess();
+
+  for (new_capacity = MAX(index->capacity, QTB_INDEX_INITIAL_SLOTS); new_capacity < capacity; new_capacity *= 2);
+
+  previous = (size_t *)qtb_realloc(index->allocator, index->previous, new_capacity * sizeof(size_t));
+  if (previous == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow index");
+
+  index->previous = previous;
+  index->capacity = new_capacity;
+  return ResultSuccess();
+}
+
+// column is the column at position in its table. Indexes none of its rows
+// yet; qtb_index_extend does.
+Result qtb_index_init(QtbIndex *index, QtbColumn *column, size_t position, bool unique, QtbAllocator *allocator) {
+  switch (column->type) {
+    case QTB_COLUMN_TYPE_FLOAT:
+    case QTB_COLUMN_TYPE_FLOAT32:
+    case QTB_COLUMN_TYPE_BOOL:
+      return ResultFailure(PyExc_TypeError, "index of float or bool column");
+    default:
+      break;
+  }
+
+  index->allocator = allocator;
+  index->column = position;
+  index->unique = unique;
+  index->n_keys = 0;
+  index->previous = NULL;
+  index->capacity = 0;
+  index->size = 0;
+
+  index->slots = (size_t *)qtb_malloc(allocator, QTB_INDEX_INITIAL_SLOTS * sizeof(size_t));
+  if (index->slots == NULL) return ResultFailure(PyExc_MemoryError, "failed to grow index");
+  memset(index->slots, 0, QTB_INDEX_INITIAL_SLOTS * sizeof(size_t));
+  index->n_slots = QTB_INDEX_INITIAL_SLOTS;
+
+  return ResultSuccess();
+}
+
+// Indexes the column's rows from index->size up to size. Nothing is indexed
+// when this fails, e.g. on a duplicate key in a unique index.
+Result qtb_index_extend(QtbIndex *index, QtbColumn *column, size_t size) {
+  size_t first;
+  Result result;
+
+  result = qtb_index_reserve(index, size);
+  if (ResultFailed(result)) return result;
+
+  first = index->size;
+  for (size_t row = first; row < size; row++) {
+    result = qtb_index_insert(index, column, row);
+    if (ResultFailed(result)) {
+      qtb_index_truncate(index, column, first);
+      return result;
+    }
+
+    index->size++;
+  }
+
+  return ResultSuccess();
+}
+
+// Drops rows from size on, last first, while the column still holds them.
+void qtb_index_truncate(QtbIndex *index, QtbColumn *column, size_t size) {
+  QtbIndexKey key;
+  size_t row;
+  size_t i;
+
+  while (index->size > size) {
+    row = --index->size;
+    if (!qtb_column_is_valid(column, row)) continue;
+
+    // The row is the last indexed, so it heads its key's chain.
+    key = qtb_index_key_at(column, row);
+    i = qtb_index_probe(index, column, &key, qtb_index_hash(column, &key));
+    if (index->previous[row] != 0) {
+      index->slots[i] = index->previous[row];
+    } else {
+      qtb_index_remove_slot(index, column, i);
+      index->n_keys--;
+    }
+  }
+}
+
+// Reads key as the column's type would store it. Keys the column cannot
+// hold, such as unknown category values, match no row and clear found.
+static Result qtb_index_key_from_pyobject(QtbColumn *column, PyObject *key, QtbIndexKey *index_key, bool *found) {
+  Py_ssize_t size;
+  Py_ssize_t code;
+  int overflow;
+  long long value;
+
+  *found = true;
+  *index_key = (QtbIndexKey){NULL, 0, 0};
+
+  if (column->type == QTB_COLUMN_TYPE_STR || column->type == QTB_COLUMN_TYPE_CATEGORY) {
+    if (!PyUnicode_Check(key)) return ResultFailure(PyExc_TypeError, "lookup with non-str key");
+
+    index_key->s = PyUnicode_AsUTF8AndSize(key, &size);
+    if (index_key->s == NULL) return ResultFailureFromPyErr();
+    index_key->size = (size_t)size;
+
+    if (column->type == QTB_COLUMN_TYPE_CATEGORY) {
+      code = qtb_dictionary_lookup(&column->dictionary, index_key->s, index_key->size);
+      *found = code >= 0;
+      index_key->bits = (uint64_t)code;
+    }
+
+    return ResultSuccess();
+  }
+
+  if (!PyLong_Check(key)) return ResultFailure(PyExc_TypeError, "lookup with non-int key");
+
+  if (column->type == QTB_COLUMN_TYPE_UINT8 || column->type == QTB_COLUMN_TYPE_UINT16 || column->type == QTB_COLUMN_TYPE_UINT32 || column->type == QTB_COLUMN_TYPE_UINT64) {
+    index_key->bits = PyLong_AsUnsignedLongLong(key);
+    if (index_key->bits == (uint64_t)-1 && PyErr_Occurred()) {
+      if (!PyErr_ExceptionMatches(PyExc_OverflowError)) return ResultFailureFromPyErr();
+      PyErr_Clear();
+      *found = false;
+    }
+
+    return ResultSuccess();
+  }
+
+  value = PyLong_AsLongLongAndOverflow(key, &overflow);
+  if (value == -1 && PyErr_Occurred()) return ResultFailureFromPyErr();
+  *found = overflow == 0;
+  index_key->bits = (uint64_t)value;
+
+  return ResultSuccess();
+}
+
+// Sets *i to the position of row in offset, offset + step, ..., size rows
+// long, if it is one of them.
+static bool qtb_index_position(size_t row, Py_ssize_t offset, Py_ssize_t step, Py_ssize_t size, Py_ssize_t *i) {
+  Py_ssize_t distance = (Py_ssize_t)row - offset;
+
+  if (distance % step != 0) return false;
+
+  *i = distance / step;
+  return *i >= 0 && *i < size;
+}
+
+// Positions of the rows holding key among rows offset, offset + step, ...,
+// size of them, in ascending order. An owning table passes offset 0 and step
+// 1, a view looks up its rows in the index of its base.
+ResultPyObjectPtr qtb_index_lookup(QtbIndex *index, QtbColumn *column, PyObject *key, Py_ssize_t offset, Py_ssize_t step, Py_ssize_t size) {
+  QtbIndexKey index_key;
+  bool found;
+  size_t i;
+  size_t head = 0;
+  Py_ssize_t position;
+  Py_ssize_t n = 0;
+  Py_ssize_t k = 0;
+  PyObject *rows;
+  PyObject *row;
+  Result result;
+
+  result = qtb_index_key_from_pyobject(column, key, &index_key, &found);
+  if (ResultFailed(result)) return ResultPyObjectPtrFailureFromResult(result);
+
+  if (found) {
+    i = qtb_index_probe(index, column, &index_key, qtb_index_hash(column, &index_key));
+    head = index->slots[i];
+  }
+
+  for (size_t at = head; at != 0; at = index->previous[at - 1])
+    if (qtb_index_position(at - 1, offset, step, size, &position)) n++;
+
+  rows = PyList_New(n);
+  if (rows == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  // The chain runs from the last row back, so positions come out descending
+  // for a positive step and ascending for a negative one.
+  for (size_t at = head; at != 0; at = index->previous[at - 1]) {
+    if (!qtb_index_position(at - 1, offset, step, size, &position)) continue;
+
+    row = PyLong_FromSsize_t(position);
+    if (row == NULL) {
+      Py_DECREF(rows);
+      return ResultPyObjectPtrFailureFromPyErr();
+    }
+
+    PyList_SET_ITEM(rows, step > 0 ? n - 1 - k : k, row);
+    k++;
+  }
+
+  return ResultPyObjectPtrSuccess(rows);
+}
+
+size_t qtb_index_memory_usage(QtbIndex *index) {
+  return (index->n_slots + index->capacity) * sizeof(size_t);
+}
+
+void qtb_index_dealloc(QtbIndex *index) {
+  qtb_free(index->allocator, index->slots);
+  qtb_free(index->allocator, index->previous);
+
+  index->slots = NULL;
+  index->previous = NULL;
+  index->n_slots = 0;
+  index->capacity = 0;
+  index->size = 0;
+  index->n_keys = 0;
+}
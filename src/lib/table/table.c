@@ -1,5 +1,9 @@
 #include "table.h"
 #include "result.h"
+#include "pool.h"
+#include "column_buffer.h"
+#include "column_view.h"
+#include "column_from_buffer.h"
 
 static ResultQtbColumnPtr column_new_many(size_t size) {
   return qtb_column_new_many(size);
@@ -9,6 +13,17 @@ void qtb_table_new_(QtbTable *self) {
   self->size = 0;
   self->width = 0;
   self->columns = NULL;
+  self->base = NULL;
+  self->offset = 0;
+  self->step = 1;
+  self->views = 0;
+  self->exports = 0;
+  self->indexes = NULL;
+  self->n_indexes = 0;
+
+  qtb_allocator_malloc_new(&self->owned_allocator);
+  self->allocator = &qtb_allocator_default;
+  self->pool = NULL;
 
   self->PySequence_Size = &PySequence_Size;
   self->PyList_New = &PyList_New;
@@ -18,10 +33,47 @@ void qtb_table_new_(QtbTable *self) {
 }
 
 void qtb_table_dealloc_(QtbTable *self) {
+  if (self->base != NULL) {
+    ((QtbTable *)self->base)->views--;
+    Py_DECREF(self->base);
+    return;
+  }
+
+  for (Py_ssize_t i = 0; i < self->n_indexes; i++)
+    qtb_index_dealloc(&self->indexes[i]);
+  free(self->indexes);
+
   for (Py_ssize_t i = 0; i < self->width; i++)
     qtb_column_dealloc(&self->columns[i]);
 
   free(self->columns);
+
+  qtb_allocator_dealloc(&self->owned_allocator);
+  Py_XDECREF(self->pool);
+}
+
+// allocator is None or "malloc" for libc, "arena" or "hugepage" for a bump
+// allocator owned by the table, or a quicktable.Pool shared with others.
+Result qtb_table_use_allocator_(QtbTable *self, PyObject *allocator) {
+  if (allocator == NULL || allocator == Py_None) return ResultSuccess();
+
+  if (PyObject_TypeCheck(allocator, &QtbPoolType)) {
+    Py_INCREF(allocator);
+    self->pool = allocator;
+    self->allocator = &((QtbPool *)allocator)->allocator;
+    return ResultSuccess();
+  }
+
+  if (!PyUnicode_Check(allocator)) return ResultFailure(PyExc_TypeError, "allocator must be a str or quicktable.Pool");
+
+  if (PyUnicode_CompareWithASCIIString(allocator, "malloc") == 0) return ResultSuccess();
+
+  if (PyUnicode_CompareWithASCIIString(allocator, "arena") == 0) qtb_allocator_arena_new(&self->owned_allocator);
+  else if (PyUnicode_CompareWithASCIIString(allocator, "hugepage") == 0) qtb_allocator_hugepage_new(&self->owned_allocator);
+  else return ResultFailure(PyExc_ValueError, "invalid allocator");
+
+  self->allocator = &self->owned_allocator;
+  return ResultSuccess();
 }
 
 Result qtb_table_init_(QtbTable *self, PyObject *blueprint) {
@@ -38,8 +90,15 @@ Result qtb_table_init_(QtbTable *self, PyObject *blueprint) {
   if (ResultFailed(columns)) return ResultFailureFromResult(columns);
   self->columns = ResultValue(columns);
 
+  for (Py_ssize_t i = 0; i < self->width; i++)
+    qtb_column_use_allocator(&self->columns[i], self->allocator);
+
   result = self->column_init_many(self->columns, blueprint, self->width);
-  if (ResultFailed(result)) free(self->columns);
+  if (ResultFailed(result)) {
+    free(self->columns);
+    self->columns = NULL;
+    self->width = 0;
+  }
 
   return result;
 }
@@ -53,13 +112,13 @@ ResultPyObjectPtr qtb_table_item_(QtbTable *self, Py_ssize_t i) {
   ResultPyObjectPtr result;
 
   if (i < 0) i = self->size + i;
-  if (i >= self->size) return ResultPyObjectPtrFailure(PyExc_IndexError, "table index out of range");
+  if (i < 0 || i >= self->size) return ResultPyObjectPtrFailure(PyExc_IndexError, "table index out of range");
 
   row = PyList_New(self->width);
   if (row == NULL) return ResultPyObjectPtrFailureFromPyErr();
 
   for (Py_ssize_t j = 0; j < self->width; j++) {
-    result = qtb_column_get_as_pyobject(&self->columns[j], i);
+    result = qtb_column_get_as_pyobject(&self->columns[j], qtb_table_row(self, i));
     if (ResultFailed(result)) {
       Py_DECREF(row);
       return result;
@@ -70,10 +129,400 @@ ResultPyObjectPtr qtb_table_item_(QtbTable *self, Py_ssize_t i) {
   return ResultPyObjectPtrSuccess(row);
 }
 
+// A view of the rows picked by slice, made in O(1): it shares this table's
+// columns and keeps their owner alive. Views of views refer to the owner
+// directly.
+ResultPyObjectPtr qtb_table_slice_(QtbTable *self, PyObject *slice) {
+  Py_ssize_t start;
+  Py_ssize_t stop;
+  Py_ssize_t step;
+  QtbTable *root;
+  QtbTable *view;
+
+  if (PySlice_Unpack(slice, &start, &stop, &step) < 0) return ResultPyObjectPtrFailureFromPyErr();
+
+  view = (QtbTable *)Py_TYPE(self)->tp_alloc(Py_TYPE(self), 0);
+  if (view == NULL) return ResultPyObjectPtrFailureFromPyErr();
+  qtb_table_new_(view);
+
+  root = self->base != NULL ? (QtbTable *)self->base : self;
+  Py_INCREF(root);
+  root->views++;
+
+  view->base = (PyObject *)root;
+  view->size = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  view->offset = self->offset + start * self->step;
+  view->step = self->step * step;
+  view->width = self->width;
+  view->columns = self->columns;
+  view->allocator = self->allocator;
+
+  return ResultPyObjectPtrSuccess((PyObject *)view);
+}
+
+// An empty table of the same type and blueprint as self. It shares the
+// pool of self, or of the table self is a view of, if there is one and uses
+// libc otherwise.
+static ResultPyObjectPtr qtb_table_new_like(QtbTable *self) {
+  QtbTable *root;
+  QtbTable *table;
+  ResultPyObjectPtr blueprint;
+  Result result;
+
+  table = (QtbTable *)Py_TYPE(self)->tp_alloc(Py_TYPE(self), 0);
+  if (table == NULL) return ResultPyObjectPtrFailureFromPyErr();
+  qtb_table_new_(table);
+
+  root = self->base != NULL ? (QtbTable *)self->base : self;
+  if (root->pool != NULL) {
+    Py_INCREF(root->pool);
+    table->pool = root->pool;
+    table->allocator = root->allocator;
+  }
+
+  blueprint = qtb_table_blueprint_(self);
+  if (ResultFailed(blueprint)) {
+    Py_DECREF(table);
+    return blueprint;
+  }
+
+  result = qtb_table_init_(table, ResultValue(blueprint));
+  Py_DECREF(ResultValue(blueprint));
+  if (ResultFailed(result)) {
+    Py_DECREF(table);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  return ResultPyObjectPtrSuccess((PyObject *)table);
+}
+
+// Copies the table's rows, or a view's, into a new table of the same type
+// and blueprint, as made by qtb_table_new_like.
+ResultPyObjectPtr qtb_table_copy_(QtbTable *self) {
+  QtbTable *copy;
+  ResultPyObjectPtr table;
+  Result result = ResultSuccess();
+
+  table = qtb_table_new_like(self);
+  if (ResultFailed(table)) return table;
+  copy = (QtbTable *)ResultValue(table);
+
+  for (Py_ssize_t j = 0; j < copy->width && ResultSuccessful(result); j++)
+    result = qtb_column_append_rows(&copy->columns[j], &self->columns[j], (size_t)self->offset, self->step, (size_t)self->size);
+
+  if (ResultFailed(result)) {
+    Py_DECREF(copy);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  copy->size = self->size;
+  return table;
+}
+
+// Copies rows[0], ..., rows[n - 1] of the table's columns, which for a view
+// are its base's, into a new table made by qtb_table_new_like. Each column is
+// gathered in one pass.
+static ResultPyObjectPtr qtb_table_gather(QtbTable *self, const size_t *rows, size_t n) {
+  QtbTable *gathered;
+  ResultPyObjectPtr table;
+  Result result = ResultSuccess();
+
+  table = qtb_table_new_like(self);
+  if (ResultFailed(table)) return table;
+  gathered = (QtbTable *)ResultValue(table);
+
+  for (Py_ssize_t j = 0; j < gathered->width && ResultSuccessful(result); j++)
+    result = qtb_column_append_taken(&gathered->columns[j], &self->columns[j], rows, n);
+
+  if (ResultFailed(result)) {
+    Py_DECREF(gathered);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  gathered->size = (Py_ssize_t)n;
+  return table;
+}
+
+// Gets a one-dimensional buffer over object into view, if object exports
+// one. Returns false, with no error set, otherwise.
+static bool qtb_table_get_vector(PyObject *object, Py_buffer *view) {
+  if (!PyObject_CheckBuffer(object)) return false;
+
+  if (PyObject_GetBuffer(object, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+    PyErr_Clear();
+    return false;
+  }
+
+  if (view->ndim != 1) {
+    PyBuffer_Release(view);
+    return false;
+  }
+
+  return true;
+}
+
+static Result qtb_table_take_row(QtbTable *self, Py_ssize_t i, size_t *row) {
+  if (i < 0) i += self->size;
+  if (i < 0 || i >= self->size) return ResultFailure(PyExc_IndexError, "take index out of range");
+
+  *row = qtb_table_row(self, i);
+  return ResultSuccess();
+}
+
+static Result qtb_table_take_rows_from_buffer(QtbTable *self, Py_buffer *view, size_t *rows) {
+  QtbBuffer buffer;
+  uint64_t u;
+  Result result = ResultSuccess();
+
+  buffer = qtb_buffer_from_view(view);
+  if (buffer.kind != QTB_BUFFER_SIGNED && buffer.kind != QTB_BUFFER_UNSIGNED)
+    return ResultFailure(PyExc_TypeError, "take with non-integer buffer");
+
+  for (size_t k = 0; k < buffer.n && ResultSuccessful(result); k++) {
+    if (buffer.kind == QTB_BUFFER_SIGNED) {
+      result = qtb_table_take_row(self, (Py_ssize_t)qtb_buffer_signed_at(&buffer, k), &rows[k]);
+    } else {
+      u = qtb_buffer_unsigned_at(&buffer, k);
+      if (u >= (uint64_t)self->size) return ResultFailure(PyExc_IndexError, "take index out of range");
+      rows[k] = qtb_table_row(self, (Py_ssize_t)u);
+    }
+  }
+
+  return result;
+}
+
+// Every index is converted before any is checked against the table's size:
+// converting runs __index__, which may change the table or indices.
+static Result qtb_table_take_rows_from_sequence(QtbTable *self, PyObject *fast, size_t *rows, size_t n) {
+  PyObject *item;
+  Py_ssize_t *indices = (Py_ssize_t *)rows;
+  Result result = ResultSuccess();
+
+  for (size_t k = 0; k < n; k++) {
+    if ((Py_ssize_t)k >= PySequence_Fast_GET_SIZE(fast)) return ResultFailure(PyExc_RuntimeError, "take indices changed size");
+
+    item = PySequence_Fast_GET_ITEM(fast, k);
+    if (!PyIndex_Check(item)) return ResultFailure(PyExc_TypeError, "take with non-integer index");
+
+    Py_INCREF(item);
+    indices[k] = PyNumber_AsSsize_t(item, PyExc_IndexError);
+    Py_DECREF(item);
+    if (indices[k] == -1 && PyErr_Occurred()) return ResultFailureFromPyErr();
+  }
+
+  for (size_t k = 0; k < n && ResultSuccessful(result); k++)
+    result = qtb_table_take_row(self, indices[k], &rows[k]);
+
+  return result;
+}
+
+// A new table of the rows at indices, in that order, which may repeat and
+// count from the end when negative. indices is an integer buffer such as an
+// array.array or a NumPy array, or a sequence of ints.
+ResultPyObjectPtr qtb_table_take_(QtbTable *self, PyObject *indices) {
+  Py_buffer view;
+  PyObject *fast = NULL;
+  size_t n;
+  size_t *rows;
+  Result result;
+  ResultPyObjectPtr taken;
+
+  if (qtb_table_get_vector(indices, &view)) {
+    n = (size_t)view.shape[0];
+  } else {
+    view.obj = NULL;
+    fast = PySequence_Fast(indices, "take with non-sequence indices");
+    if (fast == NULL) return ResultPyObjectPtrFailureFromPyErr();
+    n = (size_t)PySequence_Fast_GET_SIZE(fast);
+  }
+
+  rows = (size_t *)malloc(MAX(n, 1) * sizeof(size_t));
+  if (rows == NULL) {
+    result = ResultFailure(PyExc_MemoryError, "memory error");
+  } else if (view.obj != NULL) {
+    result = qtb_table_take_rows_from_buffer(self, &view, rows);
+  } else {
+    result = qtb_table_take_rows_from_sequence(self, fast, rows, n);
+  }
+
+  if (view.obj != NULL) PyBuffer_Release(&view);
+  Py_XDECREF(fast);
+
+  if (ResultFailed(result)) {
+    free(rows);
+    return ResultPyObjectPtrFailureFromResult(result);
+  }
+
+  taken = qtb_table_gather(self, rows, n);
+  free(rows);
+  return taken;
+}
+
+// Rows of the table kept by a mask of one flag per row, as read by
+// qtb_table_filter_. Returns how many rows there are.
+static ResultSize_t qtb_table_filter_rows(QtbTable *self, PyObject *mask, size_t *rows) {
+  QtbColumnView *column_view;
+  QtbColumn *column;
+  Py_buffer view;
+  QtbBuffer buffer;
+  PyObject *fast;
+  PyObject *item;
+  size_t n = 0;
+
+  if (PyObject_TypeCheck(mask, &QtbColumnViewType)) {
+    column_view = (QtbColumnView *)mask;
+    column = &column_view->table->columns[column_view->column];
+    if (column->type != QTB_COLUMN_TYPE_BOOL) return ResultSize_tFailure(PyExc_TypeError, "filter with non-bool mask");
+    if (column_view->table->size != self->size) return ResultSize_tFailure(PyExc_TypeError, "filter with mismatching mask length");
+
+    // Null flags drop their row.
+    for (Py_ssize_t i = 0; i < self->size; i++) {
+      rows[n] = qtb_table_row(self, i);
+      n += qtb_column_is_valid(column, qtb_table_row(column_view->table, i)) && qtb_column_bool_at(column, qtb_table_row(column_view->table, i));
+    }
+
+    return ResultSize_tSuccess(n);
+  }
+
+  if (qtb_table_get_vector(mask, &view)) {
+    buffer = qtb_buffer_from_view(&view);
+    if (buffer.kind != QTB_BUFFER_BOOL || buffer.n != (size_t)self->size) {
+      PyBuffer_Release(&view);
+      if (buffer.kind != QTB_BUFFER_BOOL) return ResultSize_tFailure(PyExc_TypeError, "filter with non-bool mask");
+      return ResultSize_tFailure(PyExc_TypeError, "filter with mismatching mask length");
+    }
+
+    for (Py_ssize_t i = 0; i < self->size; i++) {
+      rows[n] = qtb_table_row(self, i);
+      n += buffer.data[i] != 0;
+    }
+
+    PyBuffer_Release(&view);
+    return ResultSize_tSuccess(n);
+  }
+
+  fast = PySequence_Fast(mask, "filter with non-sequence mask");
+  if (fast == NULL) return ResultSize_tFailureFromPyErr();
+
+  if (PySequence_Fast_GET_SIZE(fast) != self->size) {
+    Py_DECREF(fast);
+    return ResultSize_tFailure(PyExc_TypeError, "filter with mismatching mask length");
+  }
+
+  for (Py_ssize_t i = 0; i < self->size; i++) {
+    item = PySequence_Fast_GET_ITEM(fast, i);
+    if (!PyBool_Check(item)) {
+      Py_DECREF(fast);
+      return ResultSize_tFailure(PyExc_TypeError, "filter with non-bool mask");
+    }
+
+    rows[n] = qtb_table_row(self, i);
+    n += item == Py_True;
+  }
+
+  Py_DECREF(fast);
+  return ResultSize_tSuccess(n);
+}
+
+// A new table of the rows whose flag in mask is true, in order. mask holds
+// one flag per row: a bool column view, a bool buffer such as a NumPy array,
+// or a sequence of bools.
+ResultPyObjectPtr qtb_table_filter_(QtbTable *self, PyObject *mask) {
+  size_t *rows;
+  ResultSize_t n;
+  ResultPyObjectPtr filtered;
+
+  rows = (size_t *)malloc(MAX((size_t)self->size, 1) * sizeof(size_t));
+  if (rows == NULL) return ResultPyObjectPtrFailure(PyExc_MemoryError, "memory error");
+
+  n = qtb_table_filter_rows(self, mask, rows);
+  if (ResultFailed(n)) {
+    free(rows);
+    return ResultPyObjectPtrFailureFromResult(n);
+  }
+
+  filtered = qtb_table_gather(self, rows, ResultValue(n));
+  free(rows);
+  return filtered;
+}
+
+// Columns are picked by name or by position, negative positions counting
+// from the last column.
+ResultSize_t qtb_table_column_index_(QtbTable *self, PyObject *key) {
+  Py_ssize_t i;
+
+  if (PyUnicode_Check(key)) {
+    for (i = 0; i < self->width; i++)
+      if (PyUnicode_CompareWithASCIIString(key, self->columns[i].name) == 0) return ResultSize_tSuccess((size_t)i);
+
+    return ResultSize_tFailure(PyExc_KeyError, "no such column");
+  }
+
+  if (!PyLong_Check(key)) return ResultSize_tFailure(PyExc_TypeError, "column must be a str or an int");
+
+  i = PyLong_AsSsize_t(key);
+  if (i == -1 && PyErr_Occurred()) return ResultSize_tFailureFromPyErr();
+
+  if (i < 0) i += self->width;
+  if (i < 0 || i >= self->width) return ResultSize_tFailure(PyExc_IndexError, "column index out of range");
+
+  return ResultSize_tSuccess((size_t)i);
+}
+
+ResultPyObjectPtr qtb_table_column_(QtbTable *self, PyObject *key) {
+  ResultSize_t column;
+
+  column = qtb_table_column_index_(self, key);
+  if (ResultFailed(column)) return ResultPyObjectPtrFailureFromResult(column);
+
+  return qtb_column_view_new_(self, ResultValue(column));
+}
+
+// Drops cells that columns hold past the table's size, left behind when a
+// row fails to append part way through.
+void qtb_table_truncate_columns(QtbTable *self) {
+  for (Py_ssize_t i = 0; i < self->width; i++)
+    while (self->columns[i].size > (size_t)self->size)
+      qtb_column_pop(&self->columns[i]);
+}
+
+// Makes the n rows that the columns hold past the table's size part of it,
+// indexing them first. Nothing is indexed when this fails, e.g. on a
+// duplicate key in a unique index, and the caller drops the rows again.
+Result qtb_table_commit_rows_(QtbTable *self, Py_ssize_t n) {
+  QtbIndex *index;
+  Result result;
+
+  for (Py_ssize_t i = 0; i < self->n_indexes; i++) {
+    index = &self->indexes[i];
+    result = qtb_index_extend(index, &self->columns[index->column], (size_t)(self->size + n));
+    if (ResultFailed(result)) {
+      while (i-- > 0)
+        qtb_index_truncate(&self->indexes[i], &self->columns[self->indexes[i].column], (size_t)self->size);
+      return result;
+    }
+  }
+
+  self->size += n;
+  return ResultSuccess();
+}
+
+// Views never change the columns they share. Column buffers and Arrow arrays
+// point straight into chunks, so nothing may add, drop or move cells until
+// every export has been released.
+static Result qtb_table_check_mutable(QtbTable *self) {
+  if (self->base != NULL) return ResultFailure(PyExc_TypeError, "table view is read-only");
+  if (self->exports > 0) return ResultFailure(PyExc_BufferError, "table has exported buffers");
+  return ResultSuccess();
+}
+
 Result qtb_table_append_(QtbTable *self, PyObject *row) {
   PyObject *fast_row;
   int row_size;
-  Result result = ResultSuccess();
+  Result result;
+
+  result = qtb_table_check_mutable(self);
+  if (ResultFailed(result)) return result;
 
   if (PySequence_Check(row) != 1) return ResultFailure(PyExc_TypeError, "append with non-sequence");
 
@@ -90,22 +539,217 @@ Result qtb_table_append_(QtbTable *self, PyObject *row) {
   }
 
   Py_DECREF(fast_row);
-  if (ResultSuccessful(result)) self->size++;
+  if (ResultSuccessful(result)) result = qtb_table_commit_rows_(self, 1);
+  if (ResultFailed(result)) qtb_table_truncate_columns(self);
+
+  return result;
+}
+
+// Rows are checked up front, then appended a column at a time so that each
+// column's append runs in its own tight loop. Either every row is appended
+// or none are.
+Result qtb_table_extend_(QtbTable *self, PyObject *rows) {
+  PyObject *fast_rows;
+  PyObject **fast_row_items;
+  PyObject *row;
+  Py_ssize_t n;
+  Py_ssize_t n_checked;
+  Result result;
+
+  result = qtb_table_check_mutable(self);
+  if (ResultFailed(result)) return result;
+
+  fast_rows = PySequence_Fast(rows, "extend with non-iterable");
+  if (fast_rows == NULL) return ResultFailureFromPyErr();
+
+  n = PySequence_Fast_GET_SIZE(fast_rows);
+  fast_row_items = (PyObject **)malloc((n > 0 ? n : 1) * sizeof(PyObject *));
+  if (fast_row_items == NULL) {
+    Py_DECREF(fast_rows);
+    return ResultFailure(PyExc_MemoryError, "memory error");
+  }
+
+  for (n_checked = 0; n_checked < n; n_checked++) {
+    row = PySequence_Fast_GET_ITEM(fast_rows, n_checked);
+    if (PySequence_Check(row) != 1) {
+      result = ResultFailure(PyExc_TypeError, "extend with non-sequence row");
+      break;
+    }
+
+    fast_row_items[n_checked] = PySequence_Fast(row, "");
+    if (fast_row_items[n_checked] == NULL) {
+      result = ResultFailureFromPyErr();
+      break;
+    }
+
+    if (PySequence_Fast_GET_SIZE(fast_row_items[n_checked]) != self->width) {
+      Py_DECREF(fast_row_items[n_checked]);
+      result = ResultFailure(PyExc_TypeError, "extend with mismatching row length");
+      break;
+    }
+  }
+
+  if (ResultSuccessful(result)) result = qtb_table_reserve_(self, self->size + n);
+
+  for (Py_ssize_t j = 0; j < self->width && ResultSuccessful(result); j++) {
+    for (Py_ssize_t i = 0; i < n; i++) {
+      result = qtb_column_append(&self->columns[j], PySequence_Fast_GET_ITEM(fast_row_items[i], j));
+      if (ResultFailed(result)) break;
+    }
+  }
+
+  if (ResultSuccessful(result)) result = qtb_table_commit_rows_(self, n);
+  if (ResultFailed(result)) qtb_table_truncate_columns(self);
+
+  for (Py_ssize_t i = 0; i < n_checked; i++)
+    Py_DECREF(fast_row_items[i]);
+  free(fast_row_items);
+  Py_DECREF(fast_rows);
+
+  return result;
+}
+
+// A column's values for extend_columns_, either a one-dimensional buffer or
+// a fast sequence.
+typedef struct {
+  PyObject *fast;
+  Py_buffer view;
+  Py_ssize_t size;
+} QtbTableColumnSource;
+
+static Result qtb_table_column_source_init(QtbTableColumnSource *source, QtbColumn *column, PyObject *item, const char *caller) {
+  char message[64];
+
+  source->fast = NULL;
+  source->view.obj = NULL;
+
+  // Buffers that are not contiguous or not one-dimensional are read as
+  // sequences instead.
+  if (column->append_buffer != NULL && PyObject_CheckBuffer(item)) {
+    if (PyObject_GetBuffer(item, &source->view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+      PyErr_Clear();
+      source->view.obj = NULL;
+    } else if (source->view.ndim != 1) {
+      PyBuffer_Release(&source->view);
+      source->view.obj = NULL;
+    } else {
+      source->size = source->view.shape[0];
+      return ResultSuccess();
+    }
+  }
+
+  snprintf(message, sizeof(message), "%s with non-sequence column", caller);
+  source->fast = PySequence_Fast(item, message);
+  if (source->fast == NULL) return ResultFailureFromPyErr();
+
+  source->size = PySequence_Fast_GET_SIZE(source->fast);
+  return ResultSuccess();
+}
+
+static void qtb_table_column_source_release(QtbTableColumnSource *source) {
+  Py_XDECREF(source->fast);
+  if (source->view.obj != NULL) PyBuffer_Release(&source->view);
+}
+
+static Result qtb_table_column_source_append(QtbTableColumnSource *source, QtbColumn *column) {
+  Result result = ResultSuccess();
+
+  if (source->view.obj != NULL) return qtb_column_append_buffer(column, &source->view);
+
+  for (Py_ssize_t i = 0; i < source->size; i++) {
+    result = qtb_column_append(column, PySequence_Fast_GET_ITEM(source->fast, i));
+    if (ResultFailed(result)) break;
+  }
+
+  return result;
+}
+
+// One sequence per column, all of the same length. Each column is filled in
+// a single pass and, as with extend, a failing value appends nothing. Numeric
+// and bool columns also take buffers such as array.array or NumPy arrays,
+// which are copied without creating a Python object per element. caller
+// names the method in error messages.
+Result qtb_table_extend_columns_(QtbTable *self, PyObject *columns, const char *caller) {
+  PyObject *fast_columns;
+  QtbTableColumnSource *sources;
+  Py_ssize_t n = 0;
+  Py_ssize_t n_checked;
+  Result result;
+
+  result = qtb_table_check_mutable(self);
+  if (ResultFailed(result)) return result;
+
+  fast_columns = PySequence_Fast(columns, "columns must be a sequence");
+  if (fast_columns == NULL) return ResultFailureFromPyErr();
+
+  if (PySequence_Fast_GET_SIZE(fast_columns) != self->width) {
+    Py_DECREF(fast_columns);
+    PyErr_Format(PyExc_TypeError, "%s with mismatching column count", caller);
+    return ResultFailureFromPyErr();
+  }
+
+  sources = (QtbTableColumnSource *)malloc((self->width > 0 ? self->width : 1) * sizeof(QtbTableColumnSource));
+  if (sources == NULL) {
+    Py_DECREF(fast_columns);
+    return ResultFailure(PyExc_MemoryError, "memory error");
+  }
+
+  for (n_checked = 0; n_checked < self->width; n_checked++) {
+    result = qtb_table_column_source_init(&sources[n_checked], &self->columns[n_checked], PySequence_Fast_GET_ITEM(fast_columns, n_checked), caller);
+    if (ResultFailed(result)) break;
+
+    if (n_checked == 0) n = sources[0].size;
+    if (sources[n_checked].size != n) {
+      qtb_table_column_source_release(&sources[n_checked]);
+      PyErr_Format(PyExc_TypeError, "%s with mismatching column lengths", caller);
+      result = ResultFailureFromPyErr();
+      break;
+    }
+  }
+
+  if (ResultSuccessful(result)) result = qtb_table_reserve_(self, self->size + n);
+
+  for (Py_ssize_t j = 0; j < self->width && ResultSuccessful(result); j++)
+    result = qtb_table_column_source_append(&sources[j], &self->columns[j]);
+
+  if (ResultSuccessful(result)) result = qtb_table_commit_rows_(self, n);
+  if (ResultFailed(result)) qtb_table_truncate_columns(self);
+
+  for (Py_ssize_t j = 0; j < n_checked; j++)
+    qtb_table_column_source_release(&sources[j]);
+  free(sources);
+  Py_DECREF(fast_columns);
 
   return result;
 }
 
 ResultPyObjectPtr qtb_table_pop_(QtbTable *self) {
   ResultPyObjectPtr result;
+  Result checked;
+
+  checked = qtb_table_check_mutable(self);
+  if (ResultFailed(checked)) return ResultPyObjectPtrFailureFromResult(checked);
+
+  // Views may hold the last row; appends leave them alone.
+  if (self->views > 0) return ResultPyObjectPtrFailure(PyExc_BufferError, "table has views");
 
   if (self->size == 0) return ResultPyObjectPtrFailure(PyExc_IndexError, "pop from empty table");
 
+  // Rows are appended again where this one is popped, which a compressed
+  // chunk would not allow.
+  for (Py_ssize_t i = 0; i < self->width; i++) {
+    checked = qtb_column_decompress_chunk(&self->columns[i], qtb_column_chunk_of((size_t)self->size - 1));
+    if (ResultFailed(checked)) return ResultPyObjectPtrFailureFromResult(checked);
+  }
+
   result = qtb_table_item_(self, self->size - 1);
   if (ResultFailed(result)) return result;
 
   self->size--;
+  for (Py_ssize_t i = 0; i < self->n_indexes; i++)
+    qtb_index_truncate(&self->indexes[i], &self->columns[self->indexes[i].column], (size_t)self->size);
   for (Py_ssize_t i = 0; i < self->width; i++)
-    self->columns[i].size--;
+    qtb_column_pop(&self->columns[i]);
 
   return result;
 }
@@ -129,3 +773,221 @@ ResultPyObjectPtr qtb_table_blueprint_(QtbTable *self) {
 
   return ResultPyObjectPtrSuccess(blueprint);
 }
+
+Result qtb_table_reserve_(QtbTable *self, Py_ssize_t capacity) {
+  Result result;
+
+  if (capacity < 0) return ResultFailure(PyExc_ValueError, "capacity must be non-negative");
+
+  result = qtb_table_check_mutable(self);
+  if (ResultFailed(result)) return result;
+
+  for (Py_ssize_t i = 0; i < self->width; i++) {
+    result = qtb_column_reserve(&self->columns[i], (size_t)capacity);
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+Result qtb_table_shrink_to_fit_(QtbTable *self) {
+  Result result;
+
+  result = qtb_table_check_mutable(self);
+  if (ResultFailed(result)) return result;
+
+  for (Py_ssize_t i = 0; i < self->width; i++) {
+    result = qtb_column_shrink_to_fit(&self->columns[i]);
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+// Compresses the full chunks of one column, given by name or index, or when
+// key is NULL or None of every int-like and bool column.
+Result qtb_table_compress_(QtbTable *self, PyObject *key) {
+  ResultSize_t index;
+  Result result;
+
+  result = qtb_table_check_mutable(self);
+  if (ResultFailed(result)) return result;
+
+  if (key != NULL && key != Py_None) {
+    index = qtb_table_column_index_(self, key);
+    if (ResultFailed(index)) return ResultFailureFromResult(index);
+
+    return qtb_column_compress(&self->columns[ResultValue(index)]);
+  }
+
+  for (Py_ssize_t i = 0; i < self->width; i++) {
+    if (!qtb_column_compressible(&self->columns[i])) continue;
+
+    result = qtb_column_compress(&self->columns[i]);
+    if (ResultFailed(result)) return result;
+  }
+
+  return ResultSuccess();
+}
+
+// Chunks covering the table's rows. An empty table still has one, empty.
+static size_t qtb_table_chunk_count(QtbTable *self) {
+  if (self->size == 0) return 1;
+  return qtb_column_chunk_of((size_t)self->size - 1) + 1;
+}
+
+ResultPyObjectPtr qtb_table_column_buffer_(QtbTable *self, PyObject *key, Py_ssize_t chunk) {
+  ResultSize_t column;
+
+  column = qtb_table_column_index_(self, key);
+  if (ResultFailed(column)) return ResultPyObjectPtrFailureFromResult(column);
+
+  if (chunk < 0) chunk += (Py_ssize_t)qtb_table_chunk_count(self);
+  if (chunk < 0 || (size_t)chunk >= qtb_table_chunk_count(self))
+    return ResultPyObjectPtrFailure(PyExc_IndexError, "chunk index out of range");
+
+  return qtb_column_buffer_new_(self, ResultValue(column), (size_t)chunk);
+}
+
+ResultPyObjectPtr qtb_table_column_buffers_(QtbTable *self, PyObject *key) {
+  PyObject *buffers;
+  ResultSize_t column;
+  ResultPyObjectPtr result;
+  size_t n;
+
+  column = qtb_table_column_index_(self, key);
+  if (ResultFailed(column)) return ResultPyObjectPtrFailureFromResult(column);
+
+  n = qtb_table_chunk_count(self);
+  buffers = self->PyList_New((Py_ssize_t)n);
+  if (buffers == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  for (size_t i = 0; i < n; i++) {
+    result = qtb_column_buffer_new_(self, ResultValue(column), i);
+    if (ResultFailed(result)) {
+      Py_DECREF(buffers);
+      return result;
+    }
+
+    PyList_SET_ITEM(buffers, (Py_ssize_t)i, ResultValue(result));
+  }
+
+  return ResultPyObjectPtrSuccess(buffers);
+}
+
+// Rows that can be appended without allocating, counting the ones already
+// held. A table without columns never allocates, so its capacity is its size,
+// as is a view's.
+Py_ssize_t qtb_table_capacity_(QtbTable *self) {
+  size_t capacity;
+
+  if (self->width == 0 || self->base != NULL) return self->size;
+
+  capacity = self->columns[0].capacity;
+  for (Py_ssize_t i = 1; i < self->width; i++)
+    capacity = MIN(capacity, self->columns[i].capacity);
+
+  return (Py_ssize_t)capacity;
+}
+
+ResultPyObjectPtr qtb_table_memory_usage_(QtbTable *self) {
+  PyObject *usages;
+  PyObject *usage;
+  QtbColumnMemoryUsage column_usage;
+
+  usages = self->PyList_New(self->width);
+  if (usages == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  // Views hold no cells of their own.
+  for (Py_ssize_t i = 0; i < self->width; i++) {
+    column_usage = (QtbColumnMemoryUsage){0, 0, 0, 0};
+    if (self->base == NULL) column_usage = qtb_column_memory_usage(&self->columns[i]);
+    usage = Py_BuildValue(
+      "{s:s,s:n,s:n,s:n,s:n}",
+      "name", self->columns[i].name,
+      "used", (Py_ssize_t)column_usage.used,
+      "reserved", (Py_ssize_t)column_usage.reserved,
+      "strings", (Py_ssize_t)column_usage.strings,
+      "overhead", (Py_ssize_t)column_usage.overhead
+    );
+    if (usage == NULL) {
+      Py_DECREF(usages);
+      return ResultPyObjectPtrFailureFromPyErr();
+    }
+
+    PyList_SET_ITEM(usages, i, usage);
+  }
+
+  return ResultPyObjectPtrSuccess(usages);
+}
+
+static QtbIndex *qtb_table_index_of(QtbTable *self, size_t column) {
+  for (Py_ssize_t i = 0; i < self->n_indexes; i++)
+    if (self->indexes[i].column == column) return &self->indexes[i];
+
+  return NULL;
+}
+
+// Indexes a column of an owning table, at most once. A unique index fails to
+// build over a column that already repeats a key.
+Result qtb_table_create_index_(QtbTable *self, PyObject *key, bool unique) {
+  ResultSize_t column;
+  QtbIndex *indexes;
+  QtbIndex *index;
+  Result result;
+
+  if (self->base != NULL) return ResultFailure(PyExc_TypeError, "table view is read-only");
+
+  column = qtb_table_column_index_(self, key);
+  if (ResultFailed(column)) return ResultFailureFromResult(column);
+  if (qtb_table_index_of(self, ResultValue(column)) != NULL) return ResultFailure(PyExc_ValueError, "column already indexed");
+
+  indexes = (QtbIndex *)realloc(self->indexes, (self->n_indexes + 1) * sizeof(QtbIndex));
+  if (indexes == NULL) return ResultFailure(PyExc_MemoryError, "memory error");
+  self->indexes = indexes;
+
+  index = &self->indexes[self->n_indexes];
+  result = qtb_index_init(index, &self->columns[ResultValue(column)], ResultValue(column), unique, self->allocator);
+  if (ResultFailed(result)) return result;
+
+  result = qtb_index_extend(index, &self->columns[ResultValue(column)], (size_t)self->size);
+  if (ResultFailed(result)) {
+    qtb_index_dealloc(index);
+    return result;
+  }
+
+  self->n_indexes++;
+  return ResultSuccess();
+}
+
+// Positions of the rows whose cell in column equals key, through the
+// column's index. A view uses the index of its base.
+ResultPyObjectPtr qtb_table_lookup_(QtbTable *self, PyObject *column, PyObject *key) {
+  QtbTable *owner;
+  ResultSize_t position;
+  QtbIndex *index;
+
+  position = qtb_table_column_index_(self, column);
+  if (ResultFailed(position)) return ResultPyObjectPtrFailureFromResult(position);
+
+  owner = self->base != NULL ? (QtbTable *)self->base : self;
+  index = qtb_table_index_of(owner, ResultValue(position));
+  if (index == NULL) return ResultPyObjectPtrFailure(PyExc_KeyError, "no index on column");
+
+  return qtb_index_lookup(index, &self->columns[ResultValue(position)], key, self->offset, self->step, self->size);
+}
+
+size_t qtb_table_sizeof_(QtbTable *self) {
+  QtbColumnMemoryUsage usage;
+  size_t size;
+
+  size = sizeof(QtbTable);
+  for (Py_ssize_t i = 0; i < self->n_indexes; i++)
+    size += qtb_index_memory_usage(&self->indexes[i]);
+  for (Py_ssize_t i = 0; i < self->width && self->base == NULL; i++) {
+    usage = qtb_column_memory_usage(&self->columns[i]);
+    size += usage.reserved + usage.strings + usage.overhead;
+  }
+
+  return size;
+}
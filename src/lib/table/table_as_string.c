@@ -1,5 +1,6 @@
 #include <Python.h>
 #include "table.h"
+#include "table_as_string.h"
 #include "result.h"
 
 static ResultSize_tPtr qtb_table_as_string_paddings(QtbTable *self) {
@@ -143,11 +144,40 @@ static ResultCharPtr qtb_table_as_string(QtbTable *self) {
   return string;
 }
 
+// A view prints as a copy of the rows it shows.
+static ResultPyObjectPtr qtb_table_view_as_py_string(QtbTable *self) {
+  PyObject *five;
+  PyObject *slice;
+  ResultPyObjectPtr head;
+  ResultPyObjectPtr copy;
+  ResultPyObjectPtr string;
+
+  five = PyLong_FromLong(5);
+  if (five == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  slice = PySlice_New(NULL, five, NULL);
+  Py_DECREF(five);
+  if (slice == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  head = qtb_table_slice_(self, slice);
+  Py_DECREF(slice);
+  if (ResultFailed(head)) return head;
+
+  copy = qtb_table_copy_((QtbTable *)ResultValue(head));
+  Py_DECREF(ResultValue(head));
+  if (ResultFailed(copy)) return copy;
+
+  string = qtb_table_as_py_string_((QtbTable *)ResultValue(copy));
+  Py_DECREF(ResultValue(copy));
+  return string;
+}
+
 ResultPyObjectPtr qtb_table_as_py_string_(QtbTable *self) {
   PyObject *py_string;
   ResultCharPtr string;
 
   if (self->width == 0) return qtb_table_as_string_empty();
+  if (self->base != NULL) return qtb_table_view_as_py_string(self);
 
   string = qtb_table_as_string(self);
   if (ResultFailed(string)) return ResultPyObjectPtrFailureFromResult(string);
@@ -0,0 +1,116 @@
+#include <Python.h>
+#include "table_iterator.h"
+
+ResultPyObjectPtr qtb_table_iterator_new_(QtbTable *table) {
+  QtbTableIterator *self;
+
+  self = PyObject_New(QtbTableIterator, &QtbTableIteratorType);
+  if (self == NULL) return ResultPyObjectPtrFailureFromPyErr();
+
+  Py_INCREF(table);
+  self->table = table;
+  self->i = 0;
+  self->row = NULL;
+
+  return ResultPyObjectPtrSuccess((PyObject *)self);
+}
+
+static void qtb_table_iterator_dealloc(QtbTableIterator *self) {
+  Py_DECREF(self->table);
+  Py_XDECREF(self->row);
+  PyObject_Free(self);
+}
+
+// The table is read as it is at each step, so rows appended while iterating
+// are yielded too and popping one ends the iteration early.
+static PyObject *qtb_table_iterator_next(QtbTableIterator *self) {
+  QtbTable *table = self->table;
+  PyObject *row;
+  PyObject *old;
+  size_t at;
+  ResultPyObjectPtr cell;
+
+  if (self->i >= table->size) return NULL;
+
+  // Only this iterator holds the last row, so nobody can see it refilled.
+  if (self->row != NULL && Py_REFCNT(self->row) == 1 && PyTuple_GET_SIZE(self->row) == table->width) {
+    row = self->row;
+    Py_INCREF(row);
+  } else {
+    row = PyTuple_New(table->width);
+    if (row == NULL) return NULL;
+
+    Py_XDECREF(self->row);
+    self->row = row;
+    Py_INCREF(row);
+  }
+
+  at = qtb_table_row(table, self->i);
+  for (Py_ssize_t j = 0; j < table->width; j++) {
+    cell = qtb_column_get_as_pyobject(&table->columns[j], at);
+    if (ResultFailed(cell)) {
+      // The row may be part filled, so it is not handed out or kept.
+      Py_DECREF(row);
+      Py_CLEAR(self->row);
+      ResultFailureRaise(cell);
+      return NULL;
+    }
+
+    old = PyTuple_GET_ITEM(row, j);
+    PyTuple_SET_ITEM(row, j, ResultValue(cell));
+    Py_XDECREF(old);
+  }
+
+  self->i++;
+  return row;
+}
+
+static PyObject *qtb_table_iterator_length_hint(QtbTableIterator *self) {
+  return PyLong_FromSsize_t(self->i < self->table->size ? self->table->size - self->i : 0);
+}
+
+static PyMethodDef qtb_table_iterator_methods[] = {
+  {"__length_hint__", (PyCFunction)qtb_table_iterator_length_hint, METH_NOARGS, "rows left"},
+  {NULL, NULL}
+};
+
+PyTypeObject QtbTableIteratorType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "quicktable.TableIterator",  // tp_name
+    sizeof(QtbTableIterator),  // tp_basicsize
+    0,  // tp_itemsize
+    (destructor)qtb_table_iterator_dealloc,  // tp_dealloc
+    0,  // tp_print
+    0,  // tp_getattr
+    0,  // tp_setattr
+    0,  // tp_reserved
+    0,  // tp_repr
+    0,  // tp_as_number
+    0,  // tp_as_sequence
+    0,  // tp_as_mapping
+    0,  // tp_hash
+    0,  // tp_call
+    0,  // tp_str
+    0,  // tp_getattro
+    0,  // tp_setattro
+    0,  // tp_as_buffer
+    Py_TPFLAGS_DEFAULT,  // tp_flags
+    "Iterator over the rows of a table as tuples",  // tp_doc
+    0,  // tp_traverse
+    0,  // tp_clear
+    0,  // tp_richcompare
+    0,  // tp_weaklistoffset
+    PyObject_SelfIter,  // tp_iter
+    (iternextfunc)qtb_table_iterator_next,  // tp_iternext
+    qtb_table_iterator_methods,  // tp_methods
+    0,  // tp_members
+    0,  // tp_getset
+    0,  // tp_base
+    0,  // tp_dict
+    0,  // tp_descr_get
+    0,  // tp_descr_set
+    0,  // tp_dictoffset
+    0,  // tp_init
+    0,  // tp_alloc
+    0  // tp_new
+};
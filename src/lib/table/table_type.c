@@ -1,6 +1,10 @@
 #include <Python.h>
 #include "table.h"
 #include "table_as_string.h"
+#include "csv.h"
+#include "arrow.h"
+#include "table_file.h"
+#include "table_iterator.h"
 
 static PyObject *qtb_table_new(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
   QtbTable *self;
@@ -17,18 +21,42 @@ static void qtb_table_dealloc(QtbTable *self) {
 }
 
 static int qtb_table_init(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"capacity", "allocator", NULL};
   PyObject *blueprint = NULL;
+  PyObject *allocator = NULL;
+  PyObject *no_args;
+  Py_ssize_t capacity = 0;
   Result result;
+  int parsed;
 
   if (!PyArg_ParseTuple(args, "O", &blueprint))
     return -1;
 
+  if (kwargs != NULL) {
+    if ((no_args = PyTuple_New(0)) == NULL) return -1;
+    parsed = PyArg_ParseTupleAndKeywords(no_args, kwargs, "|$nO", kwlist, &capacity, &allocator);
+    Py_DECREF(no_args);
+    if (!parsed) return -1;
+  }
+
+  result = qtb_table_use_allocator_(self, allocator);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return -1;
+  }
+
   result = qtb_table_init_(self, blueprint);
   if (ResultFailed(result)) {
     ResultFailureRaise(result);
     return -1;
   }
 
+  result = qtb_table_reserve_(self, capacity);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return -1;
+  }
+
   return 0;
 }
 
@@ -59,16 +87,37 @@ static PySequenceMethods qtb_table_as_sequence = {
 
 static PyObject *qtb_table_subscript(QtbTable *self, PyObject *key) {
   Py_ssize_t i;
+  ResultPyObjectPtr result;
 
-  if PyIndex_Check(key) {
+  if (PyIndex_Check(key)) {
     i = PyNumber_AsSsize_t(key, PyExc_IndexError);
     if (i == -1 && PyErr_Occurred()) return NULL;
 
     return qtb_table_item(self, i);
   }
 
-  Py_INCREF(Py_None);
-  return Py_None;
+  if (PyUnicode_Check(key)) result = qtb_table_column_(self, key);
+  else if (PySlice_Check(key)) result = qtb_table_slice_(self, key);
+  else result = ResultPyObjectPtrFailure(PyExc_TypeError, "table indices must be integers, slices or column names");
+
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_iter(QtbTable *self) {
+  ResultPyObjectPtr result;
+
+  result = qtb_table_iterator_new_(self);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
 }
 
 static PyMappingMethods qtb_table_as_mapping = {
@@ -89,6 +138,74 @@ static PyObject *qtb_table_append(QtbTable *self, PyObject *row) {
   Py_RETURN_NONE;
 }
 
+static PyObject *qtb_table_extend(QtbTable *self, PyObject *rows) {
+  Result result;
+
+  result = qtb_table_extend_(self, rows);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+// Table.from_columns(blueprint, columns, **kwargs) takes the same keyword
+// arguments as Table.
+static PyObject *qtb_table_from_columns(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+  PyObject *blueprint;
+  PyObject *columns;
+  PyObject *table_args;
+  PyObject *table;
+  Result result;
+
+  if (!PyArg_ParseTuple(args, "OO", &blueprint, &columns))
+    return NULL;
+
+  if ((table_args = PyTuple_Pack(1, blueprint)) == NULL) return NULL;
+  table = PyObject_Call((PyObject *)type, table_args, kwargs);
+  Py_DECREF(table_args);
+  if (table == NULL) return NULL;
+
+  result = qtb_table_extend_columns_((QtbTable *)table, columns, "from_columns");
+  if (ResultFailed(result)) {
+    Py_DECREF(table);
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return table;
+}
+
+// Table.from_arrow(data, **kwargs) takes the same keyword arguments as Table.
+static PyObject *qtb_table_from_arrow(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+  PyObject *data;
+  ResultPyObjectPtr result;
+
+  if (!PyArg_ParseTuple(args, "O", &data))
+    return NULL;
+
+  result = qtb_arrow_import_(type, data, kwargs);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_extend_columns(QtbTable *self, PyObject *columns) {
+  Result result;
+
+  result = qtb_table_extend_columns_(self, columns, "extend_columns");
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
 static PyObject *qtb_table_pop(QtbTable *self) {
   ResultPyObjectPtr result;
 
@@ -101,9 +218,340 @@ static PyObject *qtb_table_pop(QtbTable *self) {
   return ResultValue(result);
 }
 
+static PyObject *qtb_table_reserve(QtbTable *self, PyObject *capacity) {
+  Py_ssize_t n;
+  Result result;
+
+  n = PyNumber_AsSsize_t(capacity, PyExc_OverflowError);
+  if (n == -1 && PyErr_Occurred()) return NULL;
+
+  result = qtb_table_reserve_(self, n);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+static PyObject *qtb_table_shrink_to_fit(QtbTable *self) {
+  Result result;
+
+  result = qtb_table_shrink_to_fit_(self);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+// Table.compress(column=None)
+static PyObject *qtb_table_compress(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"column", NULL};
+  PyObject *column = Py_None;
+  Result result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwlist, &column))
+    return NULL;
+
+  result = qtb_table_compress_(self, column);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+static PyObject *qtb_table_create_index(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"column", "unique", NULL};
+  PyObject *column;
+  int unique = 0;
+  Result result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$p", kwlist, &column, &unique))
+    return NULL;
+
+  result = qtb_table_create_index_(self, column, unique);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+static PyObject *qtb_table_lookup(QtbTable *self, PyObject *args) {
+  PyObject *column;
+  PyObject *key;
+  ResultPyObjectPtr result;
+
+  if (!PyArg_ParseTuple(args, "OO", &column, &key))
+    return NULL;
+
+  result = qtb_table_lookup_(self, column, key);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_memory_usage(QtbTable *self) {
+  ResultPyObjectPtr result;
+
+  result = qtb_table_memory_usage_(self);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+// Table.to_csv(path_or_file, sep=',', *, header=True)
+static PyObject *qtb_table_to_csv(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"path_or_file", "sep", "header", NULL};
+  PyObject *destination;
+  int sep = ',';
+  int header = 1;
+  QtbCsvOptions options;
+  Result result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|C$p", kwlist, &destination, &sep, &header))
+    return NULL;
+
+  if (sep > 127) {
+    PyErr_SetString(PyExc_ValueError, "invalid delimiter");
+    return NULL;
+  }
+
+  options = (QtbCsvOptions){(char)sep, header != 0, 0};
+  result = qtb_csv_write_(self, destination, &options);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+// Table.column(key)
+static PyObject *qtb_table_column(QtbTable *self, PyObject *key) {
+  ResultPyObjectPtr result;
+
+  result = qtb_table_column_(self, key);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_copy(QtbTable *self) {
+  ResultPyObjectPtr result;
+
+  result = qtb_table_copy_(self);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_take(QtbTable *self, PyObject *indices) {
+  ResultPyObjectPtr result;
+
+  result = qtb_table_take_(self, indices);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_filter(QtbTable *self, PyObject *mask) {
+  ResultPyObjectPtr result;
+
+  result = qtb_table_filter_(self, mask);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+// The methods that hand out chunks or write them as they are work on a copy
+// of a view, and on the table itself otherwise.
+static QtbTable *qtb_table_materialize(QtbTable *self) {
+  if (self->base == NULL) {
+    Py_INCREF(self);
+    return self;
+  }
+
+  return (QtbTable *)qtb_table_copy(self);
+}
+
+// Table.save(path), read back with quicktable.load
+static PyObject *qtb_table_save(QtbTable *self, PyObject *args) {
+  PyObject *path;
+  QtbTable *table;
+  Result result;
+
+  if (!PyArg_ParseTuple(args, "O&", &PyUnicode_FSConverter, &path))
+    return NULL;
+
+  table = qtb_table_materialize(self);
+  if (table == NULL) {
+    Py_DECREF(path);
+    return NULL;
+  }
+
+  result = qtb_table_file_save_(table, PyBytes_AS_STRING(path));
+  Py_DECREF(table);
+  Py_DECREF(path);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+// Table.column_buffer(column, chunk=0)
+static PyObject *qtb_table_column_buffer(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"column", "chunk", NULL};
+  PyObject *column;
+  QtbTable *table;
+  Py_ssize_t chunk = 0;
+  ResultPyObjectPtr result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", kwlist, &column, &chunk))
+    return NULL;
+
+  table = qtb_table_materialize(self);
+  if (table == NULL) return NULL;
+
+  result = qtb_table_column_buffer_(table, column, chunk);
+  Py_DECREF(table);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_column_buffers(QtbTable *self, PyObject *column) {
+  QtbTable *table;
+  ResultPyObjectPtr result;
+
+  table = qtb_table_materialize(self);
+  if (table == NULL) return NULL;
+
+  result = qtb_table_column_buffers_(table, column);
+  Py_DECREF(table);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_arrow_c_schema(QtbTable *self) {
+  ResultPyObjectPtr result;
+
+  result = qtb_arrow_schema_capsule_(self);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+// requested_schema is accepted as the PyCapsule interface requires and then
+// ignored, which the interface allows: columns always export as their own type.
+static PyObject *qtb_table_arrow_c_array(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"requested_schema", NULL};
+  PyObject *requested_schema = Py_None;
+  QtbTable *table;
+  ResultPyObjectPtr result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwlist, &requested_schema))
+    return NULL;
+
+  table = qtb_table_materialize(self);
+  if (table == NULL) return NULL;
+
+  result = qtb_arrow_array_capsules_(table);
+  Py_DECREF(table);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_arrow_c_stream(QtbTable *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"requested_schema", NULL};
+  PyObject *requested_schema = Py_None;
+  QtbTable *table;
+  ResultPyObjectPtr result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwlist, &requested_schema))
+    return NULL;
+
+  table = qtb_table_materialize(self);
+  if (table == NULL) return NULL;
+
+  result = qtb_arrow_stream_capsule_(table);
+  Py_DECREF(table);
+  if (ResultFailed(result)) {
+    ResultFailureRaise(result);
+    return NULL;
+  }
+
+  return ResultValue(result);
+}
+
+static PyObject *qtb_table_sizeof(QtbTable *self) {
+  return PyLong_FromSize_t(qtb_table_sizeof_(self));
+}
+
 static PyMethodDef qtb_table_methods[] = {
   {"append", (PyCFunction)qtb_table_append, METH_O, "append"},
+  {"extend", (PyCFunction)qtb_table_extend, METH_O, "append every row of an iterable"},
+  {"from_columns", (PyCFunction)qtb_table_from_columns, METH_VARARGS | METH_KEYWORDS | METH_CLASS, "table built from one sequence per column"},
+  {"extend_columns", (PyCFunction)qtb_table_extend_columns, METH_O, "append one sequence or buffer per column"},
   {"pop", (PyCFunction)qtb_table_pop, METH_NOARGS, "pop"},
+  {"reserve", (PyCFunction)qtb_table_reserve, METH_O, "reserve room for at least n rows"},
+  {"shrink_to_fit", (PyCFunction)qtb_table_shrink_to_fit, METH_NOARGS, "release unused capacity"},
+  {"compress", (PyCFunction)qtb_table_compress, METH_VARARGS | METH_KEYWORDS, "compress full chunks of int-like and bool columns"},
+  {"memory_usage", (PyCFunction)qtb_table_memory_usage, METH_NOARGS, "bytes held by each column"},
+  {"create_index", (PyCFunction)qtb_table_create_index, METH_VARARGS | METH_KEYWORDS, "hash index over a str, category or int column, optionally unique"},
+  {"lookup", (PyCFunction)qtb_table_lookup, METH_VARARGS, "positions of the rows whose indexed column holds key"},
+  {"column", (PyCFunction)qtb_table_column, METH_O, "view of one column, by name or position"},
+  {"copy", (PyCFunction)qtb_table_copy, METH_NOARGS, "table holding its own copy of the rows, e.g. of a view"},
+  {"take", (PyCFunction)qtb_table_take, METH_O, "new table of the rows at the given indices"},
+  {"filter", (PyCFunction)qtb_table_filter, METH_O, "new table of the rows whose mask flag is true"},
+  {"to_csv", (PyCFunction)qtb_table_to_csv, METH_VARARGS | METH_KEYWORDS, "write the table as CSV to a path or file"},
+  {"save", (PyCFunction)qtb_table_save, METH_VARARGS, "write the table to a file that quicktable.load maps back in"},
+  {"column_buffer", (PyCFunction)qtb_table_column_buffer, METH_VARARGS | METH_KEYWORDS, "read-only buffer over one chunk of a numeric column"},
+  {"column_buffers", (PyCFunction)qtb_table_column_buffers, METH_O, "one column_buffer per chunk of a numeric column"},
+  {"from_arrow", (PyCFunction)qtb_table_from_arrow, METH_VARARGS | METH_KEYWORDS | METH_CLASS, "table copied from an Arrow array or stream"},
+  {"__arrow_c_schema__", (PyCFunction)qtb_table_arrow_c_schema, METH_NOARGS, "Arrow schema capsule"},
+  {"__arrow_c_array__", (PyCFunction)qtb_table_arrow_c_array, METH_VARARGS | METH_KEYWORDS, "Arrow schema and struct array capsules"},
+  {"__arrow_c_stream__", (PyCFunction)qtb_table_arrow_c_stream, METH_VARARGS | METH_KEYWORDS, "Arrow stream capsule, one batch per chunk"},
+  {"__sizeof__", (PyCFunction)qtb_table_sizeof, METH_NOARGS, "bytes held by the table"},
   {NULL, NULL}
 };
 
@@ -119,8 +567,13 @@ static PyObject *qtb_table_blueprint(QtbTable *self, void *closure) {
   return ResultValue(result);
 }
 
+static PyObject *qtb_table_capacity(QtbTable *self, void *closure) {
+  return PyLong_FromSsize_t(qtb_table_capacity_(self));
+}
+
 static PyGetSetDef qtb_table_getsetters[] = {
   {"blueprint", (getter)qtb_table_blueprint, NULL, "copy of table's blueprint", NULL},
+  {"capacity", (getter)qtb_table_capacity, NULL, "rows the table can hold without allocating", NULL},
   {NULL}
 };
 
@@ -162,7 +615,7 @@ PyTypeObject QtbTableType = {
     0,  // tp_clear
     0,  // tp_richcompare
     0,  // tp_weaklistoffset
-    0,  // tp_iter
+    (getiterfunc)qtb_table_iter,  // tp_iter
     0,  // tp_iternext
     qtb_table_methods,  // tp_methods
     0,  // tp_members
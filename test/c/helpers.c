@@ -31,12 +31,48 @@ void assert_exc_string_equal(const char *test_string) {
   free(exc_string);
 }
 
+static void *allocator_malloc_FAIL_(QtbAllocator *allocator, size_t size) {
+  return NULL;
+}
+
+static void *allocator_realloc_FAIL_(QtbAllocator *allocator, void *p, size_t size) {
+  return NULL;
+}
+
+static void *allocator_malloc_(QtbAllocator *allocator, size_t size) {
+  return malloc(size);
+}
+
+static void *allocator_realloc_(QtbAllocator *allocator, void *p, size_t size) {
+  return realloc(p, size);
+}
+
+static void allocator_free_(QtbAllocator *allocator, void *p) {
+  free(p);
+}
+
+static void allocator_dealloc_(QtbAllocator *allocator) {}
+
+QtbAllocator allocator_malloc_FAIL = {
+  .malloc = &allocator_malloc_FAIL_,
+  .realloc = &allocator_realloc_,
+  .free = &allocator_free_,
+  .dealloc = &allocator_dealloc_,
+};
+
+QtbAllocator allocator_realloc_FAIL = {
+  .malloc = &allocator_malloc_,
+  .realloc = &allocator_realloc_FAIL_,
+  .free = &allocator_free_,
+  .dealloc = &allocator_dealloc_,
+};
+
 char *strdup_FAIL(const char *s) {
   return NULL;
 }
 
-const char *PyUnicode_AsUTF8_FAIL(PyObject *s) {
-  PyErr_SetString(PyExc_RuntimeError, "PyUnicode_AsUTF8 failed");
+const char *PyUnicode_AsUTF8AndSize_FAIL(PyObject *s, Py_ssize_t *size) {
+  PyErr_SetString(PyExc_RuntimeError, "PyUnicode_AsUTF8AndSize failed");
   return NULL;
 }
 
@@ -11,11 +11,13 @@ char *strdup_FAIL(const char *);
 void *malloc_FAIL(size_t);
 void *realloc_FAIL(void *, size_t);
 int snprintf_FAIL(char *, size_t, const char *, ...);
-const char *PyUnicode_AsUTF8_FAIL(PyObject *);
+const char *PyUnicode_AsUTF8AndSize_FAIL(PyObject *, Py_ssize_t *);
 Py_ssize_t PySequence_Size_FAIL(PyObject *);
 PyObject *PyList_New_FAIL(Py_ssize_t);
 ResultQtbColumnPtr qtb_column_new_many_FAIL(size_t);
 Result qtb_column_init_many_FAIL(QtbColumn *, PyObject *, Py_ssize_t);
+extern QtbAllocator allocator_malloc_FAIL;
+extern QtbAllocator allocator_realloc_FAIL;
 
 PyObject *PyUnicode_FromString_SUCCESS(const char *);
 PyObject *PyLong_FromLongLong_SUCCESS(long long n);
@@ -0,0 +1,184 @@
+#include <Python.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "allocator.h"
+#include "helpers.h"
+
+static void test_qtb_allocator_arena_realloc_last_in_place(void **state) {
+  QtbAllocator allocator;
+  char *first;
+  char *grown;
+
+  qtb_allocator_arena_new(&allocator);
+
+  first = (char *)qtb_malloc(&allocator, 16);
+  assert_non_null(first);
+  memcpy(first, "Pikachu", 8);
+
+  grown = (char *)qtb_realloc(&allocator, first, 1024);
+  assert_ptr_equal(first, grown);
+  assert_string_equal("Pikachu", grown);
+  assert_int_equal(allocator.n_blocks, 1);
+
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_arena_realloc_moves_earlier(void **state) {
+  QtbAllocator allocator;
+  char *first;
+  char *second;
+  char *moved;
+
+  qtb_allocator_arena_new(&allocator);
+
+  first = (char *)qtb_malloc(&allocator, 16);
+  memcpy(first, "Pikachu", 8);
+  second = (char *)qtb_malloc(&allocator, 16);
+  assert_non_null(second);
+
+  moved = (char *)qtb_realloc(&allocator, first, 64);
+  assert_ptr_not_equal(first, moved);
+  assert_string_equal("Pikachu", moved);
+
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_arena_free_last_rewinds(void **state) {
+  QtbAllocator allocator;
+  void *first;
+  size_t used;
+
+  qtb_allocator_arena_new(&allocator);
+
+  first = qtb_malloc(&allocator, 16);
+  used = allocator.used;
+  qtb_free(&allocator, qtb_malloc(&allocator, 100));
+  assert_int_equal(allocator.used, used);
+  assert_non_null(first);
+
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_arena_oversized_gets_own_block(void **state) {
+  QtbAllocator allocator;
+  void *small;
+
+  qtb_allocator_arena_new(&allocator);
+
+  small = qtb_malloc(&allocator, 16);
+  assert_non_null(qtb_malloc(&allocator, 2 * QTB_ALLOCATOR_ARENA_INITIAL_BLOCK_SIZE));
+  assert_int_equal(allocator.n_blocks, 2);
+  assert_int_equal(allocator.current, 0);
+  assert_ptr_equal((char *)qtb_malloc(&allocator, 16), (char *)small + 32);
+
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_hugepage_blocks_are_aligned(void **state) {
+  QtbAllocator allocator;
+  char *p;
+
+  qtb_allocator_hugepage_new(&allocator);
+
+  p = (char *)qtb_malloc(&allocator, 100);
+  assert_non_null(p);
+  memset(p, 'a', 100);
+  assert_int_equal((uintptr_t)allocator.blocks[0].base % QTB_ALLOCATOR_HUGEPAGE_SIZE, 0);
+  assert_int_equal(allocator.blocks[0].size, QTB_ALLOCATOR_HUGEPAGE_SIZE);
+
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_pool_reuses_freed(void **state) {
+  QtbAllocator allocator;
+  void *first;
+
+  qtb_allocator_pool_new(&allocator);
+
+  first = qtb_malloc(&allocator, 100);
+  qtb_free(&allocator, first);
+  assert_int_equal(allocator.cached, 128);
+
+  assert_ptr_equal(qtb_malloc(&allocator, 120), first);
+  assert_int_equal(allocator.cached, 0);
+
+  qtb_free(&allocator, first);
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_pool_realloc_within_class(void **state) {
+  QtbAllocator allocator;
+  char *p;
+  char *grown;
+
+  qtb_allocator_pool_new(&allocator);
+
+  p = (char *)qtb_malloc(&allocator, 70);
+  memcpy(p, "Pikachu", 8);
+  assert_ptr_equal(qtb_realloc(&allocator, p, 128), p);
+
+  grown = (char *)qtb_realloc(&allocator, p, 129);
+  assert_ptr_not_equal(grown, p);
+  assert_string_equal("Pikachu", grown);
+  assert_int_equal(allocator.cached, 128);
+
+  qtb_free(&allocator, grown);
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_pool_large_is_not_pooled(void **state) {
+  QtbAllocator allocator;
+
+  qtb_allocator_pool_new(&allocator);
+
+  qtb_free(&allocator, qtb_malloc(&allocator, ((size_t)1 << QTB_ALLOCATOR_POOL_MAX_CLASS) + 1));
+  assert_int_equal(allocator.cached, 0);
+
+  qtb_allocator_dealloc(&allocator);
+}
+
+static void test_qtb_allocator_mapped_realloc_moves_out_of_image(void **state) {
+  QtbAllocator allocator;
+  char *image;
+  char *in_image;
+  char *moved;
+
+  image = (char *)calloc(1, 64);
+  assert_non_null(image);
+  in_image = image + sizeof(QtbAllocationHeader);
+  qtb_allocation_header_of(in_image)->size = 8;
+  memcpy(in_image, "Pikachu", 8);
+
+  qtb_allocator_mapped_new(&allocator, image, 64, false);
+
+  qtb_free(&allocator, in_image);
+  assert_string_equal("Pikachu", in_image);
+
+  moved = (char *)qtb_realloc(&allocator, in_image, 1024);
+  assert_ptr_not_equal(in_image, moved);
+  assert_string_equal("Pikachu", moved);
+
+  moved = (char *)qtb_realloc(&allocator, moved, 2048);
+  assert_string_equal("Pikachu", moved);
+
+  qtb_free(&allocator, moved);
+  qtb_allocator_dealloc(&allocator);
+}
+
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_qtb_allocator_arena_realloc_last_in_place),
+    cmocka_unit_test(test_qtb_allocator_arena_realloc_moves_earlier),
+    cmocka_unit_test(test_qtb_allocator_arena_free_last_rewinds),
+    cmocka_unit_test(test_qtb_allocator_arena_oversized_gets_own_block),
+    cmocka_unit_test(test_qtb_allocator_hugepage_blocks_are_aligned),
+    cmocka_unit_test(test_qtb_allocator_pool_reuses_freed),
+    cmocka_unit_test(test_qtb_allocator_pool_realloc_within_class),
+    cmocka_unit_test(test_qtb_allocator_pool_large_is_not_pooled),
+    cmocka_unit_test(test_qtb_allocator_mapped_realloc_moves_out_of_image),
+};
+
+int test_allocator_run() {
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
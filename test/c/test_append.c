@@ -45,13 +45,14 @@ static void test_qtb_column_append(void **state) {
 
   assert_true(ResultSuccessful(result));
   assert_int_equal(column->size, 1);
-  assert_string_equal("Pikachu", column->data[0].s);
+  assert_int_equal(qtb_column_str_size_at(column, 0), 7);
+  assert_memory_equal("Pikachu", qtb_column_str_at(column, 0), 7);
 
   qtb_column_dealloc(column);
   free(column);
 }
 
-static void test_qtb_column_append_str_strdup_fails(void **state) {
+static void test_qtb_column_append_str_arena_malloc_fails(void **state) {
   QtbColumn *column;
   PyObject *descriptor;
   PyObject *name;
@@ -59,24 +60,24 @@ static void test_qtb_column_append_str_strdup_fails(void **state) {
 
   column = qtb_column_new_SUCCESS();
   descriptor = new_descriptor("Name", "str");
-  name = PyUnicode_FromString_SUCCESS("Pikachu");
+  name = PyUnicode_FromString_SUCCESS("Pikachu, the electric mouse");
 
   qtb_column_init_SUCCESS(column, descriptor);
   Py_DECREF(descriptor);
-  column->strdup = &strdup_FAIL;
+  column->arena.allocator = &allocator_malloc_FAIL;
 
   result = qtb_column_append(column, name);
   Py_DECREF(name);
 
   assert_true(ResultFailed(result));
-  assert_string_equal("could not create PyUnicodeobject", ResultFailureMessage(result));
+  assert_string_equal("failed to grow string arena", ResultFailureMessage(result));
   assert_int_equal(column->size, 0);
 
   qtb_column_dealloc(column);
   free(column);
 }
 
-static void test_qtb_column_append_str_PyUnicode_AsUTF8_fails(void **state) {
+static void test_qtb_column_append_str_PyUnicode_AsUTF8AndSize_fails(void **state) {
   QtbColumn *column;
   PyObject *descriptor;
   PyObject *name;
@@ -87,12 +88,12 @@ static void test_qtb_column_append_str_PyUnicode_AsUTF8_fails(void **state) {
   name = PyUnicode_FromString_SUCCESS("Pikachu");
   qtb_column_init_SUCCESS(column, descriptor);
   Py_DECREF(descriptor);
-  column->PyUnicode_AsUTF8 = &PyUnicode_AsUTF8_FAIL;
+  column->PyUnicode_AsUTF8AndSize = &PyUnicode_AsUTF8AndSize_FAIL;
 
   result = qtb_column_append(column, name);
   assert_true(ResultFailed(result));
   ResultFailureRaise(result);
-  assert_exc_string_equal("PyUnicode_AsUTF8 failed");
+  assert_exc_string_equal("PyUnicode_AsUTF8AndSize failed");
   assert_int_equal(column->size, 0);
 
   Py_DECREF(name);
@@ -109,7 +110,7 @@ static void test_qtb_column_append_grow_fails(void **state) {
   column = qtb_column_new_SUCCESS();
   descriptor = new_descriptor("Name", "str");
   qtb_column_init_SUCCESS(column, descriptor);
-  column->realloc = &realloc_FAIL;
+  column->allocator = &allocator_realloc_FAIL;
 
   name = PyUnicode_FromString_SUCCESS("Pikachu");
 
@@ -126,11 +127,163 @@ static void test_qtb_column_append_grow_fails(void **state) {
   free(column);
 }
 
+static void test_qtb_column_append_int(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *level;
+
+  descriptor = new_descriptor("Level", "int");
+  level = PyLong_FromLongLong_SUCCESS(-9000000000);
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  qtb_column_append_SUCCESS(column, level);
+  Py_DECREF(level);
+
+  assert_int_equal(column->size, 1);
+  assert_true(qtb_column_int_at(column, 0) == -9000000000);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_append_bool_packs_bits(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+
+  descriptor = new_descriptor("Wild", "bool");
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  for (size_t i = 0; i < 70; i++)
+    qtb_column_append_SUCCESS(column, i % 3 == 0 ? Py_True : Py_False);
+
+  assert_int_equal(column->size, 70);
+  assert_true(qtb_column_bool_word(column, 0) == 0x9249249249249249);
+  for (size_t i = 0; i < 70; i++)
+    assert_int_equal(qtb_column_bool_at(column, i), i % 3 == 0);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_append_str_short_is_inlined(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *name;
+
+  descriptor = new_descriptor("Name", "str");
+  name = PyUnicode_FromString_SUCCESS("Charmander12");
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  qtb_column_append_SUCCESS(column, name);
+  Py_DECREF(name);
+
+  assert_int_equal(sizeof(QtbColumnStr), 16);
+  assert_int_equal(column->arena.n_blocks, 0);
+  assert_ptr_equal(qtb_column_str_at(column, 0), qtb_column_str_cell(column, 0)->value.inlined);
+  assert_true(qtb_column_str_equals(column, 0, "Charmander12", 12));
+  assert_false(qtb_column_str_equals(column, 0, "Charmander13", 12));
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_append_str_long_uses_arena(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *name;
+
+  descriptor = new_descriptor("Name", "str");
+  name = PyUnicode_FromString_SUCCESS("Charmander123");
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  qtb_column_append_SUCCESS(column, name);
+  Py_DECREF(name);
+
+  assert_int_equal(column->arena.n_blocks, 1);
+  assert_memory_equal("Char", qtb_column_str_cell(column, 0)->value.ref.prefix, 4);
+  assert_memory_equal("Charmander123", qtb_column_str_at(column, 0), 13);
+  assert_true(qtb_column_str_equals(column, 0, "Charmander123", 13));
+  assert_false(qtb_column_str_equals(column, 0, "Charmander124", 13));
+  assert_false(qtb_column_str_equals(column, 0, "Bulbasaur1234", 13));
+
+  qtb_column_pop(column);
+  assert_int_equal(column->arena.used, 0);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_append_none_clears_validity(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *level;
+
+  descriptor = new_descriptor("Level", "int?");
+  level = PyLong_FromLongLong_SUCCESS(12);
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  assert_true(column->nullable);
+
+  qtb_column_append_SUCCESS(column, level);
+  qtb_column_append_SUCCESS(column, Py_None);
+  qtb_column_append_SUCCESS(column, level);
+  Py_DECREF(level);
+
+  assert_int_equal(qtb_column_validity_word(column, 0) & 0x7, 0x5);
+  assert_true(qtb_column_is_valid(column, 0));
+  assert_false(qtb_column_is_valid(column, 1));
+  assert_int_equal(qtb_column_int_at(column, 1), 0);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_append_spills_into_new_chunk(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *level;
+
+  descriptor = new_descriptor("Level", "int");
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  for (size_t i = 0; i <= QTB_COLUMN_CHUNK_SIZE; i++) {
+    level = PyLong_FromLongLong_SUCCESS(i);
+    qtb_column_append_SUCCESS(column, level);
+    Py_DECREF(level);
+  }
+
+  assert_int_equal(column->n_chunks, 2);
+  assert_int_equal(qtb_column_chunk_rows(column, 0), QTB_COLUMN_CHUNK_SIZE);
+  assert_int_equal(qtb_column_int_at(column, QTB_COLUMN_CHUNK_SIZE - 1), QTB_COLUMN_CHUNK_SIZE - 1);
+  assert_int_equal(qtb_column_int_at(column, QTB_COLUMN_CHUNK_SIZE), QTB_COLUMN_CHUNK_SIZE);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
 static const struct CMUnitTest tests[] = {
     cmocka_unit_test_setup_teardown(test_qtb_column_append, setup, teardown),
-    cmocka_unit_test_setup_teardown(test_qtb_column_append_str_strdup_fails, setup, teardown),
-    cmocka_unit_test_setup_teardown(test_qtb_column_append_str_PyUnicode_AsUTF8_fails, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_str_arena_malloc_fails, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_str_PyUnicode_AsUTF8AndSize_fails, setup, teardown),
     cmocka_unit_test_setup_teardown(test_qtb_column_append_grow_fails, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_int, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_bool_packs_bits, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_str_short_is_inlined, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_str_long_uses_arena, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_none_clears_validity, setup, teardown),
+    cmocka_unit_test_setup_teardown(test_qtb_column_append_spills_into_new_chunk, setup, teardown),
 };
 
 int test_append_run() {
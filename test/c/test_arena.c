@@ -0,0 +1,148 @@
+#include <Python.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "arena.h"
+#include "helpers.h"
+
+static int setup(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)malloc(sizeof(PyGILState_STATE));
+  *gstate = PyGILState_Ensure();
+
+  *state = (void *)gstate;
+  return 0;
+}
+
+static int teardown(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)(*state);
+  PyErr_Clear();
+  PyGILState_Release(*gstate);
+  free(*state);
+
+  return 0;
+}
+
+static void test_qtb_arena_store(void **state) {
+  QtbArena arena;
+  ResultQtbArenaSlot first;
+  ResultQtbArenaSlot second;
+
+  qtb_arena_new(&arena, &qtb_allocator_default);
+
+  first = qtb_arena_store(&arena, "Pikachu", 7);
+  second = qtb_arena_store(&arena, "Raichu", 6);
+  assert_true(ResultSuccessful(first));
+  assert_true(ResultSuccessful(second));
+
+  assert_int_equal(arena.n_blocks, 1);
+  assert_int_equal(ResultValue(second).offset, 7);
+  assert_memory_equal("Pikachu", qtb_arena_at(&arena, ResultValue(first)), 7);
+  assert_memory_equal("Raichu", qtb_arena_at(&arena, ResultValue(second)), 6);
+
+  qtb_arena_dealloc(&arena);
+}
+
+static void test_qtb_arena_store_grows_blocks(void **state) {
+  QtbArena arena;
+  char buffer[QTB_ARENA_INITIAL_BLOCK_SIZE / 2];
+  ResultQtbArenaSlot slot;
+
+  memset(buffer, 'a', sizeof(buffer));
+  qtb_arena_new(&arena, &qtb_allocator_default);
+
+  for (size_t i = 0; i < 3; i++) {
+    slot = qtb_arena_store(&arena, buffer, sizeof(buffer));
+    assert_true(ResultSuccessful(slot));
+  }
+
+  assert_int_equal(arena.n_blocks, 2);
+  assert_int_equal(arena.capacity, 2 * QTB_ARENA_INITIAL_BLOCK_SIZE);
+  assert_int_equal(ResultValue(slot).block, 1);
+
+  qtb_arena_dealloc(&arena);
+}
+
+static void test_qtb_arena_store_oversized_gets_own_block(void **state) {
+  QtbArena arena;
+  char buffer[4 * QTB_ARENA_INITIAL_BLOCK_SIZE];
+  ResultQtbArenaSlot slot;
+
+  memset(buffer, 'a', sizeof(buffer));
+  qtb_arena_new(&arena, &qtb_allocator_default);
+
+  assert_true(ResultSuccessful(qtb_arena_store(&arena, "Pikachu", 7)));
+
+  slot = qtb_arena_store(&arena, buffer, sizeof(buffer));
+  assert_true(ResultSuccessful(slot));
+  assert_int_equal(ResultValue(slot).block, 1);
+  assert_int_equal(arena.current, 0);
+
+  slot = qtb_arena_store(&arena, "Raichu", 6);
+  assert_int_equal(ResultValue(slot).block, 0);
+  assert_int_equal(ResultValue(slot).offset, 7);
+
+  qtb_arena_dealloc(&arena);
+}
+
+static void test_qtb_arena_unstore_last(void **state) {
+  QtbArena arena;
+  ResultQtbArenaSlot slot;
+
+  qtb_arena_new(&arena, &qtb_allocator_default);
+
+  assert_true(ResultSuccessful(qtb_arena_store(&arena, "Pikachu", 7)));
+  slot = qtb_arena_store(&arena, "Raichu", 6);
+  qtb_arena_unstore(&arena, ResultValue(slot), 6);
+  assert_int_equal(arena.used, 7);
+
+  qtb_arena_dealloc(&arena);
+}
+
+static void test_qtb_arena_store_malloc_fails(void **state) {
+  QtbArena arena;
+  ResultQtbArenaSlot slot;
+
+  qtb_arena_new(&arena, &qtb_allocator_default);
+  arena.allocator = &allocator_malloc_FAIL;
+
+  slot = qtb_arena_store(&arena, "Pikachu", 7);
+  assert_true(ResultFailed(slot));
+  assert_string_equal("failed to grow string arena", ResultFailureMessage(slot));
+  assert_int_equal(arena.n_blocks, 0);
+
+  qtb_arena_dealloc(&arena);
+}
+
+static void test_qtb_arena_store_realloc_fails(void **state) {
+  QtbArena arena;
+  ResultQtbArenaSlot slot;
+
+  qtb_arena_new(&arena, &qtb_allocator_default);
+  arena.allocator = &allocator_realloc_FAIL;
+
+  slot = qtb_arena_store(&arena, "Pikachu", 7);
+  assert_true(ResultFailed(slot));
+  assert_string_equal("failed to grow string arena", ResultFailureMessage(slot));
+
+  qtb_arena_dealloc(&arena);
+}
+
+#define register_test(test) cmocka_unit_test_setup_teardown(test, setup, teardown)
+
+static const struct CMUnitTest tests[] = {
+    register_test(test_qtb_arena_store),
+    register_test(test_qtb_arena_store_grows_blocks),
+    register_test(test_qtb_arena_store_oversized_gets_own_block),
+    register_test(test_qtb_arena_unstore_last),
+    register_test(test_qtb_arena_store_malloc_fails),
+    register_test(test_qtb_arena_store_realloc_fails),
+};
+
+int test_arena_run() {
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -292,6 +292,97 @@ static void test_qtb_column_repr_longest_of_first_five_sixth_ignored(void **stat
   free(column);
 }
 
+static void test_qtb_column_reserve(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  Result result;
+
+  descriptor = new_descriptor("Level", "int?");
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  result = qtb_column_reserve(column, QTB_COLUMN_CHUNK_SIZE + 10);
+  assert_true(ResultSuccessful(result));
+  assert_int_equal(column->capacity, QTB_COLUMN_CHUNK_SIZE + 10);
+  assert_int_equal(column->n_chunks, 2);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_reserve_realloc_fails(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  Result result;
+
+  descriptor = new_descriptor("Level", "int");
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+  column->allocator = &allocator_realloc_FAIL;
+
+  result = qtb_column_reserve(column, 100);
+  assert_true(ResultFailed(result));
+  assert_string_equal("failed to grow column", ResultFailureMessage(result));
+  assert_int_equal(column->capacity, QTB_COLUMN_INITIAL_CAPACITY);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_shrink_to_fit(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *level;
+  Result result;
+
+  descriptor = new_descriptor("Level", "int");
+  level = PyLong_FromLongLong_SUCCESS(12);
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  assert_true(ResultSuccessful(qtb_column_reserve(column, 3 * QTB_COLUMN_CHUNK_SIZE)));
+  qtb_column_append_SUCCESS(column, level);
+  Py_DECREF(level);
+
+  result = qtb_column_shrink_to_fit(column);
+  assert_true(ResultSuccessful(result));
+  assert_int_equal(column->capacity, 1);
+  assert_int_equal(column->n_chunks, 1);
+  assert_int_equal(qtb_column_int_at(column, 0), 12);
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_memory_usage(void **state) {
+  QtbColumn *column;
+  PyObject *descriptor;
+  PyObject *level;
+  QtbColumnMemoryUsage usage;
+
+  descriptor = new_descriptor("Level", "int");
+  level = PyLong_FromLongLong_SUCCESS(12);
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  qtb_column_append_SUCCESS(column, level);
+  qtb_column_append_SUCCESS(column, level);
+  Py_DECREF(level);
+
+  usage = qtb_column_memory_usage(column);
+  assert_int_equal(usage.used, 2 * sizeof(int64_t));
+  assert_int_equal(usage.reserved, QTB_COLUMN_INITIAL_CAPACITY * sizeof(int64_t));
+  assert_int_equal(usage.strings, 0);
+  assert_int_equal(usage.overhead, sizeof(QtbColumn) + strlen("Level") + 1 + sizeof(QtbColumnChunk));
+
+  qtb_column_dealloc(column);
+  free(column);
+}
+
 static const struct CMUnitTest tests[] = {
   cmocka_unit_test(test_qtb_column_new_fails),
   cmocka_unit_test(test_qtb_column_new_many_fails),
@@ -309,6 +400,10 @@ static const struct CMUnitTest tests[] = {
   cmocka_unit_test_setup_teardown(test_qtb_column_repr_longest_of_first_five_longer_row, setup, teardown),
   cmocka_unit_test_setup_teardown(test_qtb_column_repr_longest_of_first_five_fifth_longer_row, setup, teardown),
   cmocka_unit_test_setup_teardown(test_qtb_column_repr_longest_of_first_five_sixth_ignored, setup, teardown),
+  cmocka_unit_test_setup_teardown(test_qtb_column_reserve, setup, teardown),
+  cmocka_unit_test_setup_teardown(test_qtb_column_reserve_realloc_fails, setup, teardown),
+  cmocka_unit_test_setup_teardown(test_qtb_column_shrink_to_fit, setup, teardown),
+  cmocka_unit_test_setup_teardown(test_qtb_column_memory_usage, setup, teardown),
 };
 
 int test_column_run() {
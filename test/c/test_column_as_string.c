@@ -172,7 +172,7 @@ static void test_qtb_column_str_cell_as_string(void **state) {
   free(column);
 }
 
-static void test_qtb_column_str_cell_as_string_strdup_fails(void **state) {
+static void test_qtb_column_str_cell_as_string_malloc_fails(void **state) {
   QtbColumn *column;
   PyObject *descriptor;
   PyObject *name;
@@ -188,7 +188,7 @@ static void test_qtb_column_str_cell_as_string_strdup_fails(void **state) {
   qtb_column_append_SUCCESS(column, name);
   Py_DECREF(name);
 
-  column->strdup = &strdup_FAIL;
+  column->malloc = &malloc_FAIL;
   result = qtb_column_cell_as_string(column, 0);
   assert_true(ResultFailed(result));
   assert_string_equal(result.value.error.value.new.message, "memory error");
@@ -483,7 +483,7 @@ static const struct CMUnitTest tests[] = {
     register_test(test_qtb_column_header_as_string_snprintf_fails),
 
     register_test(test_qtb_column_str_cell_as_string),
-    register_test(test_qtb_column_str_cell_as_string_strdup_fails),
+    register_test(test_qtb_column_str_cell_as_string_malloc_fails),
 
     register_test(test_qtb_column_int_cell_as_string),
     register_test(test_qtb_column_int_cell_as_string_snprintf_fails),
@@ -0,0 +1,299 @@
+#include <Python.h>
+#include "column.h"
+#include "column_from_string.h"
+#include "helpers.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+static int setup(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)malloc(sizeof(PyGILState_STATE));
+  *gstate = PyGILState_Ensure();
+
+  *state = (void *)gstate;
+  return 0;
+}
+
+static int teardown(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)(*state);
+  PyErr_Clear();
+  PyGILState_Release(*gstate);
+  free(*state);
+
+  return 0;
+}
+
+static QtbColumn *new_column(const char *name, const char *type) {
+  QtbColumn *column;
+  PyObject *descriptor;
+
+  descriptor = new_descriptor(name, type);
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  return column;
+}
+
+static void free_column(QtbColumn *column) {
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+static void test_qtb_column_int_append_string(void **state) {
+  QtbColumn *column;
+
+  column = new_column("Level", "int");
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "-9223372036854775808", 20)));
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "+42", 3)));
+  assert_int_equal(column->size, 2);
+  assert_true(qtb_column_int_at(column, 0) == INT64_MIN);
+  assert_int_equal(qtb_column_int_at(column, 1), 42);
+
+  free_column(column);
+}
+
+static void test_qtb_column_int_append_string_invalid(void **state) {
+  QtbColumn *column;
+  Result result;
+
+  column = new_column("Level", "int");
+
+  result = qtb_column_append_string(column, "4 2", 3);
+  assert_true(ResultFailed(result));
+  assert_string_equal("non-int entry for int column", ResultFailureMessage(result));
+
+  result = qtb_column_append_string(column, "", 0);
+  assert_true(ResultFailed(result));
+  assert_string_equal("non-int entry for int column", ResultFailureMessage(result));
+
+  result = qtb_column_append_string(column, "9223372036854775808", 19);
+  assert_true(ResultFailed(result));
+  assert_string_equal("int out of range for int column", ResultFailureMessage(result));
+  assert_int_equal(column->size, 0);
+
+  free_column(column);
+}
+
+static void test_qtb_column_narrow_append_string_out_of_range(void **state) {
+  QtbColumn *column;
+  Result result;
+
+  column = new_column("Level", "uint8");
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "255", 3)));
+
+  result = qtb_column_append_string(column, "256", 3);
+  assert_true(ResultFailed(result));
+  assert_string_equal("int out of range for uint8 column", ResultFailureMessage(result));
+
+  result = qtb_column_append_string(column, "-1", 2);
+  assert_true(ResultFailed(result));
+  assert_string_equal("int out of range for uint8 column", ResultFailureMessage(result));
+
+  free_column(column);
+}
+
+static void test_qtb_column_float_append_string(void **state) {
+  QtbColumn *column;
+  Result result;
+
+  column = new_column("Power", "float");
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "1.5e3", 5)));
+  assert_true(qtb_column_float_at(column, 0) == 1500.0);
+
+  result = qtb_column_append_string(column, "1.5x", 4);
+  assert_true(ResultFailed(result));
+  assert_string_equal("non-float entry for float column", ResultFailureMessage(result));
+
+  free_column(column);
+}
+
+static void test_qtb_column_bool_append_string(void **state) {
+  QtbColumn *column;
+  Result result;
+
+  column = new_column("Legendary", "bool");
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "True", 4)));
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "0", 1)));
+  assert_true(qtb_column_bool_at(column, 0));
+  assert_false(qtb_column_bool_at(column, 1));
+
+  result = qtb_column_append_string(column, "yes", 3);
+  assert_true(ResultFailed(result));
+  assert_string_equal("non-bool entry for bool column", ResultFailureMessage(result));
+
+  free_column(column);
+}
+
+static void test_qtb_column_append_none(void **state) {
+  QtbColumn *column;
+
+  column = new_column("Level", "int?");
+
+  assert_true(ResultSuccessful(qtb_column_append_none(column)));
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "7", 1)));
+  assert_false(qtb_column_is_valid(column, 0));
+  assert_true(qtb_column_is_valid(column, 1));
+
+  free_column(column);
+}
+
+static void test_qtb_column_init_like(void **state) {
+  QtbColumn *column;
+  QtbColumn *like;
+
+  like = new_column("Name", "str?");
+  column = qtb_column_new_SUCCESS();
+
+  assert_true(ResultSuccessful(qtb_column_init_like(column, like)));
+  assert_string_equal("Name", column->name);
+  assert_int_equal(column->type, QTB_COLUMN_TYPE_STR);
+  assert_true(column->nullable);
+  assert_int_equal(column->size, 0);
+
+  free_column(column);
+  free_column(like);
+}
+
+static void test_qtb_column_append_column_str(void **state) {
+  QtbColumn *column;
+  QtbColumn *other;
+
+  column = new_column("Name", "str?");
+  other = new_column("Name", "str?");
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "Pikachu", 7)));
+  assert_true(ResultSuccessful(qtb_column_append_string(other, "Charmeleon the long", 19)));
+  assert_true(ResultSuccessful(qtb_column_append_none(other)));
+
+  assert_true(ResultSuccessful(qtb_column_append_column(column, other)));
+  assert_int_equal(column->size, 3);
+  assert_true(qtb_column_str_equals(column, 1, "Charmeleon the long", 19));
+  assert_false(qtb_column_is_valid(column, 2));
+
+  // Long strings are copied into the destination's own arena.
+  free_column(other);
+  assert_true(qtb_column_str_equals(column, 1, "Charmeleon the long", 19));
+
+  free_column(column);
+}
+
+static void test_qtb_column_append_column_category(void **state) {
+  QtbColumn *column;
+  QtbColumn *other;
+
+  column = new_column("Type", "category");
+  other = new_column("Type", "category");
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "Fire", 4)));
+  assert_true(ResultSuccessful(qtb_column_append_string(other, "Water", 5)));
+  assert_true(ResultSuccessful(qtb_column_append_string(other, "Fire", 4)));
+
+  assert_true(ResultSuccessful(qtb_column_append_column(column, other)));
+  assert_int_equal(column->size, 3);
+  assert_int_equal(column->dictionary.size, 2);
+  assert_int_equal(qtb_column_code_at(column, 0), 0);
+  assert_int_equal(qtb_column_code_at(column, 1), 1);
+  assert_int_equal(qtb_column_code_at(column, 2), 0);
+
+  free_column(other);
+  free_column(column);
+}
+
+static void test_qtb_column_append_column_across_chunks(void **state) {
+  QtbColumn *column;
+  QtbColumn *other;
+  char digits[8];
+  size_t n;
+
+  column = new_column("Level", "int");
+  other = new_column("Level", "int");
+
+  for (size_t i = 0; i < 3; i++)
+    assert_true(ResultSuccessful(qtb_column_append_string(column, "0", 1)));
+
+  n = QTB_COLUMN_CHUNK_SIZE + 5;
+  for (size_t i = 0; i < n; i++) {
+    snprintf(digits, sizeof(digits), "%zu", i);
+    assert_true(ResultSuccessful(qtb_column_append_string(other, digits, strlen(digits))));
+  }
+
+  assert_true(ResultSuccessful(qtb_column_append_column(column, other)));
+  assert_int_equal(column->size, n + 3);
+  for (size_t i = 0; i < n; i++)
+    assert_int_equal(qtb_column_int_at(column, i + 3), i);
+
+  free_column(other);
+  free_column(column);
+}
+
+static void test_qtb_column_append_taken(void **state) {
+  QtbColumn *column;
+  QtbColumn *other;
+  QtbColumn *names;
+  QtbColumn *other_names;
+  char digits[8];
+  size_t n;
+  size_t taken[] = {QTB_COLUMN_CHUNK_SIZE + 2, 0, 7, 7, QTB_COLUMN_CHUNK_SIZE - 1};
+
+  column = new_column("Level", "int16?");
+  other = new_column("Level", "int16?");
+  names = new_column("Name", "str");
+  other_names = new_column("Name", "str");
+
+  n = QTB_COLUMN_CHUNK_SIZE + 5;
+  for (size_t i = 0; i < n; i++) {
+    snprintf(digits, sizeof(digits), "%zu", i % 1000);
+    if (i == 7) assert_true(ResultSuccessful(qtb_column_append_none(other)));
+    else assert_true(ResultSuccessful(qtb_column_append_string(other, digits, strlen(digits))));
+    assert_true(ResultSuccessful(qtb_column_append_string(other_names, i % 2 ? "Charmeleon the long" : "Mew", i % 2 ? 19 : 3)));
+  }
+
+  assert_true(ResultSuccessful(qtb_column_append_taken(column, other, taken, 5)));
+  assert_int_equal(column->size, 5);
+  assert_int_equal(qtb_column_value_at(column, int16_t, 0), (QTB_COLUMN_CHUNK_SIZE + 2) % 1000);
+  assert_int_equal(qtb_column_value_at(column, int16_t, 1), 0);
+  assert_false(qtb_column_is_valid(column, 2));
+  assert_false(qtb_column_is_valid(column, 3));
+  assert_true(qtb_column_is_valid(column, 4));
+  assert_int_equal(qtb_column_value_at(column, int16_t, 4), (QTB_COLUMN_CHUNK_SIZE - 1) % 1000);
+
+  assert_true(ResultSuccessful(qtb_column_append_taken(names, other_names, taken, 5)));
+  assert_true(qtb_column_str_equals(names, 0, "Mew", 3));
+  assert_true(qtb_column_str_equals(names, 2, "Charmeleon the long", 19));
+  assert_true(qtb_column_str_equals(names, 4, "Charmeleon the long", 19));
+
+  free_column(other_names);
+  free_column(names);
+  free_column(other);
+  free_column(column);
+}
+
+#define register_test(test) cmocka_unit_test_setup_teardown(test, setup, teardown)
+
+static const struct CMUnitTest tests[] = {
+    register_test(test_qtb_column_int_append_string),
+    register_test(test_qtb_column_int_append_string_invalid),
+    register_test(test_qtb_column_narrow_append_string_out_of_range),
+    register_test(test_qtb_column_float_append_string),
+    register_test(test_qtb_column_bool_append_string),
+    register_test(test_qtb_column_append_none),
+    register_test(test_qtb_column_init_like),
+    register_test(test_qtb_column_append_column_str),
+    register_test(test_qtb_column_append_column_category),
+    register_test(test_qtb_column_append_column_across_chunks),
+    register_test(test_qtb_column_append_taken),
+};
+
+int test_column_from_string_run() {
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
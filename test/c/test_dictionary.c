@@ -0,0 +1,151 @@
+#include <Python.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "dictionary.h"
+#include "helpers.h"
+
+static int setup(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)malloc(sizeof(PyGILState_STATE));
+  *gstate = PyGILState_Ensure();
+
+  *state = (void *)gstate;
+  return 0;
+}
+
+static int teardown(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)(*state);
+  PyErr_Clear();
+  PyGILState_Release(*gstate);
+  free(*state);
+
+  return 0;
+}
+
+static void test_qtb_dictionary_intern(void **state) {
+  QtbDictionary dictionary;
+
+  qtb_dictionary_new(&dictionary, &qtb_allocator_default);
+
+  assert_int_equal(ResultValue(qtb_dictionary_intern(&dictionary, "Kanto", 5)), 0);
+  assert_int_equal(ResultValue(qtb_dictionary_intern(&dictionary, "Johto", 5)), 1);
+  assert_int_equal(ResultValue(qtb_dictionary_intern(&dictionary, "Kanto", 5)), 0);
+  assert_int_equal(dictionary.size, 2);
+  assert_memory_equal("Johto", qtb_dictionary_value_at(&dictionary, 1), 5);
+
+  qtb_dictionary_dealloc(&dictionary);
+}
+
+static void test_qtb_dictionary_intern_grows(void **state) {
+  QtbDictionary dictionary;
+  char value[16];
+
+  qtb_dictionary_new(&dictionary, &qtb_allocator_default);
+
+  for (size_t i = 0; i < 1000; i++) {
+    snprintf(value, sizeof(value), "region-%zu", i);
+    assert_int_equal(ResultValue(qtb_dictionary_intern(&dictionary, value, strlen(value))), i);
+  }
+
+  for (size_t i = 0; i < 1000; i++) {
+    snprintf(value, sizeof(value), "region-%zu", i);
+    assert_int_equal(qtb_dictionary_lookup(&dictionary, value, strlen(value)), i);
+  }
+
+  qtb_dictionary_dealloc(&dictionary);
+}
+
+static void test_qtb_dictionary_lookup_missing(void **state) {
+  QtbDictionary dictionary;
+
+  qtb_dictionary_new(&dictionary, &qtb_allocator_default);
+  assert_int_equal(qtb_dictionary_lookup(&dictionary, "Kanto", 5), -1);
+
+  qtb_dictionary_intern(&dictionary, "Kanto", 5);
+  assert_int_equal(qtb_dictionary_lookup(&dictionary, "Kant", 4), -1);
+
+  qtb_dictionary_dealloc(&dictionary);
+}
+
+static void test_qtb_dictionary_get_as_pyobject_is_cached(void **state) {
+  QtbDictionary dictionary;
+  ResultPyObjectPtr first;
+  ResultPyObjectPtr second;
+
+  qtb_dictionary_new(&dictionary, &qtb_allocator_default);
+  qtb_dictionary_intern(&dictionary, "Kanto", 5);
+
+  first = qtb_dictionary_get_as_pyobject(&dictionary, 0);
+  second = qtb_dictionary_get_as_pyobject(&dictionary, 0);
+  assert_true(ResultSuccessful(first));
+  assert_ptr_equal(ResultValue(first), ResultValue(second));
+  assert_int_equal(PyUnicode_CompareWithASCIIString(ResultValue(first), "Kanto"), 0);
+
+  Py_DECREF(ResultValue(first));
+  Py_DECREF(ResultValue(second));
+  qtb_dictionary_dealloc(&dictionary);
+}
+
+static void test_qtb_dictionary_intern_realloc_fails(void **state) {
+  QtbDictionary dictionary;
+  ResultSize_t code;
+
+  qtb_dictionary_new(&dictionary, &qtb_allocator_default);
+  dictionary.allocator = &allocator_realloc_FAIL;
+
+  code = qtb_dictionary_intern(&dictionary, "Kanto", 5);
+  assert_true(ResultFailed(code));
+  assert_string_equal("failed to grow dictionary", ResultFailureMessage(code));
+  assert_int_equal(dictionary.size, 0);
+
+  qtb_dictionary_dealloc(&dictionary);
+}
+
+static void test_qtb_dictionary_intern_rehash_fails(void **state) {
+  QtbDictionary dictionary;
+  ResultSize_t code;
+  char value[8];
+
+  qtb_dictionary_new(&dictionary, &qtb_allocator_default);
+  for (size_t i = 0; i < QTB_DICTIONARY_INITIAL_CAPACITY; i++) {
+    snprintf(value, sizeof(value), "%zu", i);
+    assert_true(ResultSuccessful(qtb_dictionary_intern(&dictionary, value, strlen(value))));
+  }
+
+  dictionary.allocator = &allocator_malloc_FAIL;
+  code = qtb_dictionary_intern(&dictionary, "Kanto", 5);
+  assert_true(ResultFailed(code));
+  assert_string_equal("failed to grow dictionary", ResultFailureMessage(code));
+  assert_int_equal(dictionary.capacity, QTB_DICTIONARY_INITIAL_CAPACITY);
+
+  // The next intern grows the slots along with the capacity.
+  dictionary.allocator = &qtb_allocator_default;
+  for (size_t i = 0; i < 4 * QTB_DICTIONARY_INITIAL_CAPACITY; i++) {
+    snprintf(value, sizeof(value), "k%zu", i);
+    assert_true(ResultSuccessful(qtb_dictionary_intern(&dictionary, value, strlen(value))));
+  }
+  assert_true(2 * dictionary.size <= dictionary.n_slots);
+  assert_int_equal(qtb_dictionary_lookup(&dictionary, "k0", 2), QTB_DICTIONARY_INITIAL_CAPACITY);
+
+  qtb_dictionary_dealloc(&dictionary);
+}
+
+#define register_test(test) cmocka_unit_test_setup_teardown(test, setup, teardown)
+
+static const struct CMUnitTest tests[] = {
+    register_test(test_qtb_dictionary_intern),
+    register_test(test_qtb_dictionary_intern_grows),
+    register_test(test_qtb_dictionary_lookup_missing),
+    register_test(test_qtb_dictionary_get_as_pyobject_is_cached),
+    register_test(test_qtb_dictionary_intern_realloc_fails),
+    register_test(test_qtb_dictionary_intern_rehash_fails),
+};
+
+int test_dictionary_run() {
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,148 @@
+#include <Python.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "encoding.h"
+#include "helpers.h"
+
+#define N_BLOCKS 4
+#define N_CELLS (N_BLOCKS * QTB_ENCODING_BLOCK_SIZE)
+
+static int setup(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)malloc(sizeof(PyGILState_STATE));
+  *gstate = PyGILState_Ensure();
+
+  *state = (void *)gstate;
+  return 0;
+}
+
+static int teardown(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)(*state);
+  PyErr_Clear();
+  PyGILState_Release(*gstate);
+  free(*state);
+
+  return 0;
+}
+
+static void test_qtb_encoding_frame_of_reference(void **state) {
+  QtbEncodingCells cells = {QTB_ENCODING_KIND_SIGNED, 8};
+  int64_t data[N_CELLS];
+  int64_t decoded[N_CELLS];
+  uint32_t x = 2463534242u;
+  QtbEncodedChunk *encoded;
+
+  for (size_t i = 0; i < N_CELLS; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data[i] = -1000000 + (int64_t)(x % 200);
+  }
+
+  assert_true(ResultSuccessful(qtb_encoding_encode(cells, data, N_BLOCKS, &qtb_allocator_default, &encoded)));
+  assert_non_null(encoded);
+  assert_int_equal(encoded->blocks[0].encoding, QTB_ENCODING_FRAME_OF_REFERENCE);
+  assert_int_equal(encoded->blocks[0].bits, 8);
+  assert_true(encoded->size < sizeof(data) / 4);
+
+  qtb_encoding_decode(cells, encoded, decoded);
+  assert_memory_equal(data, decoded, sizeof(data));
+
+  qtb_encoding_free(&qtb_allocator_default, encoded);
+}
+
+static void test_qtb_encoding_delta(void **state) {
+  QtbEncodingCells cells = {QTB_ENCODING_KIND_UNSIGNED, 4};
+  uint32_t data[N_CELLS];
+  uint32_t decoded[N_CELLS];
+  QtbEncodedChunk *encoded;
+
+  for (size_t i = 0; i < N_CELLS; i++) data[i] = 4000000000u - 60 * (uint32_t)i;
+
+  assert_true(ResultSuccessful(qtb_encoding_encode(cells, data, N_BLOCKS, &qtb_allocator_default, &encoded)));
+  assert_non_null(encoded);
+  assert_int_equal(encoded->blocks[1].encoding, QTB_ENCODING_DELTA);
+  assert_int_equal(encoded->blocks[1].bits, 0);
+
+  qtb_encoding_decode_block(cells, encoded, 1, decoded);
+  assert_memory_equal(&data[QTB_ENCODING_BLOCK_SIZE], decoded, QTB_ENCODING_BLOCK_SIZE * sizeof(uint32_t));
+
+  qtb_encoding_free(&qtb_allocator_default, encoded);
+}
+
+static void test_qtb_encoding_run_length(void **state) {
+  QtbEncodingCells cells = {QTB_ENCODING_KIND_SIGNED, 1};
+  int8_t data[N_CELLS];
+  int8_t decoded[N_CELLS];
+  QtbEncodedChunk *encoded;
+
+  for (size_t i = 0; i < N_CELLS; i++) data[i] = i % 300 < 150 ? -128 : 127;
+
+  assert_true(ResultSuccessful(qtb_encoding_encode(cells, data, N_BLOCKS, &qtb_allocator_default, &encoded)));
+  assert_non_null(encoded);
+  assert_int_equal(encoded->blocks[2].encoding, QTB_ENCODING_RUN_LENGTH);
+
+  qtb_encoding_decode(cells, encoded, decoded);
+  assert_memory_equal(data, decoded, sizeof(data));
+
+  qtb_encoding_free(&qtb_allocator_default, encoded);
+}
+
+static void test_qtb_encoding_bools(void **state) {
+  QtbEncodingCells cells = {QTB_ENCODING_KIND_BOOL, 0};
+  uint64_t data[N_BLOCKS * QTB_ENCODING_BLOCK_WORDS] = {0};
+  uint64_t decoded[N_BLOCKS * QTB_ENCODING_BLOCK_WORDS];
+  QtbEncodedChunk *encoded;
+
+  // Long runs in the first three blocks, alternating bits in the last one
+  for (size_t i = 0; i < 3 * QTB_ENCODING_BLOCK_SIZE; i++)
+    if (i / 700 % 2 == 1) data[i / 64] |= (uint64_t)1 << (i % 64);
+  for (size_t w = 3 * QTB_ENCODING_BLOCK_WORDS; w < N_BLOCKS * QTB_ENCODING_BLOCK_WORDS; w++)
+    data[w] = 0x5555555555555555;
+
+  assert_true(ResultSuccessful(qtb_encoding_encode(cells, data, N_BLOCKS, &qtb_allocator_default, &encoded)));
+  assert_non_null(encoded);
+  assert_int_equal(encoded->blocks[0].encoding, QTB_ENCODING_RUN_LENGTH);
+  assert_int_equal(encoded->blocks[3].encoding, QTB_ENCODING_PLAIN);
+
+  qtb_encoding_decode(cells, encoded, decoded);
+  assert_memory_equal(data, decoded, sizeof(data));
+
+  qtb_encoding_free(&qtb_allocator_default, encoded);
+}
+
+static void test_qtb_encoding_incompressible(void **state) {
+  QtbEncodingCells cells = {QTB_ENCODING_KIND_UNSIGNED, 8};
+  uint64_t data[N_CELLS];
+  uint64_t x = 88172645463325252ull;
+  QtbEncodedChunk *encoded;
+
+  for (size_t i = 0; i < N_CELLS; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    data[i] = x;
+  }
+
+  assert_true(ResultSuccessful(qtb_encoding_encode(cells, data, N_BLOCKS, &qtb_allocator_default, &encoded)));
+  assert_null(encoded);
+}
+
+#define register_test(test) cmocka_unit_test_setup_teardown(test, setup, teardown)
+
+static const struct CMUnitTest tests[] = {
+    register_test(test_qtb_encoding_frame_of_reference),
+    register_test(test_qtb_encoding_delta),
+    register_test(test_qtb_encoding_run_length),
+    register_test(test_qtb_encoding_bools),
+    register_test(test_qtb_encoding_incompressible),
+};
+
+int test_encoding_run() {
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
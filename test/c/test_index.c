@@ -0,0 +1,176 @@
+#include <Python.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "index.h"
+#include "helpers.h"
+
+static int setup(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)malloc(sizeof(PyGILState_STATE));
+  *gstate = PyGILState_Ensure();
+
+  *state = (void *)gstate;
+  return 0;
+}
+
+static int teardown(void **state) {
+  PyGILState_STATE *gstate;
+
+  gstate = (PyGILState_STATE *)(*state);
+  PyErr_Clear();
+  PyGILState_Release(*gstate);
+  free(*state);
+
+  return 0;
+}
+
+static QtbColumn *new_column(const char *name, const char *type) {
+  QtbColumn *column;
+  PyObject *descriptor;
+
+  descriptor = new_descriptor(name, type);
+  column = qtb_column_new_SUCCESS();
+  qtb_column_init_SUCCESS(column, descriptor);
+  Py_DECREF(descriptor);
+
+  return column;
+}
+
+static void free_column(QtbColumn *column) {
+  qtb_column_dealloc(column);
+  free(column);
+}
+
+// Number of rows holding key, or -1 if the lookup fails.
+static Py_ssize_t count(QtbIndex *index, QtbColumn *column, PyObject *key) {
+  ResultPyObjectPtr rows;
+  Py_ssize_t n;
+
+  rows = qtb_index_lookup(index, column, key, 0, 1, (Py_ssize_t)column->size);
+  Py_DECREF(key);
+  if (ResultFailed(rows)) {
+    ResultFailureRaise(rows);
+    return -1;
+  }
+
+  n = PyList_GET_SIZE(ResultValue(rows));
+  Py_DECREF(ResultValue(rows));
+  return n;
+}
+
+static void test_qtb_index_int(void **state) {
+  QtbColumn *column;
+  QtbIndex index;
+  char digits[8];
+
+  column = new_column("Level", "int?");
+  for (size_t i = 0; i < 1000; i++) {
+    snprintf(digits, sizeof(digits), "%zu", i % 300);
+    assert_true(ResultSuccessful(qtb_column_append_string(column, digits, strlen(digits))));
+  }
+  assert_true(ResultSuccessful(qtb_column_append_none(column)));
+
+  assert_true(ResultSuccessful(qtb_index_init(&index, column, 0, false, &qtb_allocator_default)));
+  assert_true(ResultSuccessful(qtb_index_extend(&index, column, column->size)));
+  assert_int_equal(index.size, 1001);
+  assert_int_equal(index.n_keys, 300);
+
+  assert_int_equal(count(&index, column, PyLong_FromLong(0)), 4);
+  assert_int_equal(count(&index, column, PyLong_FromLong(299)), 3);
+  assert_int_equal(count(&index, column, PyLong_FromLong(300)), 0);
+  assert_int_equal(count(&index, column, PyUnicode_FromString("0")), -1);
+  assert_exc_string_equal("lookup with non-int key");
+
+  qtb_index_dealloc(&index);
+  free_column(column);
+}
+
+// Truncating removes keys from the middle of probe runs, which must leave
+// every remaining key reachable.
+static void test_qtb_index_truncate(void **state) {
+  QtbColumn *column;
+  QtbIndex index;
+  char digits[8];
+
+  column = new_column("Name", "str");
+  for (size_t i = 0; i < 5000; i++) {
+    snprintf(digits, sizeof(digits), "%zu", i);
+    assert_true(ResultSuccessful(qtb_column_append_string(column, digits, strlen(digits))));
+  }
+
+  assert_true(ResultSuccessful(qtb_index_init(&index, column, 0, true, &qtb_allocator_default)));
+  assert_true(ResultSuccessful(qtb_index_extend(&index, column, column->size)));
+
+  qtb_index_truncate(&index, column, 2500);
+  assert_int_equal(index.n_keys, 2500);
+  assert_int_equal(count(&index, column, PyUnicode_FromString("2500")), 0);
+  for (size_t i = 0; i < 2500; i++) {
+    snprintf(digits, sizeof(digits), "%zu", i);
+    assert_int_equal(count(&index, column, PyUnicode_FromString(digits)), 1);
+  }
+
+  assert_true(ResultSuccessful(qtb_index_extend(&index, column, column->size)));
+  assert_int_equal(count(&index, column, PyUnicode_FromString("4999")), 1);
+
+  qtb_index_dealloc(&index);
+  free_column(column);
+}
+
+static void test_qtb_index_unique_duplicate(void **state) {
+  QtbColumn *column;
+  QtbIndex index;
+  Result result;
+
+  column = new_column("Name", "str");
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "Pikachu", 7)));
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "Charmander", 10)));
+
+  assert_true(ResultSuccessful(qtb_index_init(&index, column, 0, true, &qtb_allocator_default)));
+  assert_true(ResultSuccessful(qtb_index_extend(&index, column, column->size)));
+
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "Squirtle", 8)));
+  assert_true(ResultSuccessful(qtb_column_append_string(column, "Pikachu", 7)));
+
+  // Neither new row is indexed.
+  result = qtb_index_extend(&index, column, column->size);
+  assert_true(ResultFailed(result));
+  ResultFailureRaise(result);
+  assert_exc_string_equal("duplicate key in unique index");
+  assert_int_equal(index.size, 2);
+  assert_int_equal(count(&index, column, PyUnicode_FromString("Squirtle")), 0);
+  assert_int_equal(count(&index, column, PyUnicode_FromString("Pikachu")), 1);
+
+  qtb_index_dealloc(&index);
+  free_column(column);
+}
+
+static void test_qtb_index_float_column(void **state) {
+  QtbColumn *column;
+  QtbIndex index;
+  Result result;
+
+  column = new_column("Power", "float");
+
+  result = qtb_index_init(&index, column, 0, false, &qtb_allocator_default);
+  assert_true(ResultFailed(result));
+  ResultFailureRaise(result);
+  assert_exc_string_equal("index of float or bool column");
+
+  free_column(column);
+}
+
+#define register_test(test) cmocka_unit_test_setup_teardown(test, setup, teardown)
+
+static const struct CMUnitTest tests[] = {
+    register_test(test_qtb_index_int),
+    register_test(test_qtb_index_truncate),
+    register_test(test_qtb_index_unique_duplicate),
+    register_test(test_qtb_index_float_column),
+};
+
+int test_index_run() {
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
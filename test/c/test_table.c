@@ -30,7 +30,7 @@ static int teardown(void **state) {
 static PyObject *blueprint_level_name_new_succeeds() {
   PyObject *blueprint;
 
-  blueprint = PyList_New_SUCCESS(1);
+  blueprint = PyList_New_SUCCESS(2);
   PyList_SET_ITEM(blueprint, 0, new_descriptor("Name", "str"));
   PyList_SET_ITEM(blueprint, 1, new_descriptor("Level", "int"));
 
@@ -54,6 +54,7 @@ static void test_qtb_table_new_(void **state) {
   assert_int_equal(table.size, 0);
   assert_int_equal(table.width, 0);
   assert_null(table.columns);
+  assert_int_equal(table.exports, 0);
 }
 
 static void test_qtb_table_init_(void **state) {
@@ -198,6 +199,56 @@ static void test_qtb_table_blueprint_failing_pylist_new(void **state) {
   free(table);
 }
 
+static void test_qtb_table_extend_(void **state) {
+  QtbTable *table;
+  PyObject *blueprint;
+  PyObject *rows;
+  Result result;
+
+  blueprint = blueprint_level_name_new_succeeds();
+  table = table_malloc_and_new_succeeds();
+  assert_true(ResultSuccessful(qtb_table_init_(table, blueprint)));
+  Py_DECREF(blueprint);
+
+  rows = Py_BuildValue("[(s,i),(s,i)]", "Pikachu", 12, "Raichu", 30);
+  assert_non_null(rows);
+
+  result = qtb_table_extend_(table, rows);
+  Py_DECREF(rows);
+  assert_true(ResultSuccessful(result));
+  assert_int_equal(table->size, 2);
+  assert_int_equal(table->columns[0].size, 2);
+  assert_int_equal(qtb_column_int_at(&table->columns[1], 1), 30);
+
+  qtb_table_dealloc_(table);
+  free(table);
+}
+
+static void test_qtb_table_extend_failing_row_appends_nothing(void **state) {
+  QtbTable *table;
+  PyObject *blueprint;
+  PyObject *rows;
+  Result result;
+
+  blueprint = blueprint_level_name_new_succeeds();
+  table = table_malloc_and_new_succeeds();
+  assert_true(ResultSuccessful(qtb_table_init_(table, blueprint)));
+  Py_DECREF(blueprint);
+
+  rows = Py_BuildValue("[(s,i),(s,s)]", "Pikachu", 12, "Raichu", "thirty");
+  assert_non_null(rows);
+
+  result = qtb_table_extend_(table, rows);
+  Py_DECREF(rows);
+  assert_true(ResultFailed(result));
+  assert_int_equal(table->size, 0);
+  assert_int_equal(table->columns[0].size, 0);
+  assert_int_equal(table->columns[1].size, 0);
+
+  qtb_table_dealloc_(table);
+  free(table);
+}
+
 #define register_test(test) cmocka_unit_test_setup_teardown(test, setup, teardown)
 
 static const struct CMUnitTest tests[] = {
@@ -213,6 +264,8 @@ static const struct CMUnitTest tests[] = {
 
     register_test(test_qtb_table_blueprint_),
     register_test(test_qtb_table_blueprint_failing_pylist_new),
+    register_test(test_qtb_table_extend_),
+    register_test(test_qtb_table_extend_failing_row_appends_nothing),
 };
 
 int test_table_run() {
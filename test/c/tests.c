@@ -8,7 +8,13 @@ int main(void) {
     test_append_run()
     || test_column_run()
     || test_column_as_string_run()
+    || test_column_from_string_run()
     || test_result_run()
     || test_table_run()
+    || test_arena_run()
+    || test_dictionary_run()
+    || test_encoding_run()
+    || test_index_run()
+    || test_allocator_run()
   );
 }
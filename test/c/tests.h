@@ -4,7 +4,13 @@
 int test_append_run(void);
 int test_column_run(void);
 int test_column_as_string_run(void);
+int test_column_from_string_run(void);
 int test_result_run(void);
 int test_table_run(void);
+int test_arena_run(void);
+int test_dictionary_run(void);
+int test_encoding_run(void);
+int test_index_run(void);
+int test_allocator_run(void);
 
 #endif
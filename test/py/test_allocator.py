@@ -0,0 +1,79 @@
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str'),
+    ('Level', 'int?'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+]
+
+
+def fill(table, n):
+    for i in range(n):
+        table.append(['Pikachu, the electric mouse {}'.format(i), i, i % 2 == 0, 'electric'])
+
+
+@pytest.mark.parametrize('allocator', [None, 'malloc', 'arena', 'hugepage'])
+def test_allocator_round_trips(allocator):
+    table = quicktable.Table(BLUEPRINT, allocator=allocator)
+    fill(table, 70000)
+    assert table[0] == ['Pikachu, the electric mouse 0', 0, True, 'electric']
+    assert table[69999] == ['Pikachu, the electric mouse 69999', 69999, False, 'electric']
+    table.pop()
+    table.shrink_to_fit()
+    assert len(table) == 69999
+
+
+def test_allocator_with_capacity():
+    table = quicktable.Table(BLUEPRINT, capacity=100000, allocator='arena')
+    fill(table, 100000)
+    assert table.capacity == 100000
+    assert table[65536][1] == 65536
+
+
+def test_invalid_allocator_name():
+    with pytest.raises(ValueError) as excinfo:
+        quicktable.Table(BLUEPRINT, allocator='jemalloc')
+    assert str(excinfo.value) == 'invalid allocator'
+
+
+def test_invalid_allocator_type():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table(BLUEPRINT, allocator=12)
+    assert str(excinfo.value) == 'allocator must be a str or quicktable.Pool'
+
+
+def test_pool_starts_empty():
+    assert quicktable.Pool().cached == 0
+
+
+def test_pool_reuses_memory_of_dead_tables():
+    pool = quicktable.Pool()
+
+    table = quicktable.Table(BLUEPRINT, allocator=pool)
+    fill(table, 1000)
+    del table
+    cached = pool.cached
+    assert cached > 0
+
+    table = quicktable.Table(BLUEPRINT, allocator=pool)
+    fill(table, 10)
+    assert pool.cached < cached
+    assert table[9] == ['Pikachu, the electric mouse 9', 9, False, 'electric']
+
+
+def test_pool_outlives_its_name():
+    pool = quicktable.Pool()
+    table = quicktable.Table(BLUEPRINT, allocator=pool)
+    del pool
+    fill(table, 1000)
+    assert table[999][1] == 999
+
+
+def test_many_short_lived_tables_share_a_pool():
+    pool = quicktable.Pool()
+    for _ in range(200):
+        table = quicktable.Table(BLUEPRINT, allocator=pool)
+        fill(table, 50)
+        assert len(table) == 50
@@ -55,3 +55,27 @@ def test_append_mismatching_type_for_bool(table):
     with pytest.raises(TypeError) as excinfo:
         table.append(['Pikachu', 12, None, 12.5])
     assert str(excinfo.value) == 'non-bool entry for bool column'
+
+
+def test_append_str_round_trips(table):
+    names = ['', 'Mr. Mime', 'Flabébé', 'Null\x00Byte', 'x' * 5000]
+    for name in names:
+        table.append([name, 1, True, 1.0])
+    assert [table[i][0] for i in range(len(names))] == names
+
+
+def test_append_across_chunk_boundaries():
+    table = quicktable.Table([('Level', 'int'), ('Name', 'str')])
+    for i in range(200000):
+        table.append([i, str(i)])
+    assert len(table) == 200000
+    for i in (0, 65535, 65536, 131071, 131072, 199999):
+        assert table[i] == [i, str(i)]
+
+
+def test_append_bool_across_chunk_boundaries():
+    table = quicktable.Table([('Wild', 'bool?')])
+    for i in range(140000):
+        table.append([None if i % 5 == 0 else i % 3 == 0])
+    for i in (65535, 65536, 65537, 131072, 139999):
+        assert table[i] == [None if i % 5 == 0 else i % 3 == 0]
@@ -0,0 +1,140 @@
+import array
+import gc
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str?'),
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+    ('Rank', 'uint8'),
+    ('Weight', 'float32?'),
+]
+
+ROWS = [
+    ['Pikachu', 12, 1.5, True, 'electric', 3, 0.5],
+    [None, None, 2.5, False, 'fire', 4, None],
+    ['Charmander, the long named one', 7, -1.0, True, 'electric', 5, 2.0],
+]
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table(BLUEPRINT)
+    table.extend(ROWS)
+    return table
+
+
+def rows(table):
+    return [table[i] for i in range(len(table))]
+
+
+def test_arrow_capsules(table):
+    assert 'arrow_schema' in repr(table.__arrow_c_schema__())
+    schema, array = table.__arrow_c_array__()
+    assert 'arrow_schema' in repr(schema)
+    assert 'arrow_array' in repr(array)
+    assert 'arrow_array_stream' in repr(table.__arrow_c_stream__(requested_schema=None))
+
+
+def test_from_arrow_round_trips_stream(table):
+    copy = quicktable.Table.from_arrow(table)
+    assert copy.blueprint == BLUEPRINT
+    assert rows(copy) == ROWS
+
+
+def test_from_arrow_round_trips_array(table):
+    class ArrayOnly:
+        def __arrow_c_array__(self, requested_schema=None):
+            return table.__arrow_c_array__()
+
+    assert rows(quicktable.Table.from_arrow(ArrayOnly())) == ROWS
+
+
+def test_from_arrow_takes_table_keywords(table):
+    copy = quicktable.Table.from_arrow(table, capacity=100, allocator='arena')
+    assert copy.capacity >= 100
+    assert rows(copy) == ROWS
+
+
+def test_from_arrow_across_chunks():
+    n = 2 * quicktable.CHUNK_SIZE + 3
+    table = quicktable.Table.from_columns([('Level', 'int?'), ('Name', 'str')], [array.array('q', range(n)), [str(i) for i in range(n)]])
+
+    class ArrayOnly:
+        def __arrow_c_array__(self, requested_schema=None):
+            return table.__arrow_c_array__()
+
+    for source in (table, ArrayOnly()):
+        copy = quicktable.Table.from_arrow(source)
+        assert len(copy) == n
+        for i in (0, quicktable.CHUNK_SIZE - 1, quicktable.CHUNK_SIZE, n - 1):
+            assert copy[i] == [i, str(i)]
+
+
+def test_from_arrow_empty_table():
+    table = quicktable.Table(BLUEPRINT)
+    copy = quicktable.Table.from_arrow(table)
+    assert copy.blueprint == BLUEPRINT
+    assert len(copy) == 0
+
+
+def test_arrow_exports_pin_table(table):
+    capsule = table.__arrow_c_stream__()
+    with pytest.raises(BufferError) as excinfo:
+        table.append(ROWS[0])
+    assert str(excinfo.value) == 'table has exported buffers'
+
+    del capsule
+    gc.collect()
+    table.append(ROWS[0])
+    assert len(table) == 4
+
+
+def test_from_arrow_non_arrow_object():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table.from_arrow([1, 2])
+    assert str(excinfo.value) == 'from_arrow needs an object implementing the Arrow PyCapsule interface'
+
+
+def test_arrow_interop_with_pyarrow(table):
+    pa = pytest.importorskip('pyarrow')
+
+    exported = pa.table(table)
+    exported.validate(full=True)
+    assert exported.schema.field('Name').type == pa.string()
+    assert exported.schema.field('Name').nullable
+    assert not exported.schema.field('Power').nullable
+    assert exported.schema.field('Type').type == pa.dictionary(pa.int32(), pa.string())
+    assert exported.schema.field('Rank').type == pa.uint8()
+    assert exported.to_pylist()[1] == dict(zip([name for name, _ in BLUEPRINT], ROWS[1]))
+    assert pa.record_batch(table).num_rows == 3
+    assert pa.schema(table) == exported.schema
+
+    imported = quicktable.Table.from_arrow(exported)
+    assert rows(imported) == ROWS
+
+
+def test_from_arrow_pyarrow_data():
+    pa = pytest.importorskip('pyarrow')
+
+    data = pa.table({
+        'Level': [1, None, 3],
+        'Name': pa.array(['a', 'bb', None], pa.large_string()),
+        'Type': pa.array(['p', 'q', 'p']).dictionary_encode(),
+        'Wild': [True, False, None],
+    }).slice(1)
+
+    table = quicktable.Table.from_arrow(data)
+    assert table.blueprint == [('Level', 'int?'), ('Name', 'str?'), ('Type', 'category?'), ('Wild', 'bool?')]
+    assert rows(table) == [[None, 'bb', 'q', False], [3, None, 'p', None]]
+
+
+def test_from_arrow_unsupported_type():
+    pa = pytest.importorskip('pyarrow')
+
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table.from_arrow(pa.table({'When': pa.array([1], pa.timestamp('s'))}))
+    assert str(excinfo.value) == "unsupported arrow format 'tss:' for column 'When'"
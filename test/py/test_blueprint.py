@@ -66,6 +66,7 @@ def test_valid_column_types():
         ('Level', 'int'),
         ('Wild', 'bool'),
         ('Power', 'float'),
+        ('Region', 'category'),
     ])
 
 
@@ -0,0 +1,99 @@
+import array
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+]
+
+
+def test_from_columns_with_buffers():
+    table = quicktable.Table.from_columns(BLUEPRINT, [
+        array.array('q', [12, 30]),
+        memoryview(array.array('d', [1.5, 2.5])),
+        memoryview(bytes([1, 0])).cast('?'),
+    ])
+    assert table[0] == [12, 1.5, True]
+    assert table[1] == [30, 2.5, False]
+
+
+def test_extend_columns_mixes_buffers_and_sequences():
+    table = quicktable.Table(BLUEPRINT)
+    table.append([1, 0.5, True])
+    table.extend_columns([array.array('q', [2, 3]), [1.5, 2.5], [False, True]])
+    assert len(table) == 3
+    assert table[2] == [3, 2.5, True]
+
+
+def test_extend_columns_large_buffer_across_chunks():
+    n = 200000
+    table = quicktable.Table([('Level', 'int'), ('Power', 'float32')])
+    table.append([-1, 0.5])
+    table.extend_columns([array.array('q', range(n)), array.array('f', [0.25] * n)])
+    assert len(table) == n + 1
+    for i in (1, 65535, 65536, 65537, n):
+        assert table[i] == [i - 1, 0.25]
+
+
+@pytest.mark.parametrize('typecode', ['b', 'B', 'h', 'H', 'i', 'I', 'l', 'L', 'q', 'Q'])
+def test_extend_columns_converts_integer_buffers(typecode):
+    table = quicktable.Table([('Level', 'int'), ('Rank', 'uint8')])
+    table.extend_columns([array.array(typecode, [1, 2, 100]), array.array(typecode, [1, 2, 100])])
+    assert [table[i] for i in range(3)] == [[1, 1], [2, 2], [100, 100]]
+
+
+def test_extend_columns_converts_float_buffers():
+    table = quicktable.Table([('Power', 'float'), ('Weight', 'float32')])
+    table.extend_columns([array.array('f', [0.5]), array.array('d', [0.5])])
+    assert table[0] == [0.5, 0.5]
+
+
+def test_extend_columns_buffer_out_of_range():
+    table = quicktable.Table([('Rank', 'uint8')])
+    with pytest.raises(OverflowError) as excinfo:
+        table.extend_columns([array.array('h', [1, -1])])
+    assert str(excinfo.value) == 'int out of range for uint8 column'
+    assert len(table) == 0
+
+
+def test_extend_columns_buffer_of_wrong_kind():
+    table = quicktable.Table([('Level', 'int')])
+    with pytest.raises(TypeError) as excinfo:
+        table.extend_columns([array.array('d', [1.0])])
+    assert str(excinfo.value) == 'non-int buffer for int column'
+
+
+def test_extend_columns_unsupported_buffer_format():
+    table = quicktable.Table([('Level', 'int')])
+    with pytest.raises(TypeError) as excinfo:
+        table.extend_columns([memoryview(b'\x00' * 8).cast('B').cast('c')])
+    assert str(excinfo.value) == 'unsupported buffer format'
+
+
+def test_extend_columns_non_contiguous_buffer_is_read_as_sequence():
+    table = quicktable.Table([('Level', 'int')])
+    table.extend_columns([memoryview(array.array('q', [1, 2, 3, 4]))[::2]])
+    assert [table[i] for i in range(len(table))] == [[1], [3]]
+
+
+def test_extend_columns_buffer_for_str_column_is_read_as_sequence():
+    table = quicktable.Table([('Name', 'str')])
+    with pytest.raises(TypeError) as excinfo:
+        table.extend_columns([b'ab'])
+    assert str(excinfo.value) == 'non-str entry for str column'
+
+
+def test_extend_columns_mismatching_lengths():
+    table = quicktable.Table(BLUEPRINT)
+    with pytest.raises(TypeError) as excinfo:
+        table.extend_columns([array.array('q', [1]), [1.5, 2.5], [True]])
+    assert str(excinfo.value) == 'extend_columns with mismatching column lengths'
+
+
+def test_extend_columns_nullable_buffer_values_are_valid():
+    table = quicktable.Table([('Level', 'int?')])
+    table.append([None])
+    table.extend_columns([array.array('q', [7])])
+    assert [table[0], table[1]] == [[None], [7]]
@@ -0,0 +1,76 @@
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    return quicktable.Table([
+        ('Name', 'str'),
+        ('Level', 'int?'),
+        ('Wild', 'bool'),
+    ])
+
+
+def test_capacity_hint_reserves_rows():
+    table = quicktable.Table([('Name', 'str'), ('Level', 'int')], capacity=200000)
+    assert table.capacity == 200000
+    for i in range(200000):
+        table.append([str(i), i])
+    assert table.capacity == 200000
+    assert table[199999] == ['199999', 199999]
+
+
+def test_capacity_hint_must_be_non_negative():
+    with pytest.raises(ValueError) as excinfo:
+        quicktable.Table([('Level', 'int')], capacity=-1)
+    assert str(excinfo.value) == 'capacity must be non-negative'
+
+
+def test_reserve_grows_capacity(table):
+    table.reserve(70000)
+    assert table.capacity == 70000
+
+
+def test_reserve_never_shrinks(table):
+    table.reserve(1000)
+    table.reserve(10)
+    assert table.capacity == 1000
+
+
+def test_reserve_must_be_non_negative(table):
+    with pytest.raises(ValueError) as excinfo:
+        table.reserve(-1)
+    assert str(excinfo.value) == 'capacity must be non-negative'
+
+
+def test_reserve_keeps_rows(table):
+    table.append(['Pikachu', None, True])
+    table.reserve(100000)
+    table.append(['Raichu', 30, False])
+    assert table[0] == ['Pikachu', None, True]
+    assert table[1] == ['Raichu', 30, False]
+
+
+def test_shrink_to_fit_trims_to_size(table):
+    table.reserve(150000)
+    for i in range(70000):
+        table.append(['Pikachu, the electric mouse', i, i % 2 == 0])
+    table.shrink_to_fit()
+    assert table.capacity == 70000
+    assert table[69999] == ['Pikachu, the electric mouse', 69999, False]
+    table.append(['Raichu', 1, True])
+    assert table[70000] == ['Raichu', 1, True]
+
+
+def test_shrink_to_fit_empty_table(table):
+    table.reserve(100)
+    table.shrink_to_fit()
+    assert table.capacity == 1
+    table.append(['Pikachu', 12, True])
+    assert table[0] == ['Pikachu', 12, True]
+
+
+def test_capacity_of_table_without_columns():
+    table = quicktable.Table([])
+    table.append([])
+    assert table.capacity == 1
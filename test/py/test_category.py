@@ -0,0 +1,51 @@
+import textwrap
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    return quicktable.Table([
+        ('Name', 'str'),
+        ('Region', 'category'),
+    ])
+
+
+def test_category_blueprint(table):
+    assert table.blueprint == [('Name', 'str'), ('Region', 'category')]
+
+
+def test_append_category(table):
+    table.append(['Pikachu', 'Kanto'])
+    table.append(['Togepi', 'Johto'])
+    table.append(['Raichu', 'Kanto'])
+
+    assert table[0] == ['Pikachu', 'Kanto']
+    assert table[1] == ['Togepi', 'Johto']
+    assert table[2] == ['Raichu', 'Kanto']
+
+
+def test_category_values_are_shared(table):
+    table.append(['Pikachu', 'Kanto'])
+    table.append(['Raichu', 'Kanto'])
+
+    assert table[0][1] is table[1][1]
+
+
+def test_append_mismatching_type_for_category(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.append(['Pikachu', None])
+    assert str(excinfo.value) == 'non-str entry for category column'
+
+
+def test_pop_category(table):
+    table.append(['Pikachu', 'Kanto'])
+    assert table.pop() == ['Pikachu', 'Kanto']
+
+
+def test_print_category(table):
+    table.append(['Pikachu', 'Kanto'])
+    assert str(table) == textwrap.dedent("""
+        | Name (str) | Region (category) |
+        | Pikachu    | Kanto             |
+    """).strip()
@@ -0,0 +1,144 @@
+import array
+import struct
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str'),
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+]
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table(BLUEPRINT)
+    table.append(['Pikachu', 12, 1.5, True])
+    table.append(['Raichu', None, 2.5, False])
+    return table
+
+
+def test_column_buffer_by_name(table):
+    with memoryview(table.column_buffer('Power')) as view:
+        assert view.format == 'd'
+        assert view.readonly
+        assert view.tolist() == [1.5, 2.5]
+
+
+def test_column_buffer_by_index(table):
+    with memoryview(table.column_buffer(-3)) as view:
+        assert view.format == 'q'
+        assert view.tolist()[0] == 12
+
+
+def test_column_buffer_nullable_exposes_cells(table):
+    with memoryview(table.column_buffer('Level')) as view:
+        assert len(view) == 2
+        assert view[0] == 12
+
+
+def test_column_buffer_reads_with_struct(table):
+    data = bytes(table.column_buffer('Power'))
+    assert struct.unpack('=2d', data) == (1.5, 2.5)
+
+
+@pytest.mark.parametrize('kind,typecode', [
+    ('int8', 'b'), ('int16', 'h'), ('int32', 'i'), ('uint8', 'B'), ('uint16', 'H'),
+    ('uint32', 'I'), ('uint64', 'Q'), ('float32', 'f'),
+])
+def test_column_buffer_narrow_types(kind, typecode):
+    table = quicktable.Table([('Value', kind)])
+    table.extend_columns([array.array(typecode, [1, 2, 3])])
+    buffer = table.column_buffer('Value')
+    assert buffer.format == typecode
+    assert memoryview(buffer).tolist() == [1, 2, 3]
+
+
+def test_column_buffer_is_zero_copy(table):
+    with memoryview(table.column_buffer('Power')) as first, memoryview(table.column_buffer('Power')) as second:
+        assert first.obj is not second.obj
+        assert array.array('d', first) == array.array('d', second)
+
+
+def test_column_buffers_cover_every_chunk():
+    n = 2 * quicktable.CHUNK_SIZE + 5
+    table = quicktable.Table([('Level', 'int')])
+    table.extend_columns([array.array('q', range(n))])
+
+    buffers = table.column_buffers('Level')
+    assert [len(buffer) for buffer in buffers] == [quicktable.CHUNK_SIZE, quicktable.CHUNK_SIZE, 5]
+    values = []
+    for buffer in buffers:
+        with memoryview(buffer) as view:
+            values.extend(view)
+    assert values == list(range(n))
+    assert memoryview(table.column_buffer('Level', -1)).tolist() == [n - 5, n - 4, n - 3, n - 2, n - 1]
+
+
+def test_column_buffer_of_empty_table():
+    table = quicktable.Table([('Level', 'int')])
+    with memoryview(table.column_buffer('Level')) as view:
+        assert view.tolist() == []
+
+
+def test_column_buffer_pins_table(table):
+    view = memoryview(table.column_buffer('Power'))
+    for mutate in (
+        lambda: table.append(['Mew', 1, 0.5, True]),
+        lambda: table.extend([['Mew', 1, 0.5, True]]),
+        lambda: table.extend_columns([['Mew'], [1], [0.5], [True]]),
+        lambda: table.pop(),
+        lambda: table.reserve(1000),
+        lambda: table.shrink_to_fit(),
+    ):
+        with pytest.raises(BufferError) as excinfo:
+            mutate()
+        assert str(excinfo.value) == 'table has exported buffers'
+
+    assert len(table) == 2
+    view.release()
+    table.append(['Mew', 1, 0.5, True])
+    assert len(table) == 3
+
+
+def test_column_buffer_without_exports_does_not_pin(table):
+    buffer = table.column_buffer('Power')
+    table.append(['Mew', 1, 0.5, True])
+    assert memoryview(buffer).tolist() == [1.5, 2.5, 0.5]
+    table.pop()
+    table.pop()
+    assert memoryview(buffer).tolist() == [1.5]
+
+
+def test_column_buffer_keeps_table_alive():
+    table = quicktable.Table([('Power', 'float')])
+    table.append([4.5])
+    view = memoryview(table.column_buffer('Power'))
+    del table
+    assert view[0] == 4.5
+
+
+def test_column_buffer_is_read_only(table):
+    with pytest.raises(TypeError):
+        struct.pack_into('d', table.column_buffer('Power'), 0, 1.0)
+
+
+@pytest.mark.parametrize('name', ['Name', 'Wild'])
+def test_column_buffer_non_numeric_column(table, name):
+    with pytest.raises(TypeError) as excinfo:
+        table.column_buffer(name)
+    assert str(excinfo.value) == 'column_buffer of non-numeric column'
+
+
+def test_column_buffer_unknown_column(table):
+    with pytest.raises(KeyError):
+        table.column_buffer('Attack')
+    with pytest.raises(IndexError):
+        table.column_buffer(4)
+
+
+def test_column_buffer_chunk_out_of_range(table):
+    with pytest.raises(IndexError) as excinfo:
+        table.column_buffer('Power', 1)
+    assert str(excinfo.value) == 'chunk index out of range'
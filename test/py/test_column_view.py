@@ -0,0 +1,108 @@
+import array
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table([('Name', 'str'), ('Level', 'int?'), ('Wild', 'bool'), ('Power', 'float32'), ('Type', 'category'), ('Rank', 'uint64')])
+    table.extend([
+        ['Pikachu', 12, True, 1.5, 'electric', 18446744073709551615],
+        ['Charmander', None, False, 2.25, 'fire', 18446744073709551615],
+        ['Squirtle', -30, True, -0.5, 'water', 2],
+    ])
+    return table
+
+
+def test_column_by_name_and_position(table):
+    assert table['Level'].tolist() == [12, None, -30]
+    assert table.column('Level').tolist() == [12, None, -30]
+    assert table.column(1).tolist() == [12, None, -30]
+    assert table.column(-1).tolist() == [18446744073709551615, 18446744073709551615, 2]
+
+
+def test_column_missing(table):
+    with pytest.raises(KeyError):
+        table['Attack']
+    with pytest.raises(IndexError):
+        table.column(6)
+
+
+def test_column_view_attributes(table):
+    column = table['Level']
+    assert isinstance(column, quicktable.ColumnView)
+    assert column.name == 'Level'
+    assert column.type == 'int?'
+    assert len(column) == 3
+    assert repr(column) == '<quicktable.ColumnView Level (int?), 3 rows>'
+
+
+def test_column_view_indexing(table):
+    column = table['Name']
+    assert column[0] == 'Pikachu'
+    assert column[-1] == 'Squirtle'
+    with pytest.raises(IndexError) as excinfo:
+        column[3]
+    assert str(excinfo.value) == 'row index out of range'
+    with pytest.raises(TypeError):
+        column['Pikachu']
+
+
+def test_column_view_slicing(table):
+    assert table['Name'][::-1].tolist() == ['Squirtle', 'Charmander', 'Pikachu']
+    assert table[1:]['Type'][1:].tolist() == ['water']
+
+
+def test_column_view_iteration(table):
+    assert list(table['Wild']) == [True, False, True]
+    assert [type_ for type_ in table['Type']] == ['electric', 'fire', 'water']
+
+
+def test_column_view_sees_appends(table):
+    column = table['Name']
+    table.append(['Mew', 151, True, 0.0, 'psychic', 0])
+    assert len(column) == 4
+    assert column[3] == 'Mew'
+
+
+def test_column_view_keeps_table_alive(table):
+    column = table['Power']
+    del table
+    assert column.tolist() == [1.5, 2.25, -0.5]
+
+
+def test_column_view_sum(table):
+    assert table['Level'].sum() == -18
+    assert table['Wild'].sum() == 2
+    assert table['Power'].sum() == 3.25
+    assert table['Rank'].sum() == 2 * 18446744073709551615 + 2
+
+
+def test_column_view_sum_of_empty_and_all_null():
+    table = quicktable.Table([('Level', 'int?'), ('Power', 'float')])
+    assert table['Level'].sum() == 0
+    assert table['Power'].sum() == 0.0
+    table.append([None, 1.0])
+    assert table['Level'].sum() == 0
+
+
+def test_column_view_sum_of_non_numeric(table):
+    for name in ('Name', 'Type'):
+        with pytest.raises(TypeError) as excinfo:
+            table[name].sum()
+        assert str(excinfo.value) == 'sum of non-numeric column'
+
+
+def test_column_view_sum_overflowing_int64():
+    table = quicktable.Table([('Level', 'int')])
+    table.extend_columns([array.array('q', [9223372036854775807] * 4 + [-9223372036854775808] * 9)])
+    assert table['Level'].sum() == 4 * 9223372036854775807 - 9 * 9223372036854775808
+
+
+def test_column_view_of_compressed_chunks():
+    n = quicktable.CHUNK_SIZE + 10
+    table = quicktable.Table([('Level', 'int16')])
+    table.extend_columns([array.array('h', [i % 1000 for i in range(n)])])
+    table.compress()
+    assert table['Level'].tolist() == [i % 1000 for i in range(n)]
+    assert table['Level'].sum() == sum(i % 1000 for i in range(n))
@@ -0,0 +1,167 @@
+import array
+import random
+import pytest
+import quicktable
+
+CHUNK = quicktable.CHUNK_SIZE
+
+
+def reserved(table, name):
+    return next(usage['reserved'] for usage in table.memory_usage() if usage['name'] == name)
+
+
+def rows(table):
+    return [table[i] for i in range(len(table))]
+
+
+@pytest.fixture
+def table():
+    n = 2 * CHUNK
+    table = quicktable.Table([
+        ('Id', 'int'),
+        ('Caught', 'int?'),
+        ('Shiny', 'bool'),
+        ('Stage', 'int8'),
+        ('Rank', 'uint64'),
+        ('Power', 'float'),
+    ])
+    table.extend_columns([
+        array.array('q', range(n)),
+        [None if i == 5 else 1600000000 + 60 * i for i in range(n)],
+        [i // 5000 % 2 == 0 for i in range(n)],
+        array.array('b', [i % 3 - 1 for i in range(n)]),
+        array.array('Q', [18446744073709551615 - i // 1000 for i in range(n)]),
+        array.array('d', [0.5] * n),
+    ])
+    return table
+
+
+def test_compress_keeps_values(table):
+    expected = rows(table)
+    table.compress()
+    assert rows(table) == expected
+
+
+def test_compress_shrinks_int_and_bool_columns(table):
+    before = {name: reserved(table, name) for name in ('Id', 'Caught', 'Shiny', 'Power')}
+    table.compress()
+    assert reserved(table, 'Id') * 10 < before['Id']
+    assert reserved(table, 'Caught') * 4 < before['Caught']
+    assert reserved(table, 'Shiny') * 3 < before['Shiny']
+    assert reserved(table, 'Power') == before['Power']
+
+
+def test_compress_one_column(table):
+    before = reserved(table, 'Caught')
+    table.compress('Id')
+    assert reserved(table, 'Caught') == before
+    table.compress(1)
+    assert reserved(table, 'Caught') < before
+
+
+def test_compress_non_int_column(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.compress('Power')
+    assert str(excinfo.value) == 'compress of non-int, non-bool column'
+
+
+def test_compress_leaves_random_values_alone():
+    values = [random.getrandbits(64) - 2 ** 63 for _ in range(CHUNK)]
+    table = quicktable.Table([('Seed', 'int')])
+    table.extend_columns([array.array('q', values)])
+    before = reserved(table, 'Seed')
+    table.compress()
+    assert reserved(table, 'Seed') == before
+    assert [row[0] for row in rows(table)] == values
+
+
+@pytest.mark.parametrize('type_, typecode, low, high', [
+    ('int', 'q', -9223372036854775808, 9223372036854775807),
+    ('int8', 'b', -128, 127),
+    ('int16', 'h', -32768, 32767),
+    ('int32', 'i', -2147483648, 2147483647),
+    ('uint8', 'B', 0, 255),
+    ('uint16', 'H', 0, 65535),
+    ('uint32', 'I', 0, 4294967295),
+    ('uint64', 'Q', 0, 18446744073709551615),
+])
+def test_compress_extremes(type_, typecode, low, high):
+    values = [low if i % 2048 < 1024 else high for i in range(CHUNK)]
+    values[7] = high
+    table = quicktable.Table([('Level', type_)])
+    table.extend_columns([array.array(typecode, values)])
+    table.compress()
+    assert [row[0] for row in rows(table)] == values
+
+
+def test_append_and_pop_after_compress(table):
+    expected = rows(table)
+    table.compress()
+    table.append([-1, None, True, 0, 1, 1.5])
+    assert table.pop() == [-1, None, True, 0, 1, 1.5]
+    assert table.pop() == expected[-1]
+    table.append([-2, 5, False, 1, 2, 2.5])
+    assert table[len(table) - 1] == [-2, 5, False, 1, 2, 2.5]
+    assert rows(table)[:-1] == expected[:-1]
+
+
+
+def test_compress_after_rewriting_a_decoded_block():
+    table = quicktable.Table([('Id', 'int')])
+    table.extend_columns([array.array('q', range(CHUNK))])
+    table.compress()
+    assert table[CHUNK - 1] == [CHUNK - 1]
+    table.pop()
+    table.append([5])
+    table.compress()
+    assert table[CHUNK - 1] == [5]
+
+def test_compress_again_takes_new_full_chunks(table):
+    table.compress()
+    before = reserved(table, 'Id')
+    table.extend_columns([
+        array.array('q', range(CHUNK)),
+        [1] * CHUNK,
+        [True] * CHUNK,
+        array.array('b', [0] * CHUNK),
+        array.array('Q', [0] * CHUNK),
+        array.array('d', [0.0] * CHUNK),
+    ])
+    table.compress()
+    assert reserved(table, 'Id') < before + CHUNK * 8 // 10
+
+
+def test_compressed_column_buffer(table):
+    expected = [row[0] for row in rows(table)]
+    table.compress()
+    assert list(memoryview(table.column_buffer('Id', 1))) == expected[CHUNK:]
+
+
+def test_compress_with_exported_buffers(table):
+    view = memoryview(table.column_buffer('Id'))
+    with pytest.raises(BufferError):
+        table.compress()
+    view.release()
+    table.compress()
+
+
+def test_compressed_to_csv_and_save(tmp_path, table):
+    expected = rows(table)
+    plain = tmp_path / 'plain.csv'
+    table.to_csv(plain)
+    table.compress()
+    compressed = tmp_path / 'compressed.csv'
+    table.to_csv(compressed)
+    assert compressed.read_text() == plain.read_text()
+
+    table.save(tmp_path / 'compressed.qtb')
+    assert rows(quicktable.load(tmp_path / 'compressed.qtb')) == expected
+
+
+def test_compressed_arrow_export(table):
+    pyarrow = pytest.importorskip('pyarrow')
+    expected = rows(table)
+    table.compress()
+    exported = pyarrow.table(table)
+    assert exported.column('Id').to_pylist() == [row[0] for row in expected]
+    assert exported.column('Shiny').to_pylist() == [row[2] for row in expected]
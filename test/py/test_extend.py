@@ -0,0 +1,73 @@
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    return quicktable.Table([
+        ('Name', 'str'),
+        ('Level', 'int?'),
+        ('Wild', 'bool'),
+        ('Type', 'category'),
+    ])
+
+
+def test_extend_with_list(table):
+    table.extend([['Pikachu', 12, True, 'electric'], ('Charmander', None, False, 'fire')])
+    assert len(table) == 2
+    assert table[0] == ['Pikachu', 12, True, 'electric']
+    assert table[1] == ['Charmander', None, False, 'fire']
+
+
+def test_extend_with_generator(table):
+    table.extend(['Pikachu, the electric mouse', i, i % 2 == 0, 'electric'] for i in range(70000))
+    assert len(table) == 70000
+    assert table[69999] == ['Pikachu, the electric mouse', 69999, False, 'electric']
+
+
+def test_extend_after_append(table):
+    table.append(['Pikachu', 12, True, 'electric'])
+    table.extend([['Raichu', 30, False, 'electric']])
+    assert table[1] == ['Raichu', 30, False, 'electric']
+
+
+def test_extend_with_nothing(table):
+    table.extend([])
+    assert len(table) == 0
+
+
+def test_extend_non_iterable_is_invalid(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.extend(None)
+    assert str(excinfo.value) == 'extend with non-iterable'
+
+
+def test_extend_non_sequence_row_is_invalid(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.extend([['Pikachu', 12, True, 'electric'], None])
+    assert str(excinfo.value) == 'extend with non-sequence row'
+    assert len(table) == 0
+
+
+def test_extend_mismatching_row_length_is_invalid(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.extend([['Pikachu', 12, True, 'electric'], ['Pikachu']])
+    assert str(excinfo.value) == 'extend with mismatching row length'
+    assert len(table) == 0
+
+
+def test_extend_mismatching_type_appends_nothing(table):
+    table.append(['Pikachu', 12, True, 'electric'])
+    with pytest.raises(TypeError):
+        table.extend([['Raichu, the evolved mouse', 30, False, 'electric'], ['Charmander', 'five', False, 'fire']])
+    assert len(table) == 1
+    table.append(['Charmander', 5, False, 'fire'])
+    assert table[1] == ['Charmander', 5, False, 'fire']
+    assert table.memory_usage()[0]['used'] == 2 * 16
+
+
+def test_append_mismatching_type_leaves_columns_aligned(table):
+    with pytest.raises(TypeError):
+        table.append(['Pikachu', 12, 'yes', 'electric'])
+    table.append(['Raichu', 30, False, 'electric'])
+    assert table[0] == ['Raichu', 30, False, 'electric']
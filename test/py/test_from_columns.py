@@ -0,0 +1,75 @@
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str'),
+    ('Level', 'int?'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+]
+
+
+def test_from_columns():
+    table = quicktable.Table.from_columns(BLUEPRINT, [
+        ['Pikachu', 'Charmander'],
+        (12, None),
+        [True, False],
+        ['electric', 'fire'],
+    ])
+    assert len(table) == 2
+    assert table[0] == ['Pikachu', 12, True, 'electric']
+    assert table[1] == ['Charmander', None, False, 'fire']
+    assert table.blueprint == BLUEPRINT
+
+
+def test_from_columns_large():
+    n = 100000
+    table = quicktable.Table.from_columns(BLUEPRINT, [
+        ['Pikachu'] * n,
+        range(n),
+        [True] * n,
+        ['electric'] * n,
+    ])
+    assert len(table) == n
+    assert table.capacity == n
+    assert table[n - 1] == ['Pikachu', n - 1, True, 'electric']
+
+
+def test_from_columns_passes_keywords():
+    pool = quicktable.Pool()
+    table = quicktable.Table.from_columns([('Level', 'int')], [[1, 2, 3]], capacity=1000, allocator=pool)
+    assert table.capacity == 1000
+    assert table[2] == [3]
+
+
+def test_from_columns_without_columns():
+    assert len(quicktable.Table.from_columns([], [])) == 0
+
+
+def test_from_columns_invalid_blueprint():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table.from_columns(None, [])
+    assert str(excinfo.value) == 'invalid blueprint'
+
+
+def test_from_columns_mismatching_column_count():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table.from_columns(BLUEPRINT, [['Pikachu']])
+    assert str(excinfo.value) == 'from_columns with mismatching column count'
+
+
+def test_from_columns_mismatching_column_lengths():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table.from_columns(BLUEPRINT, [['Pikachu'], [12], [True, False], ['electric']])
+    assert str(excinfo.value) == 'from_columns with mismatching column lengths'
+
+
+def test_from_columns_non_sequence_column():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table.from_columns(BLUEPRINT, [['Pikachu'], 12, [True], ['electric']])
+    assert str(excinfo.value) == 'from_columns with non-sequence column'
+
+
+def test_from_columns_mismatching_type():
+    with pytest.raises(TypeError):
+        quicktable.Table.from_columns(BLUEPRINT, [['Pikachu'], ['twelve'], [True], ['electric']])
@@ -0,0 +1,145 @@
+import array
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table([('Name', 'str'), ('Level', 'int?'), ('Type', 'category'), ('Rank', 'uint64'), ('Power', 'float')])
+    table.extend([
+        ['Pikachu', 12, 'electric', 18446744073709551615, 1.5],
+        ['Charmander the long', None, 'fire', 1, 2.25],
+        ['Squirtle', 12, 'water', 2, -0.5],
+        ['Charmeleon', 5, 'fire', 3, 0.0],
+    ])
+    return table
+
+
+def test_lookup(table):
+    table.create_index('Name', unique=True)
+    table.create_index('Level')
+    table.create_index(2)
+    table.create_index('Rank')
+    assert table.lookup('Name', 'Squirtle') == [2]
+    assert table.lookup('Name', 'Charmander the long') == [1]
+    assert table.lookup('Name', 'Mew') == []
+    assert table.lookup('Level', 12) == [0, 2]
+    assert table.lookup(1, 5) == [3]
+    assert table.lookup('Type', 'fire') == [1, 3]
+    assert table.lookup('Type', 'grass') == []
+    assert table.lookup('Rank', 18446744073709551615) == [0]
+    assert table.lookup('Rank', -1) == []
+    assert table.lookup('Level', 2 ** 70) == []
+
+
+def test_lookup_follows_appends_and_pops(table):
+    table.create_index('Name', unique=True)
+    table.create_index('Type')
+    table.append(['Mew', 151, 'psychic', 4, 1.0])
+    table.extend([['Charizard', 36, 'fire', 5, 3.0]])
+    table.extend_columns([['Eevee'], [1], ['normal'], [6], [0.5]])
+    assert table.lookup('Name', 'Mew') == [4]
+    assert table.lookup('Name', 'Eevee') == [6]
+    assert table.lookup('Type', 'fire') == [1, 3, 5]
+
+    assert table.pop()[0] == 'Eevee'
+    assert table.pop()[0] == 'Charizard'
+    assert table.lookup('Name', 'Charizard') == []
+    assert table.lookup('Type', 'fire') == [1, 3]
+    table.append(['Charizard', 36, 'fire', 5, 3.0])
+    assert table.lookup('Name', 'Charizard') == [5]
+
+
+def test_unique_index_rejects_duplicates(table):
+    table.create_index('Name', unique=True)
+    table.create_index('Type')
+    with pytest.raises(ValueError) as excinfo:
+        table.append(['Pikachu', 1, 'electric', 0, 0.0])
+    assert str(excinfo.value) == 'duplicate key in unique index'
+    with pytest.raises(ValueError):
+        table.extend([['Mew', 151, 'psychic', 4, 1.0], ['Mew', 151, 'psychic', 4, 1.0]])
+    assert len(table) == 4
+    assert table.lookup('Name', 'Mew') == []
+    assert table.lookup('Type', 'electric') == [0]
+    assert table.lookup('Type', 'psychic') == []
+
+
+def test_unique_index_over_duplicates(table):
+    with pytest.raises(ValueError) as excinfo:
+        table.create_index('Level', unique=True)
+    assert str(excinfo.value) == 'duplicate key in unique index'
+    with pytest.raises(KeyError):
+        table.lookup('Level', 12)
+    table.create_index('Level')
+    assert table.lookup('Level', 12) == [0, 2]
+
+
+def test_nulls_are_not_indexed(table):
+    table.create_index('Level')
+    with pytest.raises(TypeError) as excinfo:
+        table.lookup('Level', None)
+    assert str(excinfo.value) == 'lookup with non-int key'
+    table.pop()
+    table.pop()
+    table.pop()
+    assert table.lookup('Level', 12) == [0]
+
+
+def test_index_errors(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.create_index('Power')
+    assert str(excinfo.value) == 'index of float or bool column'
+    with pytest.raises(KeyError):
+        table.create_index('Attack')
+    table.create_index('Name')
+    with pytest.raises(ValueError) as excinfo:
+        table.create_index(0)
+    assert str(excinfo.value) == 'column already indexed'
+    with pytest.raises(KeyError):
+        table.lookup('Level', 12)
+    with pytest.raises(TypeError) as excinfo:
+        table.lookup('Name', 12)
+    assert str(excinfo.value) == 'lookup with non-str key'
+    with pytest.raises(TypeError):
+        table[1:].create_index('Level')
+
+
+
+def test_lookup_on_view(table):
+    table.create_index('Type')
+    table.create_index('Level')
+    table.extend([['Charizard', 36, 'fire', 5, 3.0], ['Vulpix', 12, 'fire', 6, 1.0]])
+    assert table[1:].lookup('Type', 'fire') == [0, 2, 3, 4]
+    assert table[::2].lookup('Type', 'fire') == [2]
+    assert table[1:5:2].lookup('Type', 'fire') == [0, 1]
+    assert table[::-1].lookup('Type', 'fire') == [0, 1, 2, 4]
+    assert table[5:0:-3].lookup('Level', 12) == [0, 1]
+    assert table[4:0:-3].lookup('Level', 12) == []
+    assert table[::-1][1:4].lookup('Type', 'fire') == [0, 1]
+    assert table[2:2].lookup('Type', 'fire') == []
+
+    view = table[:2]
+    table.append(['Ponyta', 12, 'fire', 7, 1.0])
+    assert view.lookup('Type', 'fire') == [1]
+    with pytest.raises(KeyError):
+        view.lookup('Name', 'Pikachu')
+
+def test_index_across_chunks():
+    n = 2 * quicktable.CHUNK_SIZE + 3
+    table = quicktable.Table([('Id', 'int'), ('Group', 'int16')])
+    table.extend_columns([array.array('q', range(n)), array.array('h', [i % 7 for i in range(n)])])
+    table.create_index('Id', unique=True)
+    table.create_index('Group')
+    table.compress()
+    assert table.lookup('Id', n - 1) == [n - 1]
+    assert table.lookup('Group', 3) == list(range(3, n, 7))
+    while len(table) > 10:
+        table.pop()
+    assert table.lookup('Group', 3) == [3]
+    assert table.lookup('Id', 10) == []
+
+
+def test_index_counts_toward_sizeof(table):
+    before = table.__sizeof__()
+    table.create_index('Name')
+    assert table.__sizeof__() > before
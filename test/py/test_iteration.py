@@ -0,0 +1,87 @@
+import array
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table([('Name', 'str?'), ('Level', 'int?'), ('Wild', 'bool'), ('Type', 'category'), ('Stage', 'uint8')])
+    table.extend([
+        ['Pikachu', 12, True, 'electric', 1],
+        [None, None, False, 'fire', 2],
+        ['Mr. Mime, the mime of Kanto', -3, True, 'psychic', 0],
+    ])
+    return table
+
+
+def test_iterate_rows_as_tuples(table):
+    assert list(table) == [
+        ('Pikachu', 12, True, 'electric', 1),
+        (None, None, False, 'fire', 2),
+        ('Mr. Mime, the mime of Kanto', -3, True, 'psychic', 0),
+    ]
+
+
+def test_iterate_empty_table():
+    assert list(quicktable.Table([('Name', 'str')])) == []
+
+
+def test_iterate_table_without_columns():
+    table = quicktable.Table([])
+    assert list(table) == []
+
+
+def test_iterate_unpacking(table):
+    names = [name for name, level, wild, type_, stage in table]
+    assert names == ['Pikachu', None, 'Mr. Mime, the mime of Kanto']
+
+
+def test_iterate_held_rows_stay_intact(table):
+    rows = []
+    for row in table:
+        rows.append(row)
+    assert rows[0] == ('Pikachu', 12, True, 'electric', 1)
+    assert rows[0] is not rows[1]
+
+
+def test_iterate_reuses_released_rows(table):
+    iterator = iter(table)
+    assert len({id(next(iterator)) for _ in range(3)}) == 1
+
+
+def test_iterator_protocol(table):
+    iterator = iter(table)
+    assert iter(iterator) is iterator
+    assert iterator.__length_hint__() == 3
+    next(iterator)
+    assert iterator.__length_hint__() == 2
+    assert len(list(iterator)) == 2
+    with pytest.raises(StopIteration):
+        next(iterator)
+
+
+def test_iterate_sees_appends_and_pops(table):
+    iterator = iter(table)
+    next(iterator)
+    table.append(['Mew', 151, True, 'psychic', 3])
+    table.pop()
+    table.pop()
+    assert list(iterator) == [(None, None, False, 'fire', 2)]
+
+
+def test_iterate_view(table):
+    assert list(table[::-2]) == [tuple(table[2]), tuple(table[0])]
+
+
+def test_iterate_across_chunks_and_compressed():
+    n = 2 * quicktable.CHUNK_SIZE + 3
+    table = quicktable.Table([('Level', 'int'), ('Wild', 'bool')])
+    table.extend_columns([array.array('q', range(n)), [i % 3 == 0 for i in range(n)]])
+    table.compress()
+    assert list(table) == [(i, i % 3 == 0) for i in range(n)]
+
+
+def test_iterator_keeps_table_alive(table):
+    iterator = iter(table)
+    del table
+    assert next(iterator)[0] == 'Pikachu'
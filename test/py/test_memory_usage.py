@@ -0,0 +1,67 @@
+import sys
+
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    return quicktable.Table([
+        ('Name', 'str'),
+        ('Level', 'int?'),
+        ('Wild', 'bool'),
+        ('Type', 'category'),
+    ])
+
+
+def usage_of(table, name):
+    return next(usage for usage in table.memory_usage() if usage['name'] == name)
+
+
+def test_memory_usage_lists_every_column(table):
+    assert [usage['name'] for usage in table.memory_usage()] == ['Name', 'Level', 'Wild', 'Type']
+
+
+def test_memory_usage_of_empty_table(table):
+    level = usage_of(table, 'Level')
+    assert level['used'] == 0
+    assert level['reserved'] > 0
+    assert level['strings'] == 0
+    assert level['overhead'] > 0
+
+
+def test_memory_usage_counts_cells(table):
+    table.reserve(1000)
+    for i in range(100):
+        table.append(['Pikachu', i, True, 'electric'])
+
+    level = usage_of(table, 'Level')
+    assert level['used'] == 100 * 8 + 2 * 8
+    assert level['reserved'] == 1000 * 8 + 16 * 8
+
+
+def test_memory_usage_counts_string_heap(table):
+    table.append(['Pikachu', 12, True, 'electric'])
+    assert usage_of(table, 'Name')['strings'] == 0
+
+    table.append(['Pikachu, the electric mouse', 12, True, 'electric'])
+    assert usage_of(table, 'Name')['strings'] > 0
+    assert usage_of(table, 'Type')['strings'] > 0
+
+
+def test_memory_usage_reflects_shrink_to_fit(table):
+    table.reserve(100000)
+    table.append(['Pikachu', 12, True, 'electric'])
+    before = usage_of(table, 'Name')['reserved']
+    table.shrink_to_fit()
+    assert usage_of(table, 'Name')['reserved'] < before
+
+
+def test_sizeof_includes_column_storage(table):
+    empty = sys.getsizeof(table)
+    table.reserve(100000)
+    assert sys.getsizeof(table) >= empty + 100000 * (16 + 8 + 4)
+
+
+def test_sizeof_table_without_columns():
+    assert sys.getsizeof(quicktable.Table([])) > 0
@@ -0,0 +1,89 @@
+import textwrap
+import pytest
+import quicktable
+
+
+RANGES = [
+    ('int8', -2 ** 7, 2 ** 7 - 1),
+    ('int16', -2 ** 15, 2 ** 15 - 1),
+    ('int32', -2 ** 31, 2 ** 31 - 1),
+    ('int', -2 ** 63, 2 ** 63 - 1),
+    ('uint8', 0, 2 ** 8 - 1),
+    ('uint16', 0, 2 ** 16 - 1),
+    ('uint32', 0, 2 ** 32 - 1),
+    ('uint64', 0, 2 ** 64 - 1),
+]
+
+
+@pytest.mark.parametrize('type_, low, high', RANGES)
+def test_append_bounds(type_, low, high):
+    table = quicktable.Table([('Level', type_)])
+    table.append([low])
+    table.append([high])
+
+    assert table[0] == [low]
+    assert table[1] == [high]
+
+
+@pytest.mark.parametrize('type_, low, high', RANGES)
+def test_append_above_range(type_, low, high):
+    table = quicktable.Table([('Level', type_)])
+    with pytest.raises(OverflowError) as excinfo:
+        table.append([high + 1])
+    assert str(excinfo.value) == 'int out of range for {} column'.format(type_)
+    assert len(table) == 0
+
+
+@pytest.mark.parametrize('type_, low, high', RANGES)
+def test_append_below_range(type_, low, high):
+    table = quicktable.Table([('Level', type_)])
+    with pytest.raises(OverflowError) as excinfo:
+        table.append([low - 1])
+    assert str(excinfo.value) == 'int out of range for {} column'.format(type_)
+
+
+@pytest.mark.parametrize('type_', [r[0] for r in RANGES if r[0] != 'int'])
+def test_append_non_int(type_):
+    table = quicktable.Table([('Level', type_)])
+    with pytest.raises(TypeError) as excinfo:
+        table.append(['12'])
+    assert str(excinfo.value) == 'non-int entry for {} column'.format(type_)
+
+
+def test_float32():
+    table = quicktable.Table([('Power', 'float32')])
+    table.append([0.5])
+    table.append([float('inf')])
+
+    assert table[0] == [0.5]
+    assert table[1] == [float('inf')]
+
+
+def test_float32_out_of_range():
+    table = quicktable.Table([('Power', 'float32')])
+    with pytest.raises(OverflowError) as excinfo:
+        table.append([1e39])
+    assert str(excinfo.value) == 'float out of range for float32 column'
+
+
+def test_float32_non_float():
+    table = quicktable.Table([('Power', 'float32')])
+    with pytest.raises(TypeError) as excinfo:
+        table.append([1])
+    assert str(excinfo.value) == 'non-float entry for float32 column'
+
+
+def test_narrow_types_blueprint():
+    blueprint = [(type_, type_) for type_, _, _ in RANGES] + [('float32', 'float32'), ('int8?', 'int8?')]
+    assert quicktable.Table(blueprint).blueprint == blueprint
+
+
+def test_print_narrow_types():
+    table = quicktable.Table([('Level', 'uint8'), ('Power', 'float32'), ('Rank', 'int16?')])
+    table.append([255, 1.5, None])
+    table.append([3, 2.25, -12])
+    assert str(table) == textwrap.dedent("""
+        | Level (uint8) | Power (float32) | Rank (int16?) |
+        | 255           | 1.50            | None          |
+        | 3             | 2.25            | -12           |
+    """).strip()
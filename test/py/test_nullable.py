@@ -0,0 +1,88 @@
+import textwrap
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    return quicktable.Table([
+        ('Name', 'str?'),
+        ('Level', 'int?'),
+        ('Wild', 'bool?'),
+        ('Power', 'float?'),
+        ('Region', 'category?'),
+    ])
+
+
+def test_nullable_blueprint(table):
+    assert table.blueprint == [
+        ('Name', 'str?'),
+        ('Level', 'int?'),
+        ('Wild', 'bool?'),
+        ('Power', 'float?'),
+        ('Region', 'category?'),
+    ]
+
+
+def test_append_none(table):
+    table.append([None, None, None, None, None])
+    assert table[0] == [None, None, None, None, None]
+
+
+def test_append_mixed_none(table):
+    table.append(['Pikachu', None, True, None, 'Kanto'])
+    table.append([None, 12, None, 3.5, None])
+
+    assert table[0] == ['Pikachu', None, True, None, 'Kanto']
+    assert table[1] == [None, 12, None, 3.5, None]
+
+
+def test_nulls_across_bitmap_words(table):
+    for i in range(200):
+        table.append([None if i % 7 else 'Pikachu', i if i % 3 else None, True, 1.0, 'Kanto'])
+
+    for i in range(200):
+        row = table[i]
+        assert row[0] == (None if i % 7 else 'Pikachu')
+        assert row[1] == (i if i % 3 else None)
+
+
+def test_pop_none(table):
+    table.append(['Pikachu, the electric mouse', 1, True, 1.0, 'Kanto'])
+    table.append([None, None, None, None, None])
+    assert table.pop() == [None, None, None, None, None]
+    assert table.pop() == ['Pikachu, the electric mouse', 1, True, 1.0, 'Kanto']
+
+
+def test_append_none_to_non_nullable_column():
+    table = quicktable.Table([('Level', 'int')])
+    with pytest.raises(TypeError) as excinfo:
+        table.append([None])
+    assert str(excinfo.value) == 'non-int entry for int column'
+
+
+def test_append_wrong_type_to_nullable_column(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.append(['Pikachu', 'twelve', None, None, None])
+    assert str(excinfo.value) == 'non-int entry for int column'
+
+
+def test_print_none():
+    table = quicktable.Table([('Name', 'str'), ('Level', 'int?')])
+    table.append(['Pikachu', None])
+    assert str(table) == textwrap.dedent("""
+        | Name (str) | Level (int?) |
+        | Pikachu    | None         |
+    """).strip()
+
+
+def test_invalid_nullable_column_type():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table([('Name', 'Foo?')])
+    assert str(excinfo.value) == 'invalid blueprint'
+
+
+def test_lone_question_mark_is_invalid_column_type():
+    with pytest.raises(TypeError) as excinfo:
+        quicktable.Table([('Name', '?')])
+    assert str(excinfo.value) == 'invalid blueprint'
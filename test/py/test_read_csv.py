@@ -0,0 +1,136 @@
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str'),
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+]
+
+
+def write(tmp_path, text):
+    path = tmp_path / 'pokemon.csv'
+    path.write_text(text)
+    return path
+
+
+def test_read_csv(tmp_path):
+    path = write(tmp_path, 'Name,Level,Power,Wild,Type\nPikachu,12,1.5,True,electric\nCharmander,,2,false,fire\n')
+    table = quicktable.read_csv(path, BLUEPRINT)
+    assert len(table) == 2
+    assert table[0] == ['Pikachu', 12, 1.5, True, 'electric']
+    assert table[1] == ['Charmander', None, 2.0, False, 'fire']
+
+
+def test_read_csv_without_header(tmp_path):
+    path = write(tmp_path, 'Pikachu,12,1.5,1,electric')
+    table = quicktable.read_csv(str(path), BLUEPRINT, header=False)
+    assert table[0] == ['Pikachu', 12, 1.5, True, 'electric']
+
+
+def test_read_csv_quoted_fields(tmp_path):
+    path = write(tmp_path, '"Mr. ""Mime""",1,1.0,True,"psychic, fairy"\r\n"Multi\nline",,2.0,False,""\r\n')
+    table = quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert table[0] == ['Mr. "Mime"', 1, 1.0, True, 'psychic, fairy']
+    assert table[1] == ['Multi\nline', None, 2.0, False, '']
+
+
+def test_read_csv_empty_fields(tmp_path):
+    path = write(tmp_path, 'a,b\n,\n"",""\n')
+    table = quicktable.read_csv(path, [('A', 'str'), ('B', 'str?')])
+    assert table[0] == ['', None]
+    assert table[1] == ['', '']
+
+
+def test_read_csv_delimiter(tmp_path):
+    path = write(tmp_path, 'Pikachu;12;1.5;True;electric\n')
+    table = quicktable.read_csv(path, BLUEPRINT, delimiter=';', header=False)
+    assert table[0] == ['Pikachu', 12, 1.5, True, 'electric']
+
+
+def test_read_csv_empty_file(tmp_path):
+    path = write(tmp_path, '')
+    assert len(quicktable.read_csv(path, BLUEPRINT)) == 0
+
+
+@pytest.mark.parametrize('threads', [0, 1, 3, 8])
+def test_read_csv_threads(tmp_path, threads):
+    n = 200000
+    rows = ('"Pokemon, number {0}",{0},{0}.5,{1},{2}\n'.format(i, i % 2 == 0, ('fire', 'water', 'grass')[i % 3]) for i in range(n))
+    path = write(tmp_path, 'Name,Level,Power,Wild,Type\n' + ''.join(rows))
+
+    table = quicktable.read_csv(path, BLUEPRINT, threads=threads)
+    assert len(table) == n
+    for i in (0, 1, 65535, 65536, 100001, n - 1):
+        assert table[i] == ['Pokemon, number {}'.format(i), i, i + 0.5, i % 2 == 0, ('fire', 'water', 'grass')[i % 3]]
+
+
+def test_read_csv_with_allocator(tmp_path):
+    path = write(tmp_path, 'Pikachu,12,1.5,True,electric\n' * 1000)
+    table = quicktable.read_csv(path, BLUEPRINT, header=False, threads=4, capacity=1000, allocator='arena')
+    assert len(table) == 1000
+    assert table[999] == ['Pikachu', 12, 1.5, True, 'electric']
+
+
+def test_read_csv_invalid_entry(tmp_path):
+    path = write(tmp_path, 'Pikachu,12,1.5,True,electric\nRaichu,high,1.5,True,electric\n')
+    with pytest.raises(ValueError) as error:
+        quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert str(error.value) == "non-int entry for int column (row 1, column 'Level')"
+
+
+def test_read_csv_int_out_of_range(tmp_path):
+    path = write(tmp_path, 'Pikachu,99999999999999999999,1.5,True,electric\n')
+    with pytest.raises(OverflowError) as error:
+        quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert str(error.value) == "int out of range for int column (row 0, column 'Level')"
+
+
+def test_read_csv_mismatching_row_length(tmp_path):
+    path = write(tmp_path, 'Pikachu,12,1.5,True,electric\nRaichu,30\n')
+    with pytest.raises(ValueError) as error:
+        quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert str(error.value) == 'read_csv with mismatching row length (row 1)'
+
+
+def test_read_csv_utf8(tmp_path):
+    path = tmp_path / 'pokemon.csv'
+    path.write_bytes('Flabébé,12,1.5,True,fée ✨\n"Mr. Mime 🎭",1,0,False,psychic\n'.encode())
+    table = quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert table[0] == ['Flabébé', 12, 1.5, True, 'fée ✨']
+    assert table[1][0] == 'Mr. Mime 🎭'
+
+
+@pytest.mark.parametrize('name, type_, column', [
+    (b'\xff\xfe', b'electric', 'Name'),
+    (b'Pikachu', b'electric\xc3', 'Type'),
+    (b'"Pika\xed\xa0\x80chu"', b'electric', 'Name'),
+    (b'Pika\xc0\xafchu', b'electric', 'Name'),
+])
+def test_read_csv_invalid_utf8(tmp_path, name, type_, column):
+    path = tmp_path / 'pokemon.csv'
+    path.write_bytes(b'Pikachu,12,1.5,True,electric\n' + name + b',12,1.5,True,' + type_ + b'\n')
+    with pytest.raises(ValueError) as error:
+        quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert str(error.value) == "read_csv with invalid UTF-8 (row 1, column '%s')" % column
+
+
+def test_read_csv_unterminated_quote(tmp_path):
+    path = write(tmp_path, '"Pikachu,12,1.5,True,electric\n')
+    with pytest.raises(ValueError) as error:
+        quicktable.read_csv(path, BLUEPRINT, header=False)
+    assert str(error.value) == "read_csv with unterminated quoted field (row 0, column 'Name')"
+
+
+def test_read_csv_missing_file(tmp_path):
+    with pytest.raises(FileNotFoundError):
+        quicktable.read_csv(tmp_path / 'missing.csv', BLUEPRINT)
+
+
+def test_read_csv_invalid_blueprint(tmp_path):
+    path = write(tmp_path, '')
+    with pytest.raises(TypeError) as error:
+        quicktable.read_csv(path, [('Name', 'complex')])
+    assert str(error.value) == 'invalid blueprint'
@@ -0,0 +1,140 @@
+import json
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str'),
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+]
+
+
+def write(tmp_path, text):
+    path = tmp_path / 'pokemon.jsonl'
+    path.write_text(text, encoding='utf-8')
+    return path
+
+
+def test_read_jsonl(tmp_path):
+    path = write(tmp_path, (
+        '{"Name": "Pikachu", "Level": 12, "Power": 1.5, "Wild": true, "Type": "electric"}\n'
+        '{"Type":"fire","Wild":false,"Power":2,"Level":null,"Name":"Charmander"}\n'
+    ))
+    table = quicktable.read_jsonl(path, BLUEPRINT)
+    assert len(table) == 2
+    assert table[0] == ['Pikachu', 12, 1.5, True, 'electric']
+    assert table[1] == ['Charmander', None, 2.0, False, 'fire']
+
+
+def test_read_jsonl_skips_other_members(tmp_path):
+    path = write(tmp_path, (
+        '{"Id": 1, "Name": "Pikachu", "Moves": ["Thunder", {"power": [90, "}"]}], "Level": 12,'
+        ' "Notes": "a \\"quoted\\" } note", "Power": -1e3, "Wild": true, "Type": "electric", "Shiny": null}\n'
+    ))
+    table = quicktable.read_jsonl(str(path), BLUEPRINT)
+    assert table[0] == ['Pikachu', 12, -1000.0, True, 'electric']
+
+
+def test_read_jsonl_key_with_nul_is_another_member(tmp_path):
+    path = write(tmp_path, (
+        '{"Name\\u0000": "Mew", "Name": "Eevee", "Level\\u0000x": 3,'
+        ' "Power": 0.5, "Wild": true, "Type": "normal"}\n'
+    ))
+    table = quicktable.read_jsonl(path, BLUEPRINT)
+    assert table[0] == ['Eevee', None, 0.5, True, 'normal']
+
+
+def test_read_jsonl_missing_nullable_member(tmp_path):
+    path = write(tmp_path, '{"Name": "Eevee", "Power": 0.5, "Wild": true, "Type": "normal"}\n')
+    table = quicktable.read_jsonl(path, BLUEPRINT)
+    assert table[0] == ['Eevee', None, 0.5, True, 'normal']
+
+
+def test_read_jsonl_string_escapes(tmp_path):
+    names = ['Mr. "Mime"', 'back\\slash', 'tab\there\nnewline', 'Flabébé', '\U0001F600 emoji', '/']
+    path = write(tmp_path, ''.join(json.dumps({'Name': name}) + '\n' for name in names))
+    table = quicktable.read_jsonl(path, [('Name', 'str')])
+    assert [table[i][0] for i in range(len(table))] == names
+
+
+def test_read_jsonl_blank_lines_and_crlf(tmp_path):
+    path = write(tmp_path, '\n{"Name": "Pikachu"}\r\n  \n{"Name": "Raichu"}')
+    table = quicktable.read_jsonl(path, [('Name', 'str')])
+    assert [table[i] for i in range(len(table))] == [['Pikachu'], ['Raichu']]
+
+
+def test_read_jsonl_empty_file(tmp_path):
+    path = write(tmp_path, '')
+    assert len(quicktable.read_jsonl(path, BLUEPRINT)) == 0
+
+
+@pytest.mark.parametrize('threads', [0, 1, 3, 8])
+def test_read_jsonl_threads(tmp_path, threads):
+    n = 200000
+    types = ('fire', 'water', 'grass')
+    rows = (json.dumps({'Name': 'Pokemon, number {}'.format(i), 'Level': i, 'Power': i + 0.5, 'Wild': i % 2 == 0, 'Type': types[i % 3]}) + '\n' for i in range(n))
+    path = write(tmp_path, ''.join(rows))
+
+    table = quicktable.read_jsonl(path, BLUEPRINT, threads=threads)
+    assert len(table) == n
+    for i in (0, 1, 65535, 65536, 100001, n - 1):
+        assert table[i] == ['Pokemon, number {}'.format(i), i, i + 0.5, i % 2 == 0, types[i % 3]]
+
+
+def test_read_jsonl_with_allocator(tmp_path):
+    path = write(tmp_path, '{"Name": "Pikachu", "Level": 12, "Power": 1.5, "Wild": true, "Type": "electric"}\n' * 1000)
+    table = quicktable.read_jsonl(path, BLUEPRINT, threads=4, capacity=1000, allocator='arena')
+    assert len(table) == 1000
+    assert table[999] == ['Pikachu', 12, 1.5, True, 'electric']
+
+
+@pytest.mark.parametrize('line, error_class, message', [
+    ('{"Name": "Pikachu", "Level": "high"}', TypeError, "read_jsonl with string for non-str column (row 1, column 'Level')"),
+    ('{"Name": "Pikachu", "Level": 1.5}', ValueError, "non-int entry for int column (row 1, column 'Level')"),
+    ('{"Name": "Pikachu", "Level": 99999999999999999999}', OverflowError, "int out of range for int column (row 1, column 'Level')"),
+    ('{"Name": null}', TypeError, "read_jsonl with null for non-nullable column (row 1, column 'Name')"),
+    ('{"Name": ["Pikachu"]}', TypeError, "read_jsonl with nested value (row 1, column 'Name')"),
+    ('{"Name": "Pikachu", "Name": "Raichu"}', ValueError, "read_jsonl with duplicate key (row 1, column 'Name')"),
+    ('{"Level": 12}', ValueError, "read_jsonl with missing key (row 1, column 'Name')"),
+    ('["Pikachu", 12]', ValueError, 'read_jsonl with non-object line (row 1)'),
+    ('{"Name": "Pikachu" "Level": 12}', ValueError, 'read_jsonl with malformed line (row 1)'),
+    ('{"Name": "Pikachu"} trailing', ValueError, 'read_jsonl with malformed line (row 1)'),
+    ('{"Name": "Pika', ValueError, "read_jsonl with unterminated string (row 1, column 'Name')"),
+    ('{"Name": "Pika\\x"}', ValueError, "read_jsonl with invalid string escape (row 1, column 'Name')"),
+    ('{"Name": "\\ud83d"}', ValueError, "read_jsonl with invalid string escape (row 1, column 'Name')"),
+])
+def test_read_jsonl_invalid_line(tmp_path, line, error_class, message):
+    path = write(tmp_path, '{"Name": "Pikachu"}\n' + line + '\n')
+    with pytest.raises(error_class) as error:
+        quicktable.read_jsonl(path, [('Name', 'str'), ('Level', 'int?')])
+    assert str(error.value) == message
+
+
+
+@pytest.mark.parametrize('name, type_, column', [
+    (b'\xff\xfe', b'electric', 'Name'),
+    (b'Pikachu', b'electric\xc3', 'Type'),
+    (b'Pika\xed\xa0\x80chu', b'electric', 'Name'),
+    (b'Pika\xc0\xafchu', b'electric', 'Name'),
+])
+def test_read_jsonl_invalid_utf8(tmp_path, name, type_, column):
+    path = tmp_path / 'pokemon.jsonl'
+    path.write_bytes(
+        b'{"Name": "Pikachu", "Power": 1.5, "Wild": true, "Type": "electric"}\n'
+        b'{"Name": "' + name + b'", "Power": 1.5, "Wild": true, "Type": "' + type_ + b'"}\n'
+    )
+    with pytest.raises(ValueError) as error:
+        quicktable.read_jsonl(path, BLUEPRINT)
+    assert str(error.value) == "read_jsonl with invalid UTF-8 (row 1, column '%s')" % column
+
+def test_read_jsonl_missing_file(tmp_path):
+    with pytest.raises(FileNotFoundError):
+        quicktable.read_jsonl(tmp_path / 'missing.jsonl', BLUEPRINT)
+
+
+def test_read_jsonl_negative_threads(tmp_path):
+    path = write(tmp_path, '')
+    with pytest.raises(ValueError):
+        quicktable.read_jsonl(path, BLUEPRINT, threads=-1)
@@ -0,0 +1,129 @@
+import array
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str?'),
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+    ('Weight', 'float32'),
+    ('Rank', 'uint64'),
+    ('Stage', 'int8?'),
+]
+
+ROWS = [
+    ['Pikachu', 12, 0.1, True, 'electric', 6.0, 18446744073709551615, 1],
+    ['Mr. Mime, the mime of Kanto', None, -2.5e-300, False, 'psychic', 0.5, 0, None],
+    [None, -9223372036854775808, 3.0, True, 'electric', 1.5, 1, -128],
+    ['', 0, float('inf'), False, '', -0.25, 2, 127],
+]
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table(BLUEPRINT)
+    table.extend(ROWS)
+    return table
+
+
+@pytest.mark.parametrize('mmap', [True, False])
+def test_save_load_round_trip(tmp_path, table, mmap):
+    path = tmp_path / 'pokemon.qtb'
+    table.save(path)
+    loaded = quicktable.load(path, mmap=mmap)
+    assert loaded.blueprint == BLUEPRINT
+    assert len(loaded) == len(ROWS)
+    assert [loaded[i] for i in range(len(loaded))] == ROWS
+
+
+def test_load_then_append(tmp_path, table):
+    path = tmp_path / 'pokemon.qtb'
+    table.save(str(path))
+    loaded = quicktable.load(str(path))
+    loaded.append(['Raichu, the evolved form', 30, 2.0, False, 'electric', 30.0, 3, 2])
+    loaded.append(['Jigglypuff', 5, 1.0, True, 'fairy', 5.5, 4, None])
+    assert loaded[4] == ['Raichu, the evolved form', 30, 2.0, False, 'electric', 30.0, 3, 2]
+    assert loaded[5] == ['Jigglypuff', 5, 1.0, True, 'fairy', 5.5, 4, None]
+    assert loaded[0] == ROWS[0]
+    assert loaded.pop() == ['Jigglypuff', 5, 1.0, True, 'fairy', 5.5, 4, None]
+    assert len(loaded) == 5
+
+
+def test_load_leaves_file_untouched(tmp_path, table):
+    path = tmp_path / 'pokemon.qtb'
+    table.save(path)
+    saved = path.read_bytes()
+    loaded = quicktable.load(path)
+    loaded.pop()
+    loaded.append(['Eevee', 8, 0.5, True, 'normal', 6.5, 5, 0])
+    loaded.shrink_to_fit()
+    del loaded
+    assert path.read_bytes() == saved
+
+
+def test_save_load_across_chunks(tmp_path):
+    n = 2 * quicktable.CHUNK_SIZE + 5
+    table = quicktable.Table([('Level', 'int'), ('Wild', 'bool?'), ('Name', 'str'), ('Type', 'category')])
+    table.extend_columns([
+        array.array('q', range(n)),
+        [None if i % 3 == 0 else i % 2 == 0 for i in range(n)],
+        ['pokemon number %d' % i for i in range(n)],
+        ['type %d' % (i % 7) for i in range(n)],
+    ])
+    path = tmp_path / 'many.qtb'
+    table.save(path)
+    loaded = quicktable.load(path)
+    assert len(loaded) == n
+    for i in (0, 1, 65535, 65536, 65537, n - 1):
+        assert loaded[i] == table[i]
+    loaded.append([n, True, 'last', 'type 0'])
+    assert loaded[n] == [n, True, 'last', 'type 0']
+
+
+def test_save_load_empty_table(tmp_path):
+    table = quicktable.Table([('Name', 'str'), ('Type', 'category')])
+    path = tmp_path / 'empty.qtb'
+    table.save(path)
+    loaded = quicktable.load(path)
+    assert len(loaded) == 0
+    assert loaded.blueprint == [('Name', 'str'), ('Type', 'category')]
+    loaded.append(['Pikachu', 'electric'])
+    assert loaded[0] == ['Pikachu', 'electric']
+
+
+def test_loaded_column_buffer(tmp_path):
+    table = quicktable.Table([('Level', 'int')])
+    table.extend([[1], [2], [3]])
+    path = tmp_path / 'levels.qtb'
+    table.save(path)
+    loaded = quicktable.load(path)
+    assert list(memoryview(loaded.column_buffer('Level'))) == [1, 2, 3]
+
+
+def test_load_missing_file(tmp_path):
+    with pytest.raises(FileNotFoundError):
+        quicktable.load(tmp_path / 'missing.qtb')
+
+
+def test_load_not_a_table_file(tmp_path):
+    path = tmp_path / 'pokemon.csv'
+    path.write_bytes(b'Name,Level\nPikachu,12\n' * 4)
+    with pytest.raises(ValueError) as excinfo:
+        quicktable.load(path)
+    assert str(excinfo.value) == 'not a table file'
+
+
+def test_load_truncated_file(tmp_path, table):
+    path = tmp_path / 'pokemon.qtb'
+    table.save(path)
+    path.write_bytes(path.read_bytes()[:-64])
+    with pytest.raises(ValueError) as excinfo:
+        quicktable.load(path)
+    assert str(excinfo.value) == 'corrupt table file'
+
+
+def test_save_to_missing_directory(tmp_path, table):
+    with pytest.raises(FileNotFoundError):
+        table.save(tmp_path / 'missing' / 'pokemon.qtb')
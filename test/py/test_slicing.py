@@ -46,3 +46,122 @@ def test_slice_negative_two_rows(table):
 
 def test_slice_range(table):
     table[0:1]
+
+
+@pytest.fixture
+def filled():
+    table = quicktable.Table([('Name', 'str?'), ('Level', 'int?'), ('Wild', 'bool'), ('Type', 'category')])
+    for i in range(10):
+        table.append(['Pokemon number %d' % i if i != 3 else None, i if i != 4 else None, i % 2 == 0, 'type %d' % (i % 3)])
+    return table
+
+
+def rows(table):
+    return [table[i] for i in range(len(table))]
+
+
+@pytest.mark.parametrize('key', [
+    slice(None), slice(2, 7), slice(None, 3), slice(-3, None), slice(None, None, 2),
+    slice(8, 1, -3), slice(None, None, -1), slice(5, 5), slice(20, 30), slice(-100, 100),
+])
+def test_slice_view(filled, key):
+    view = filled[key]
+    assert type(view) is quicktable.Table
+    assert len(view) == len(range(10)[key])
+    assert rows(view) == [filled[i] for i in range(10)[key]]
+    assert view.blueprint == filled.blueprint
+
+
+def test_slice_of_view(filled):
+    view = filled[1:9][::-2][1:]
+    assert rows(view) == [filled[i] for i in range(1, 9)[::-2][1:]]
+    assert view[-1] == filled[2]
+
+
+def test_slice_view_index_out_of_range(filled):
+    view = filled[2:4]
+    with pytest.raises(IndexError):
+        view[2]
+    with pytest.raises(IndexError):
+        view[-3]
+
+
+def test_slice_view_shares_rows(filled):
+    view = filled[:3]
+    filled.append(['Mew', 151, True, 'type 0'])
+    assert len(view) == 3
+    assert view[0] == filled[0]
+
+
+def test_slice_view_is_read_only(filled):
+    view = filled[:3]
+    for method, args in [('append', (['Mew', 1, True, 'x'],)), ('extend', ([],)), ('pop', ()), ('reserve', (100,)), ('shrink_to_fit', ())]:
+        with pytest.raises(TypeError) as excinfo:
+            getattr(view, method)(*args)
+        assert str(excinfo.value) == 'table view is read-only'
+
+
+def test_slice_view_keeps_table_from_popping(filled):
+    view = filled[:3]
+    with pytest.raises(BufferError) as excinfo:
+        filled.pop()
+    assert str(excinfo.value) == 'table has views'
+    del view
+    assert filled.pop()[0] == 'Pokemon number 9'
+
+
+def test_slice_view_outlives_table(filled):
+    expected = filled[9]
+    view = filled[9:]
+    del filled
+    assert view[0] == expected
+
+
+def test_slice_view_copy(filled):
+    copy = filled[::3].copy()
+    assert rows(copy) == [filled[i] for i in range(0, 10, 3)]
+    copy.append(['Mew', 151, True, 'type 9'])
+    assert copy[4] == ['Mew', 151, True, 'type 9']
+    assert len(filled) == 10
+    assert copy.memory_usage()[0]['used'] > 0
+
+
+def test_slice_view_holds_no_memory(filled):
+    view = filled[:]
+    assert all(usage['reserved'] == 0 for usage in view.memory_usage())
+    assert view.capacity == len(view)
+
+
+def test_slice_view_repr(filled):
+    assert repr(filled[5:]) == repr(filled[5:].copy())
+    assert 'Pokemon number 9' in repr(filled[::-1]).splitlines()[1]
+
+
+def test_slice_view_to_csv_and_save(tmp_path, filled):
+    view = filled[7:1:-2]
+    view.to_csv(tmp_path / 'view.csv')
+    view.copy().to_csv(tmp_path / 'copy.csv')
+    assert (tmp_path / 'view.csv').read_text() == (tmp_path / 'copy.csv').read_text()
+
+    view.save(tmp_path / 'view.qtb')
+    assert rows(quicktable.load(tmp_path / 'view.qtb')) == rows(view)
+
+
+def test_slice_view_column_buffer():
+    table = quicktable.Table([('Level', 'int')])
+    table.extend_columns([list(range(100))])
+    assert list(memoryview(table[10:20:3].column_buffer('Level'))) == [10, 13, 16, 19]
+
+
+def test_slice_large_table_is_constant_time():
+    table = quicktable.Table([('Level', 'int')])
+    table.extend_columns([list(range(3 * quicktable.CHUNK_SIZE))])
+    view = table[quicktable.CHUNK_SIZE - 2:]
+    assert view.__sizeof__() < 1000
+    assert view[2] == [quicktable.CHUNK_SIZE]
+
+
+def test_subscript_with_invalid_key(filled):
+    with pytest.raises(TypeError) as excinfo:
+        filled[1.5]
+    assert str(excinfo.value) == 'table indices must be integers, slices or column names'
@@ -0,0 +1,162 @@
+import array
+import pytest
+import quicktable
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table([('Name', 'str'), ('Level', 'int?'), ('Wild', 'bool'), ('Power', 'float32'), ('Type', 'category')])
+    table.extend([
+        ['Pikachu', 12, True, 1.5, 'electric'],
+        ['Charmander the long', None, False, 2.25, 'fire'],
+        ['Squirtle', -30, True, -0.5, 'water'],
+        ['Bulbasaur', 5, False, 0.0, 'grass'],
+    ])
+    return table
+
+
+def rows(table):
+    return [table[i] for i in range(len(table))]
+
+
+def test_take(table):
+    expected = rows(table)
+    taken = table.take([3, 1, 1, -4])
+    assert isinstance(taken, quicktable.Table)
+    assert taken.blueprint == table.blueprint
+    assert rows(taken) == [expected[3], expected[1], expected[1], expected[0]]
+
+
+def test_take_from_buffers(table):
+    expected = rows(table)
+    for typecode in 'bBhHiIlLqQ':
+        assert rows(table.take(array.array(typecode, [2, 0]))) == [expected[2], expected[0]]
+    assert rows(table.take(array.array('q', [-1]))) == [expected[3]]
+
+
+def test_take_nothing(table):
+    assert len(table.take([])) == 0
+    assert len(table.take(array.array('q'))) == 0
+
+
+def test_take_out_of_range(table):
+    for indices in ([4], [-5], array.array('q', [4]), array.array('Q', [18446744073709551615])):
+        with pytest.raises(IndexError) as excinfo:
+            table.take(indices)
+        assert str(excinfo.value) == 'take index out of range'
+
+
+def test_take_invalid_indices(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.take([0, 1.0])
+    assert str(excinfo.value) == 'take with non-integer index'
+    with pytest.raises(TypeError) as excinfo:
+        table.take(array.array('d', [0.0]))
+    assert str(excinfo.value) == 'take with non-integer buffer'
+    with pytest.raises(TypeError):
+        table.take(3)
+
+
+def test_take_is_a_copy(table):
+    taken = table.take([0])
+    table.pop()
+    table.append(['Mew', 151, True, 1.0, 'psychic'])
+    taken.append(['Eevee', 1, True, 2.0, 'normal'])
+    assert rows(taken) == [['Pikachu', 12, True, 1.5, 'electric'], ['Eevee', 1, True, 2.0, 'normal']]
+    assert len(table) == 4
+
+
+def test_filter(table):
+    expected = rows(table)
+    assert rows(table.filter([True, False, True, False])) == [expected[0], expected[2]]
+    assert rows(table.filter(memoryview(bytes([0, 1, 0, 1])).cast('?'))) == [expected[1], expected[3]]
+
+
+def test_filter_with_column_view(table):
+    expected = rows(table)
+    assert rows(table.filter(table['Wild'])) == [expected[0], expected[2]]
+    assert rows(table[1:].filter(table[1:]['Wild'])) == [expected[2]]
+
+
+def test_filter_with_nullable_column_view():
+    table = quicktable.Table([('Caught', 'bool?')])
+    table.extend([[True], [None], [False], [True]])
+    assert rows(table.filter(table['Caught'])) == [[True], [True]]
+
+
+def test_filter_invalid_mask(table):
+    with pytest.raises(TypeError) as excinfo:
+        table.filter([True, False, 1, False])
+    assert str(excinfo.value) == 'filter with non-bool mask'
+    with pytest.raises(TypeError) as excinfo:
+        table.filter(table['Level'])
+    assert str(excinfo.value) == 'filter with non-bool mask'
+    with pytest.raises(TypeError) as excinfo:
+        table.filter(array.array('b', [1, 0, 1, 0]))
+    assert str(excinfo.value) == 'filter with non-bool mask'
+    for mask in ([True], table[1:]['Wild'], memoryview(bytes(3)).cast('?')):
+        with pytest.raises(TypeError) as excinfo:
+            table.filter(mask)
+        assert str(excinfo.value) == 'filter with mismatching mask length'
+
+
+def test_take_and_filter_on_views(table):
+    expected = rows(table)
+    view = table[::-1]
+    assert rows(view.take([0, 3])) == [expected[3], expected[0]]
+    assert rows(view.filter([True, False, False, True])) == [expected[3], expected[0]]
+
+
+def test_take_across_chunks():
+    n = quicktable.CHUNK_SIZE * 2 + 3
+    table = quicktable.Table([('Id', 'int'), ('Even', 'bool'), ('Mod', 'uint8')])
+    table.extend_columns([array.array('q', range(n)), [i % 2 == 0 for i in range(n)], array.array('B', [i % 251 for i in range(n)])])
+    table.compress()
+    indices = array.array('q', range(n - 1, -1, -3))
+    taken = table.take(indices)
+    assert [row[0] for row in taken] == list(indices)
+    assert [row[2] for row in taken] == [i % 251 for i in indices]
+    evens = table.filter(table['Even'])
+    assert len(evens) == (n + 1) // 2
+    assert evens['Id'].tolist() == list(range(0, n, 2))
+
+
+def test_filter_with_numpy_mask(table):
+    numpy = pytest.importorskip('numpy')
+    expected = rows(table)
+    assert rows(table.filter(numpy.array([False, True, True, False]))) == expected[1:3]
+    assert rows(table.take(numpy.array([3, 0]))) == [expected[3], expected[0]]
+
+
+
+def test_take_with_mutating_index():
+    table = quicktable.Table([('Name', 'str')])
+    table.extend_columns([['Pikachu the %d' % i for i in range(200000)]])
+
+    class Popping:
+        def __index__(self):
+            while len(table) > 1:
+                table.pop()
+            table.shrink_to_fit()
+            return 0
+
+    with pytest.raises(IndexError) as excinfo:
+        table.take([150000, 199999, Popping()])
+    assert str(excinfo.value) == 'take index out of range'
+    assert rows(table.take([Popping(), 0])) == [['Pikachu the 0'], ['Pikachu the 0']]
+
+
+def test_take_with_index_changing_indices():
+    table = quicktable.Table([('Level', 'int')])
+    table.extend_columns([array.array('q', range(10))])
+    indices = []
+
+    class Clearing:
+        def __index__(self):
+            indices.clear()
+            return 0
+
+    indices.extend([Clearing(), 1, 2])
+    with pytest.raises(RuntimeError) as excinfo:
+        table.take(indices)
+    assert str(excinfo.value) == 'take indices changed size'
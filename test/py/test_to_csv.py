@@ -0,0 +1,162 @@
+import io
+import pytest
+import quicktable
+
+BLUEPRINT = [
+    ('Name', 'str?'),
+    ('Level', 'int?'),
+    ('Power', 'float'),
+    ('Wild', 'bool'),
+    ('Type', 'category'),
+    ('Weight', 'float32'),
+    ('Rank', 'uint64'),
+]
+
+
+@pytest.fixture
+def table():
+    table = quicktable.Table(BLUEPRINT)
+    table.append(['Pikachu', 12, 0.1, True, 'electric', 6.0, 18446744073709551615])
+    table.append(['Mr. "Mime", the mime', None, -2.5e-300, False, 'psychic', 0.1, 0])
+    table.append([None, -9223372036854775808, 3.0, True, 'electric', 1.5, 1])
+    table.append(['', 0, float('inf'), False, 'line\nbreak', -0.25, 2])
+    return table
+
+
+EXPECTED = (
+    'Name,Level,Power,Wild,Type,Weight,Rank\n'
+    'Pikachu,12,0.1,True,electric,6,18446744073709551615\n'
+    '"Mr. ""Mime"", the mime",,-2.5e-300,False,psychic,0.1,0\n'
+    ',-9223372036854775808,3,True,electric,1.5,1\n'
+    '"",0,inf,False,"line\nbreak",-0.25,2\n'
+)
+
+
+def test_to_csv_path(tmp_path, table):
+    path = tmp_path / 'pokemon.csv'
+    table.to_csv(path)
+    assert path.read_text() == EXPECTED
+
+
+def test_to_csv_str_path(tmp_path, table):
+    path = tmp_path / 'pokemon.csv'
+    table.to_csv(str(path))
+    assert path.read_text() == EXPECTED
+
+
+def test_to_csv_text_file(table):
+    file = io.StringIO()
+    table.to_csv(file)
+    assert file.getvalue() == EXPECTED
+
+
+def test_to_csv_binary_file(table):
+    file = io.BytesIO()
+    table.to_csv(file)
+    assert file.getvalue() == EXPECTED.encode()
+
+
+def test_to_csv_tsv_without_header(table):
+    file = io.StringIO()
+    table.to_csv(file, '\t', header=False)
+    assert file.getvalue().splitlines()[0] == 'Pikachu\t12\t0.1\tTrue\telectric\t6\t18446744073709551615'
+
+
+def test_to_csv_round_trips_through_read_csv(tmp_path, table):
+    path = tmp_path / 'pokemon.csv'
+    table.to_csv(path)
+    read = quicktable.read_csv(path, BLUEPRINT)
+    assert [read[i] for i in range(len(read))] == [table[i] for i in range(len(table))]
+
+
+def test_to_csv_single_nullable_column_round_trips(tmp_path):
+    table = quicktable.Table([('Level', 'int?')])
+    table.extend([[1], [None], [3]])
+
+    path = tmp_path / 'levels.csv'
+    table.to_csv(path)
+    read = quicktable.read_csv(path, [('Level', 'int?')])
+    assert [read[i] for i in range(len(read))] == [[1], [None], [3]]
+
+
+@pytest.mark.parametrize('type', ['str', 'category'])
+def test_to_csv_single_column_quotes_empty_string(tmp_path, type):
+    table = quicktable.Table([('Name', type)])
+    table.extend([['x'], [''], ['y']])
+
+    path = tmp_path / 'names.csv'
+    table.to_csv(path)
+    assert path.read_text() == 'Name\nx\n""\ny\n'
+    read = quicktable.read_csv(path, [('Name', type)])
+    assert [read[i] for i in range(len(read))] == [['x'], [''], ['y']]
+
+
+def test_to_csv_flushes_large_tables(tmp_path):
+    table = quicktable.Table([('Name', 'str'), ('Level', 'int')])
+    table.extend(['Pokemon number {}'.format(i), i] for i in range(100000))
+
+    path = tmp_path / 'pokemon.csv'
+    table.to_csv(path)
+    lines = path.read_text().splitlines()
+    assert len(lines) == 100001
+    assert lines[-1] == 'Pokemon number 99999,99999'
+
+
+def test_to_csv_cell_larger_than_buffer():
+    table = quicktable.Table([('Name', 'str')])
+    table.append(['a' * (3 * 1024 * 1024)])
+
+    file = io.StringIO()
+    table.to_csv(file, header=False)
+    assert file.getvalue() == 'a' * (3 * 1024 * 1024) + '\n'
+
+
+def test_to_csv_invalid_destination(table):
+    with pytest.raises(TypeError) as error:
+        table.to_csv(12)
+    assert str(error.value) == 'to_csv destination must be a path or a file object'
+
+
+def test_to_csv_invalid_delimiter(table):
+    with pytest.raises(ValueError) as error:
+        table.to_csv(io.StringIO(), '"')
+    assert str(error.value) == 'invalid delimiter'
+
+
+def test_to_csv_missing_directory(tmp_path, table):
+    with pytest.raises(FileNotFoundError):
+        table.to_csv(tmp_path / 'missing' / 'pokemon.csv')
+
+
+def test_to_csv_pins_table_while_writing():
+    table = quicktable.Table([('Name', 'str')])
+    table.extend_columns([['Pikachu the %d' % i for i in range(200000)]])
+
+    class Popping(io.StringIO):
+        def write(self, s):
+            while len(table):
+                table.pop()
+            table.shrink_to_fit()
+            return super().write(s)
+
+    with pytest.raises(BufferError) as excinfo:
+        table.to_csv(Popping())
+    assert str(excinfo.value) == 'table has exported buffers'
+    assert len(table) == 200000
+    table.pop()
+    assert len(table) == 199999
+
+
+def test_to_csv_of_view_pins_base():
+    table = quicktable.Table([('Name', 'str')])
+    table.extend_columns([['Pikachu the %d' % i for i in range(200000)]])
+    view = table[::2]
+
+    class Appending(io.StringIO):
+        def write(self, s):
+            table.append(['Mew'])
+            return super().write(s)
+
+    with pytest.raises(BufferError):
+        view.to_csv(Appending())
+    assert len(table) == 200000